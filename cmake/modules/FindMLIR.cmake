@@ -2,6 +2,11 @@
 find_package(MLIR REQUIRED CONFIG)
 message(STATUS "Using MLIRConfig.cmake in: ${MLIR_DIR}")
 message(STATUS "Using LLVMConfig.cmake in: ${LLVM_DIR}")
+# lld is optional, without it dylibs are linked by an external ld.lld.
+find_package(LLD CONFIG QUIET HINTS "${LLVM_DIR}/../lld")
+if(LLD_FOUND)
+  message(STATUS "Using LLDConfig.cmake in: ${LLD_DIR}")
+endif()
 set(LLVM_RUNTIME_OUTPUT_INTDIR ${CMAKE_BINARY_DIR}/bin)
 set(LLVM_LIBRARY_OUTPUT_INTDIR ${CMAKE_BINARY_DIR}/lib)
 set(MLIR_BINARY_DIR ${CMAKE_BINARY_DIR})
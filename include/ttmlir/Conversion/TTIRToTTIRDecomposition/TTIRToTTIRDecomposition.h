@@ -5,6 +5,7 @@
 #ifndef TTMLIR_CONVERSION_TTIRTOTTIRDECOMPOSITION_TTIRTOTTIRDECOMPOSITION_H
 #define TTMLIR_CONVERSION_TTIRTOTTIRDECOMPOSITION_TTIRTOTTIRDECOMPOSITION_H
 
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
 
@@ -14,7 +15,8 @@ void populateTTIRToTTIRDecompositionPatterns(MLIRContext *ctx,
                                              RewritePatternSet &patterns,
                                              TypeConverter &typeConverter);
 
-std::unique_ptr<OperationPass<ModuleOp>> createTTIRToTTIRDecompositionPass();
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTTIRToTTIRDecompositionPass();
 
 } // namespace mlir::tt
 
@@ -39,6 +39,14 @@ struct LinalgToLLVMPipelineOptions
       llvm::cl::desc("Enable cleanup passes (canonicalize, SCC, CSE, "
                      "SymbolDCE) after basic lowering is finished."),
       llvm::cl::init(true)};
+
+  // Lower linalg through affine loops and vectorize the innermost loops.
+  // When disabled, the scalar loops are left for LLVM to vectorize.
+  Option<int64_t> vectorWidth{
+      *this, "vector-width",
+      llvm::cl::desc("Number of elements per vector when vectorizing linalg "
+                     "loops (0 disables vectorization)."),
+      llvm::cl::init(0)};
 };
 
 #ifdef TTMLIR_ENABLE_STABLEHLO
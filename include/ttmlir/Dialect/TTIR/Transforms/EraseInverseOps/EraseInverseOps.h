@@ -8,9 +8,20 @@
 #include "ttmlir/Dialect/TTIR/IR/TTIROps.h"
 #include "ttmlir/Dialect/TTIR/IR/TTIROpsInterfaces.h"
 
+#include "llvm/ADT/Sequence.h"
+
+#include <optional>
+
 namespace mlir::tt::ttir {
 
-template <typename TMOpType, typename CommutableOpOrInterface>
+// Direction in which a pattern moves a TM across the op it commutes through.
+// UPWARDS patterns look for a TM user of the op and move it above the op, onto
+// its operands. DOWNWARDS patterns look for TM operands of the op and move them
+// below the op, onto its result.
+enum class CommuteDirection { UPWARDS, DOWNWARDS };
+
+template <typename TMOpType, typename CommutableOpOrInterface,
+          CommuteDirection commuteDirection = CommuteDirection::UPWARDS>
 class TTIRCommuteRewritePatternBase {
 public:
   virtual ~TTIRCommuteRewritePatternBase() noexcept = default;
@@ -18,6 +29,16 @@ public:
 protected:
   LogicalResult matchAndRewriteImpl(CommutableOpOrInterface op,
                                     PatternRewriter &rewriter) const {
+    if constexpr (commuteDirection == CommuteDirection::UPWARDS) {
+      return matchAndRewriteUpwards(op, rewriter);
+    } else {
+      return matchAndRewriteDownwards(op, rewriter);
+    }
+  }
+
+private:
+  LogicalResult matchAndRewriteUpwards(CommutableOpOrInterface op,
+                                       PatternRewriter &rewriter) const {
     // This operation cannot have a TM below it if it has no users.
     if (op->getUsers().empty()) {
       return failure();
@@ -54,8 +75,44 @@ protected:
     return success();
   }
 
-private:
+  LogicalResult matchAndRewriteDownwards(CommutableOpOrInterface op,
+                                         PatternRewriter &rewriter) const {
+    // Try to find an input operand which is produced by a `TMOpType` that can
+    // and should be commuted below `op`. DPS inits are not inputs.
+    auto dpsOp = dyn_cast<DestinationStyleOpInterface>(op.getOperation());
+    TMOpType operandToCommute = nullptr;
+    for (OpOperand &operand : op->getOpOperands()) {
+      if (dpsOp && dpsOp.isDpsInit(&operand)) {
+        continue;
+      }
+
+      auto tmOperand = operand.get().getDefiningOp<TMOpType>();
+      if (!tmOperand) {
+        continue;
+      }
+
+      if (!isCommuteViable(op, tmOperand)) {
+        continue;
+      }
+
+      if (!isCommuteFavorable(op, tmOperand)) {
+        continue;
+      }
+      operandToCommute = tmOperand;
+      break;
+    }
+
+    if (!operandToCommute) {
+      return failure();
+    }
+
+    performCommuteRewrite(op, operandToCommute, rewriter);
+    return success();
+  }
+
   // This should return `success()` if `tmUser` can be commuted above `op`.
+  // For DOWNWARDS patterns `tmUser` is instead a TM operand of `op` and the
+  // question is whether it can be commuted below `op`.
   virtual bool isCommuteViable(CommutableOpOrInterface op,
                                TMOpType tmUser) const = 0;
 
@@ -98,10 +155,12 @@ private:
 // implements a given interface. This is useful for implementing the elementwise
 // patterns. This way we do not have to create a separate pattern for each
 // elementwise operation.
-template <typename TMOpType, typename CommutableOpInterface>
+template <typename TMOpType, typename CommutableOpInterface,
+          CommuteDirection commuteDirection = CommuteDirection::UPWARDS>
 class TTIRCommuteOpInterfaceRewritePattern
     : public OpInterfaceRewritePattern<CommutableOpInterface>,
-      public TTIRCommuteRewritePatternBase<TMOpType, CommutableOpInterface> {
+      public TTIRCommuteRewritePatternBase<TMOpType, CommutableOpInterface,
+                                           commuteDirection> {
 public:
   using OpInterfaceRewritePattern<
       CommutableOpInterface>::OpInterfaceRewritePattern;
@@ -114,10 +173,12 @@ public:
 
 // Using this class will allow you to match against a specific operation type:
 // `CommutableOp`.
-template <typename TMOpType, typename CommutableOp>
+template <typename TMOpType, typename CommutableOp,
+          CommuteDirection commuteDirection = CommuteDirection::UPWARDS>
 class TTIRCommuteOpRewritePattern
     : public OpRewritePattern<CommutableOp>,
-      public TTIRCommuteRewritePatternBase<TMOpType, CommutableOp> {
+      public TTIRCommuteRewritePatternBase<TMOpType, CommutableOp,
+                                           commuteDirection> {
 public:
   using OpRewritePattern<CommutableOp>::OpRewritePattern;
 
@@ -169,10 +230,39 @@ inline bool checkAllUsersAreIdenticalTms(ArrayRef<Operation *> users) {
   });
 }
 
+// Returns the dimension permutation applied by a transpose or permute, in the
+// convention of `ttmlir::utils::applyPermutation`, i.e. result dimension `i` is
+// input dimension `permutation[i]`. Returns std::nullopt for any other op.
+inline std::optional<SmallVector<int64_t>> getTMPermutation(Operation *op) {
+  if (auto permuteOp = dyn_cast<ttir::PermuteOp>(op)) {
+    return SmallVector<int64_t>(permuteOp.getPermutation());
+  }
+
+  if (auto transposeOp = dyn_cast<ttir::TransposeOp>(op)) {
+    int64_t rank = transposeOp.getInput().getType().getRank();
+    int64_t dim0 = transposeOp.getDim0() < 0 ? transposeOp.getDim0() + rank
+                                             : transposeOp.getDim0();
+    int64_t dim1 = transposeOp.getDim1() < 0 ? transposeOp.getDim1() + rank
+                                             : transposeOp.getDim1();
+    SmallVector<int64_t> permutation(llvm::seq<int64_t>(0, rank));
+    std::swap(permutation[dim0], permutation[dim1]);
+    return permutation;
+  }
+
+  return std::nullopt;
+}
+
+template <CommuteDirection commuteDirection>
 void populateElementwiseCommutePatterns(MLIRContext *ctx,
                                         RewritePatternSet &patterns);
 void populateBroadcastCommutePatterns(MLIRContext *ctx,
                                       RewritePatternSet &patterns);
+template <CommuteDirection commuteDirection>
+void populateConcatCommutePatterns(MLIRContext *ctx,
+                                   RewritePatternSet &patterns);
+template <CommuteDirection commuteDirection>
+void populateReductionCommutePatterns(MLIRContext *ctx,
+                                      RewritePatternSet &patterns);
 
 } // namespace mlir::tt::ttir
 
@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTMLIR_DIALECT_TTIR_UTILS_COSTMODEL_H
+#define TTMLIR_DIALECT_TTIR_UTILS_COSTMODEL_H
+
+#include <cstdint>
+
+namespace mlir::tt::ttir::cost {
+// Rough per core costs shared by the passes that choose blockings and
+// estimate how much data movement overlaps compute. They are not measured
+// and only meant to compare candidates with each other.
+constexpr int64_t kDMASetupCycles = 256;
+constexpr int64_t kNocBytesPerCycle = 32;
+constexpr int64_t kComputeCyclesPerTile = 64;
+} // namespace mlir::tt::ttir::cost
+
+#endif // TTMLIR_DIALECT_TTIR_UTILS_COSTMODEL_H
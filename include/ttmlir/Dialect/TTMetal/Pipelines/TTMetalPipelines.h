@@ -19,6 +19,14 @@ struct TTIRToTTMetalBackendPipelineOptions
       *this, "override-device-shape",
       llvm::cl::desc("Set the device worker grid shape.")};
 
+  // Number of buffers backing each generic op operand stream, so that data
+  // movement overlaps compute.
+  //
+  Option<unsigned> numStreamBuffers{
+      *this, "num-stream-buffers",
+      llvm::cl::desc("Number of buffers backing each operand stream."),
+      llvm::cl::init(2)};
+
   // Option to provide a system descriptor flatbuffer file to compile
   // against.
   //
@@ -8,12 +8,15 @@
 #include "ttmlir/Dialect/TTNN/Analysis/L1ChainConfig.h"
 #include "ttmlir/Dialect/TTNN/Analysis/MemoryLayoutAnalysisPolicy.h"
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
 #include "ttmlir/Dialect/TTNN/Analysis/TensorLayouts.h"
 #include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
 
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "llvm/ADT/DenseSet.h"
 
+#include <memory>
+
 namespace mlir::tt::ttnn {
 
 // Process ops in DFS schedulable order and build shard chain configs.
@@ -23,10 +26,16 @@ class DFShardingPolicy : public MemoryLayoutAnalysisPolicy {
 private:
   const TensorTypeLayoutsMap *tensorTypePossibleLayouts;
   llvm::DenseSet<Edge> overrideReshardEdges;
+  std::shared_ptr<OpModelBackend> opModelBackend;
 
   void pickOpShardConfigs(ShardSolver &shardSolver,
                           const L1ChainConfig &l1ChainConfig);
 
+  // L1 usage of the outputs of chain ops that are still needed by ops
+  // executed after currentOp.
+  uint64_t getLiveL1Usage(const L1ChainConfig &l1ChainConfig,
+                          Operation *currentOp) const;
+
 public:
   DFShardingPolicy(
       Operation *rootOp, std::vector<L1ChainConfig> &l1ChainConfigs,
@@ -44,6 +53,10 @@ public:
   void setOverrideReshardEdges(const llvm::DenseSet<Edge> &reshardEdges) {
     overrideReshardEdges = reshardEdges;
   }
+
+  void setOpModelBackend(std::shared_ptr<OpModelBackend> backend) {
+    opModelBackend = std::move(backend);
+  }
 };
 
 } // namespace mlir::tt::ttnn
@@ -46,6 +46,11 @@ public:
     size_t requiredL1Usage;
   };
 
+  // Up to this many ops every subset of L1 interleaved ops is tried, above it
+  // the ops are picked greedily.
+  //
+  static constexpr size_t maxNumOfExhaustiveOps = 16;
+
 public:
   GreedyL1InterleavedPolicy(
       Operation *rootOp, std::vector<L1ChainConfig> &l1ChainConfigs,
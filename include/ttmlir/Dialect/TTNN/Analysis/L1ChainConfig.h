@@ -10,6 +10,7 @@
 #include "ttmlir/Dialect/TTNN/Utils/Utils.h"
 
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <string>
@@ -55,7 +56,8 @@ public:
       const TensorTypeLayoutsMap *tensorTypePossibleLayouts,
       const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs,
       unsigned usableL1CacheSize,
-      const llvm::DenseSet<Edge> &overrideReshardEdges);
+      const llvm::DenseSet<Edge> &overrideReshardEdges,
+      std::shared_ptr<OpModelBackend> opModelBackend = nullptr);
   void resolve();
   void build();
   void complete(const llvm::DenseMap<Operation *, OpConfig> &selectedOpConfig,
@@ -71,6 +73,9 @@ public:
   const std::vector<OpL1MemSpec> &getOpL1MemSpecs() const {
     return opL1MemSpecs;
   }
+  const llvm::DenseSet<Operation *> &getL1ChainedOps() const {
+    return l1ChainedOps;
+  }
   L1ChainState getState() const { return state; }
   std::string getStateString() const {
     switch (state) {
@@ -99,6 +104,10 @@ public:
   }
 
   bool spillEndToDRAM = false;
+
+  // Ops other than the last one whose output is also used outside of the
+  // chain. Only the uses outside of the chain read the spilled output.
+  llvm::SmallVector<Operation *> spillForksToDRAM;
 };
 
 inline llvm::raw_ostream &operator<<(llvm::raw_ostream &os,
@@ -8,6 +8,7 @@
 #include "ttmlir/Dialect/TTNN/Analysis/Edge.h"
 #include "ttmlir/Dialect/TTNN/Analysis/L1ChainConfig.h"
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
 #include "ttmlir/Dialect/TTNN/Analysis/ShardSolver.h"
 #include "ttmlir/Dialect/TTNN/Analysis/TTNNAnalysis.h"
 #include "ttmlir/Dialect/TTNN/Analysis/TensorLayouts.h"
@@ -16,6 +17,7 @@
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "llvm/ADT/DenseSet.h"
 
+#include <memory>
 #include <vector>
 
 namespace mlir::tt::ttnn {
@@ -28,6 +30,9 @@ struct MemoryLayoutAnalysisInput {
 
   MemoryLayoutAnalysisPolicyType policy;
 
+  // Source of op constraints, the device op model if not set.
+  std::shared_ptr<OpModelBackend> opModelBackend;
+
   MemoryLayoutAnalysisInput() : legalConfigs() {}
 
   MemoryLayoutAnalysisInput(
@@ -35,10 +40,12 @@ struct MemoryLayoutAnalysisInput {
       const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs,
       unsigned usableL1CacheSize,
       const llvm::DenseSet<Edge> &overrideReshardEdges,
-      MemoryLayoutAnalysisPolicyType policy)
+      MemoryLayoutAnalysisPolicyType policy,
+      std::shared_ptr<OpModelBackend> opModelBackend = nullptr)
       : tensorTypePossibleLayouts(tensorTypePossibleLayouts),
         legalConfigs(legalConfigs), usableL1CacheSize(usableL1CacheSize),
-        overrideReshardEdges(overrideReshardEdges), policy(policy) {}
+        overrideReshardEdges(overrideReshardEdges), policy(policy),
+        opModelBackend(std::move(opModelBackend)) {}
 
   bool operator==(const MemoryLayoutAnalysisInput &rhs) const {
     return legalConfigs == rhs.legalConfigs;
@@ -53,10 +60,14 @@ struct MemoryLayoutAnalysisResult {
   llvm::DenseMap<Operation *, std::vector<OpConfig>> legalConfigs;
   llvm::DenseMap<Edge, MemReconfigEntry> memReconfigEntryMap;
   std::vector<Operation *> spillToDramOps;
+  // Edges between ops of the same L1 chain. Consumers on these edges keep
+  // reading the L1 output of a spilled producer.
+  llvm::DenseSet<Edge> l1ChainEdges;
   llvm::DenseMap<func::FuncOp, llvm::SmallVector<Operation *>> schedule;
 
   MemoryLayoutAnalysisResult()
-      : legalConfigs(), memReconfigEntryMap(), spillToDramOps(), schedule() {}
+      : legalConfigs(), memReconfigEntryMap(), spillToDramOps(),
+        l1ChainEdges(), schedule() {}
 
   MemoryLayoutAnalysisResult(
       const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs,
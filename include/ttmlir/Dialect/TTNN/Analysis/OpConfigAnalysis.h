@@ -6,14 +6,22 @@
 #define TTMLIR_DIALECT_TTNN_ANALYSIS_OPCONFIGANALYSIS_H
 
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpCostModel.h"
 #include "ttmlir/Dialect/TTNN/Analysis/TTNNAnalysis.h"
 #include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
 
+#include <memory>
+
 namespace mlir::tt::ttnn {
 
 struct OpConfigAnalysisInput {
   llvm::DenseMap<Operation *, std::vector<OpConfig>> legalConfigs;
 
+  // Cost model used to rank legal configs. If not set, device measured
+  // runtimes are used where available, with an analytical fallback.
+  //
+  std::shared_ptr<OpCostModel> costModel;
+
   OpConfigAnalysisInput() : legalConfigs() {}
 
   OpConfigAnalysisInput(
@@ -24,8 +32,13 @@ struct OpConfigAnalysisInput {
       const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs)
       : legalConfigs(legalConfigs) {}
 
+  OpConfigAnalysisInput(
+      const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs,
+      std::shared_ptr<OpCostModel> costModel)
+      : legalConfigs(legalConfigs), costModel(std::move(costModel)) {}
+
   bool operator==(const OpConfigAnalysisInput &rhs) const {
-    return legalConfigs == rhs.legalConfigs;
+    return legalConfigs == rhs.legalConfigs && costModel == rhs.costModel;
   }
 
   bool operator!=(const OpConfigAnalysisInput &rhs) const {
@@ -35,6 +48,11 @@ struct OpConfigAnalysisInput {
 
 // Determine optimal configuration for each op.
 //
+// Ops are visited in program order and each legal config is scored as the
+// estimated op runtime, given the layouts already picked for its producers,
+// plus the cost of converting its output for consumers that are not part of
+// the analysis. The config with the lowest score is picked.
+//
 class OpConfigAnalysis
     : public TTNNAnalysis<OpConfigAnalysisInput,
                           llvm::DenseMap<Operation *, OpConfig>> {
@@ -43,6 +61,9 @@ private:
   void analysisImplementation() override;
   bool applyOverrides() override;
 
+  OpConfig pickConfig(Operation *op, const std::vector<OpConfig> &configs,
+                      const OpCostModel &costModel) const;
+
 public:
   OpConfigAnalysis(Operation *op) : TTNNAnalysis(op) {}
 };
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTMLIR_DIALECT_TTNN_ANALYSIS_OPCOSTMODEL_H
+#define TTMLIR_DIALECT_TTNN_ANALYSIS_OPCOSTMODEL_H
+
+#include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Operation.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <memory>
+#include <vector>
+
+namespace mlir::tt::ttnn {
+
+// Operands of the op that are passed as inputs to the OpModel interface, i.e.
+// all operands except the DPS init and the device.
+//
+llvm::SmallVector<Value> getOpModelInputOperands(Operation *op);
+
+// Cost estimate of a single op or layout conversion, in nanoseconds.
+//
+struct OpCost {
+  double runtime = 0.0;
+
+  // True if the estimate comes from the device op model, false if it was
+  // derived analytically.
+  //
+  bool measured = false;
+};
+
+// Interface used by OpConfigAnalysis to rank legal op configs.
+//
+class OpCostModel {
+public:
+  virtual ~OpCostModel() = default;
+
+  // Estimated runtime of the op when producing the given config from inputs
+  // laid out as inputLayouts. Input layouts follow the OpModel interface
+  // convention, i.e. DPS init and device operands are skipped.
+  //
+  virtual OpCost getOpCost(Operation *op,
+                           const std::vector<TTNNLayoutAttr> &inputLayouts,
+                           const OpConfig &config) const = 0;
+
+  // Estimated cost of converting a tensor of the given type from one layout
+  // to another. Zero if the layouts match.
+  //
+  virtual double getLayoutConversionCost(RankedTensorType tensorType,
+                                         TTNNLayoutAttr from,
+                                         TTNNLayoutAttr to) const = 0;
+};
+
+// Bandwidth based estimate that does not require a device. Ops are modeled
+// as streaming their inputs and output through the memory they live in, plus
+// a per tile compute term spread over the output grid.
+//
+class AnalyticalOpCostModel : public OpCostModel {
+public:
+  OpCost getOpCost(Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const override;
+
+  double getLayoutConversionCost(RankedTensorType tensorType,
+                                 TTNNLayoutAttr from,
+                                 TTNNLayoutAttr to) const override;
+
+  // Size of the tensor in the given layout, including tile padding.
+  //
+  static uint64_t getTensorSizeInBytes(RankedTensorType tensorType,
+                                       TTNNLayoutAttr layout);
+
+private:
+  // Effective bandwidth (bytes/ns) of accessing a tensor in the given layout.
+  //
+  static double getBandwidth(TTNNLayoutAttr layout);
+
+  // Number of cores a tensor in the given layout is spread over.
+  //
+  static int64_t getNumCores(TTNNLayoutAttr layout);
+};
+
+// Queries the op model backend for a measured runtime and falls back to the
+// given cost model for ops without a runtime model or when the query fails.
+//
+class OpModelRuntimeCostModel : public OpCostModel {
+public:
+  OpModelRuntimeCostModel(std::shared_ptr<OpModelBackend> backend =
+                              std::make_shared<DeviceOpModelBackend>(),
+                          std::unique_ptr<OpCostModel> fallback =
+                              std::make_unique<AnalyticalOpCostModel>())
+      : backend(std::move(backend)), fallback(std::move(fallback)) {}
+
+  OpCost getOpCost(Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const override;
+
+  double getLayoutConversionCost(RankedTensorType tensorType,
+                                 TTNNLayoutAttr from,
+                                 TTNNLayoutAttr to) const override {
+    return fallback->getLayoutConversionCost(tensorType, from, to);
+  }
+
+private:
+  std::shared_ptr<OpModelBackend> backend;
+  std::unique_ptr<OpCostModel> fallback;
+};
+
+} // namespace mlir::tt::ttnn
+
+#endif // TTMLIR_DIALECT_TTNN_ANALYSIS_OPCOSTMODEL_H
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTMLIR_DIALECT_TTNN_ANALYSIS_OPMODELBACKEND_H
+#define TTMLIR_DIALECT_TTNN_ANALYSIS_OPMODELBACKEND_H
+
+#include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+#include "ttmlir/Dialect/TTNN/Utils/OpModelBackendParams.h"
+
+#include "mlir/IR/Operation.h"
+#include "llvm/Support/Error.h"
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace mlir::tt::ttnn {
+
+// L1 usage of an op in a given config, as returned by the OpModel interface:
+// peak circular buffer usage, peak L1 tensor usage and L1 output tensor usage
+// (all per core, in bytes), and the output layout.
+//
+using OpConstraints = std::tuple<size_t, size_t, size_t, TTNNLayoutAttr>;
+
+// Source of op constraints and runtimes used by the optimizer analyses.
+//
+class OpModelBackend {
+public:
+  virtual ~OpModelBackend() = default;
+
+  // Type of the backend, which may differ from the requested one when the
+  // factory falls back to another backend.
+  //
+  virtual OpModelBackendType getKind() const = 0;
+
+  // Input layouts follow the OpModel interface convention, i.e. DPS init and
+  // device operands are skipped.
+  //
+  virtual llvm::Expected<OpConstraints>
+  getOpConstraints(Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const = 0;
+
+  virtual llvm::Expected<size_t>
+  getOpRuntime(Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+               const OpConfig &config) const = 0;
+};
+
+// Queries the OpModel interface of the op, which is backed by the op model
+// library and requires a device.
+//
+class DeviceOpModelBackend : public OpModelBackend {
+public:
+  // False if the compiler was built without the op model library.
+  //
+  static bool isAvailable();
+
+  OpModelBackendType getKind() const override {
+    return OpModelBackendType::Device;
+  }
+
+  static bool classof(const OpModelBackend *backend) {
+    return backend->getKind() == OpModelBackendType::Device;
+  }
+
+  llvm::Expected<OpConstraints>
+  getOpConstraints(Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const override;
+
+  llvm::Expected<size_t>
+  getOpRuntime(Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+               const OpConfig &config) const override;
+};
+
+// Estimates L1 usage from the layouts alone, so it works on any op and does
+// not need a device. Output and L1 tensor usage are shard sizes of the L1
+// layouts involved. Circular buffers are double buffered tiles for operands
+// that are not sharded in L1, with per op rules for ops that stage more than
+// a tile at a time. No runtime estimate is provided.
+//
+class AnalyticalOpModelBackend : public OpModelBackend {
+public:
+  OpModelBackendType getKind() const override {
+    return OpModelBackendType::Analytical;
+  }
+
+  static bool classof(const OpModelBackend *backend) {
+    return backend->getKind() == OpModelBackendType::Analytical;
+  }
+
+  llvm::Expected<OpConstraints>
+  getOpConstraints(Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const override;
+
+  llvm::Expected<size_t>
+  getOpRuntime(Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+               const OpConfig &config) const override;
+
+  // Circular buffer bytes per core needed by the op.
+  //
+  static size_t getCBUsage(Operation *op,
+                           const std::vector<TTNNLayoutAttr> &inputLayouts,
+                           TTNNLayoutAttr outputLayout);
+};
+
+// Answers with the device backend and checks the analytical backend against
+// it. The backends disagree when only one of them accepts the config, or when
+// their L1 usage estimates differ by more than the given relative tolerance.
+//
+class ComparingOpModelBackend : public OpModelBackend {
+public:
+  struct Stats {
+    size_t numCompared = 0;
+    // Configs accepted by only one of the backends.
+    size_t numValidityMismatches = 0;
+    // Configs accepted by both with L1 usage estimates too far apart.
+    size_t numUsageMismatches = 0;
+
+    size_t numMismatches() const {
+      return numValidityMismatches + numUsageMismatches;
+    }
+  };
+
+  ComparingOpModelBackend(double tolerance = 0.25) : tolerance(tolerance) {}
+
+  OpModelBackendType getKind() const override {
+    return OpModelBackendType::Compare;
+  }
+
+  static bool classof(const OpModelBackend *backend) {
+    return backend->getKind() == OpModelBackendType::Compare;
+  }
+
+  llvm::Expected<OpConstraints>
+  getOpConstraints(Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const override;
+
+  llvm::Expected<size_t>
+  getOpRuntime(Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+               const OpConfig &config) const override {
+    return device.getOpRuntime(op, inputLayouts, config);
+  }
+
+  const Stats &getStats() const { return stats; }
+
+private:
+  DeviceOpModelBackend device;
+  AnalyticalOpModelBackend analytical;
+  double tolerance;
+  mutable Stats stats;
+};
+
+// Creates the backend of the given type. Comparing falls back to the
+// analytical backend when the device one is not available; check the kind of
+// the returned backend to tell.
+//
+std::shared_ptr<OpModelBackend> createOpModelBackend(OpModelBackendType type);
+
+} // namespace mlir::tt::ttnn
+
+#endif // TTMLIR_DIALECT_TTNN_ANALYSIS_OPMODELBACKEND_H
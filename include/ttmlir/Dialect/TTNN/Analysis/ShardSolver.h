@@ -9,13 +9,14 @@
 #include "ttmlir/Dialect/TTNN/Analysis/Edge.h"
 #include "ttmlir/Dialect/TTNN/Analysis/MemReconfig.h"
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
 #include "ttmlir/Dialect/TTNN/Analysis/TensorLayouts.h"
 #include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseSet.h"
 
-#include <algorithm>
-#include <bitset>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -40,31 +41,21 @@ struct ShardSolverSolution {
 //
 class ShardSolver {
 private:
-  static constexpr size_t kNumBitsetBits = 64;
-  using Bitset = std::bitset<kNumBitsetBits>;
-  static Bitset kBitsetAll;
-  static constexpr Bitset kBitsetNone = Bitset{};
+  // One bit per legal config of an op. Sized to the number of legal configs,
+  // BitVector keeps up to a few hundred bits inline so the common case does
+  // not allocate.
+  //
+  using Bitset = llvm::BitVector;
 
 public:
   struct RemainingConfigAttrs {
     class Iterator {
       std::uint64_t i = 0;
       const std::vector<OpConfig> *p = nullptr;
-      Bitset mask = 0;
+      Bitset mask;
 
     private:
-      void nextValid() {
-        if (mask == Bitset{}) {
-          i = p->size();
-          return;
-        }
-
-        while (mask.any() and not mask[i]) {
-          ++i;
-        }
-
-        mask.reset(i);
-      }
+      void seek(int next) { i = next < 0 ? p->size() : next; }
 
     public:
       using iterator_category = std::input_iterator_tag;
@@ -73,27 +64,28 @@ public:
       using pointer = const OpConfig *;
       using reference = const OpConfig &;
 
-      Iterator(const std::vector<OpConfig> *p, const Bitset &mask,
-               std::uint64_t i = 0)
-          : i(i), p(p), mask(mask) {
-        nextValid();
+      Iterator(const std::vector<OpConfig> *p, const Bitset &mask)
+          : p(p), mask(mask) {
+        seek(this->mask.find_first());
       }
 
       Iterator &operator++() {
-        nextValid();
+        seek(mask.find_next(i));
         return *this;
       }
 
       Iterator operator++(int) {
         auto r = *this;
-        nextValid();
+        seek(mask.find_next(i));
         return r;
       }
 
-      bool operator==(Iterator other) const {
+      bool operator==(const Iterator &other) const {
         return (p == other.p) and (i == other.i);
       }
-      bool operator!=(Iterator other) const { return not(*this == other); }
+      bool operator!=(const Iterator &other) const {
+        return not(*this == other);
+      }
       reference operator*() const { return (*p)[i]; }
       pointer operator->() const { return get(); }
       pointer get() const { return &(*p)[i]; }
@@ -104,24 +96,17 @@ public:
         : p(&p), mask(mask) {}
 
     Iterator begin() const { return Iterator(p, mask); }
-    Iterator end() const {
-      return Iterator(p, 0, std::min(kNumBitsetBits, p->size()));
-    }
+    Iterator end() const { return Iterator(p, Bitset()); }
     size_t size() const { return mask.count(); }
 
     const std::vector<OpConfig> *p = nullptr;
-    Bitset mask = 0;
+    Bitset mask;
   };
 
 private:
-  static Bitset bitset(std::uint64_t bit) {
-    Bitset b;
-    b.set(bit);
-    return b;
-  }
   // is `a` a subset of `b`
   static bool isSubset(const Bitset &a, const Bitset &b) {
-    return a == (a & b);
+    return !a.test(b);
   }
 
   using PathSetId = int;
@@ -158,12 +143,14 @@ private:
     llvm::DenseSet<Operation *> controlSet;
   };
 
+  // Config indices are bounded by the number of legal configs of an op, which
+  // is no longer capped now that bitsets are sized at runtime.
   struct Path {
-    std::uint16_t producerId = 0;
-    std::uint16_t consumerId = 0;
+    std::uint32_t producerId = 0;
+    std::uint32_t consumerId = 0;
 
     Path() = default;
-    Path(std::uint16_t producerId, std::uint16_t consumerId)
+    Path(std::uint32_t producerId, std::uint32_t consumerId)
         : producerId(producerId), consumerId(consumerId) {}
   };
 
@@ -179,15 +166,15 @@ private:
           consumerOperation(consumerOperation), paths(paths) {}
 
     bool empty(const std::vector<Bitset> &bitsets) const {
-      return paths.empty() or (bitsets[producerSetId] == 0) or
-             (bitsets[consumerSetId] == 0);
+      return paths.empty() or bitsets[producerSetId].none() or
+             bitsets[consumerSetId].none();
     }
 
     bool update(std::vector<Bitset> &bitsets) {
-      Bitset validProducerSet = 0;
-      Bitset validConsumerSet = 0;
-      Bitset producer = bitsets[producerSetId];
-      Bitset consumer = bitsets[consumerSetId];
+      const Bitset &producer = bitsets[producerSetId];
+      const Bitset &consumer = bitsets[consumerSetId];
+      Bitset validProducerSet(producer.size());
+      Bitset validConsumerSet(consumer.size());
 
       for (size_t i = 0; i < paths.size(); i++) {
         const Path &path = paths[i];
@@ -216,10 +203,10 @@ private:
     void
     updateOperationProcessor(std::vector<Bitset> &bitsets,
                              OperationPathsProcessor *operation_processor) {
-      Bitset validProducerSet = 0;
-      Bitset validConsumerSet = 0;
-      Bitset producer = bitsets[producerSetId];
-      Bitset consumer = bitsets[consumerSetId];
+      const Bitset &producer = bitsets[producerSetId];
+      const Bitset &consumer = bitsets[consumerSetId];
+      Bitset validProducerSet(producer.size());
+      Bitset validConsumerSet(consumer.size());
       for (size_t i = 0; i < paths.size(); i++) {
         const Path &path = paths[i];
         if (consumer[path.consumerId] and producer[path.producerId]) {
@@ -258,6 +245,7 @@ private:
   };
 
   const std::vector<OpConfig> &getLegalConfigs(Operation *operation) const;
+  TTNNLayoutAttr getCandidateOutputLayout(Operation *op) const;
   void reset();
 
   PathSet *getPathSetPt(const Edge &edge);
@@ -270,7 +258,9 @@ private:
 
   Bitset *getBitset(Operation *op);
   const Bitset *getBitset(Operation *op) const;
-  Bitset *getOrInsertBitset(Operation *op, const Bitset &init);
+  // Inserts a bitset with all legal configs of the op enabled if the op does
+  // not have one yet.
+  Bitset *getOrInsertBitset(Operation *op);
 
   bool resolveStep();
   bool insertReshard(const Edge &edge);
@@ -301,7 +291,8 @@ public:
       const llvm::DenseSet<Edge> &overrideReshardEdges,
       std::function<llvm::Expected<TTNNLayoutAttr>(Value, TTNNLayoutAttr,
                                                    Operation *, OpConfig)>
-          customCheckShardCompatible = nullptr);
+          customCheckShardCompatible = nullptr,
+      std::shared_ptr<OpModelBackend> opModelBackend = nullptr);
   RemainingConfigAttrs at(Operation *operation) const;
   void set(Operation *operation, const OpConfig &config);
   bool supportsInterleavedInputShardedOutput(Operation *op,
@@ -340,6 +331,9 @@ private:
   std::function<llvm::Expected<TTNNLayoutAttr>(mlir::Value, TTNNLayoutAttr,
                                                mlir::Operation *, OpConfig)>
       customCheckShardCompatible;
+
+  // Source of op constraints, the device op model unless provided.
+  std::shared_ptr<OpModelBackend> opModelBackend;
 };
 
 } // namespace mlir::tt::ttnn
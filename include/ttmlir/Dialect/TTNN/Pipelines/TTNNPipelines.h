@@ -7,6 +7,7 @@
 
 #include "ttmlir/Dialect/TT/Utils/PopulateArgumentTypes.h"
 #include "ttmlir/Dialect/TTNN/Utils/MemoryLayoutAnalysisParams.h"
+#include "ttmlir/Dialect/TTNN/Utils/OpModelBackendParams.h"
 #include "ttmlir/Dialect/TTNN/Utils/PassOverrides.h"
 
 #include "mlir/Pass/PassOptions.h"
@@ -170,6 +171,33 @@ struct TTIRToTTNNBackendPipelineOptions
           "Enable row major layout generation in legal layout analysis."),
       llvm::cl::init(false)};
 
+  // Option to persist op model query results to a file, so that subsequent
+  // compiles against the same tt-metal build and system descriptor can skip
+  // already answered queries.
+  //
+  Option<std::string> opModelCachePath{
+      *this, OptionNames::opModelCachePath,
+      llvm::cl::desc("Path to a file used to persist op model query results "
+                     "across compiler invocations."),
+      llvm::cl::init("")};
+
+  // Source of op constraints used by the optimizer. The analytical backend
+  // doesn't need a device, so the optimizer can run on any machine.
+  //
+  Option<OpModelBackendType, OpModelBackendTypeParser> opModelBackend{
+      *this, OptionNames::opModelBackend,
+      llvm::cl::desc("Op model backend used by the optimizer: device, "
+                     "analytical or compare."),
+      llvm::cl::init(OpModelBackendType::Device)};
+
+  // Option to report the number of L1 chain outputs spilled to DRAM.
+  //
+  Option<bool> reportSpills{
+      *this, OptionNames::reportSpills,
+      llvm::cl::desc("Emit a remark with the number of L1 chain outputs "
+                     "spilled to DRAM."),
+      llvm::cl::init(false)};
+
   // Option to enable/disable the workaround pass.
   //
   Option<bool> layoutWorkaroundsEnabled{
@@ -197,6 +225,20 @@ struct TTIRToTTNNBackendPipelineOptions
       *this, "enable-erase-inverse-ops-pass",
       llvm::cl::desc("Enable erase inverse ops pass."), llvm::cl::init(true)};
 
+  // Reorder ops to reduce peak tensor memory, right before deallocations are
+  // inserted.
+  Option<bool> memoryAwareSchedulingEnabled{
+      *this, "enable-memory-aware-scheduling",
+      llvm::cl::desc("Enable memory aware op scheduling pass."),
+      llvm::cl::init(false)};
+
+  // Convert every ToLayoutOp from the cheapest equivalent value before
+  // layouts are decomposed.
+  Option<bool> layoutCoalescingEnabled{
+      *this, "enable-layout-coalescing",
+      llvm::cl::desc("Enable layout conversion coalescing pass."),
+      llvm::cl::init(false)};
+
   Option<bool> enableFusing{*this, "enable-fusing-pass",
                             llvm::cl::desc("Enable fusing pass."),
                             llvm::cl::init(false)};
@@ -229,6 +271,25 @@ struct TTIRToTTNNBackendPipelineOptions
       llvm::cl::desc("Enable const-eval optimization pass."),
       llvm::cl::init(true)};
 
+  // Evaluate const-eval functions with compile time known inputs on the host
+  // and embed their results as constants.
+  Option<bool> constEvalFoldingEnabled{
+      *this, "enable-const-eval-folding",
+      llvm::cl::desc("Enable folding of const-eval functions at compile time."),
+      llvm::cl::init(false)};
+
+  Option<int64_t> constEvalFoldingMaxBytes{
+      *this, "const-eval-folding-max-bytes",
+      llvm::cl::desc("Maximum number of bytes of constant data const-eval "
+                     "folding may add to the binary."),
+      llvm::cl::init(64 * 1024 * 1024)};
+
+  Option<int64_t> cpuVectorWidth{
+      *this, "cpu-vector-width",
+      llvm::cl::desc("Number of elements per vector when vectorizing ops "
+                     "hoisted to the CPU (0 disables vectorization)."),
+      llvm::cl::init(0)};
+
   // Option to specify the target bit width for quantized data types.
   Option<uint32_t> quantBitWidth{
       *this, "target-bit-width",
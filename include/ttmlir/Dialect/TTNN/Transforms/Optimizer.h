@@ -7,6 +7,7 @@
 
 #include "mlir/Pass/PassRegistry.h"
 
+#include "ttmlir/Dialect/TTNN/Utils/OpModelBackendParams.h"
 #include "ttmlir/Dialect/TTNN/Utils/OptimizerOverrides.h"
 
 namespace mlir::tt::ttnn {
@@ -26,6 +27,9 @@ struct TTNNOptimizerOptions {
   bool memReconfigEnabled = false;
   int64_t maxLegalLayouts = 64;
   bool rowMajorEnabled = false;
+  std::string opModelCachePath = "";
+  OpModelBackendType opModelBackend = OpModelBackendType::Device;
+  bool reportSpills = false;
 };
 
 std::unique_ptr<::mlir::Pass> createTTNNOptimizer();
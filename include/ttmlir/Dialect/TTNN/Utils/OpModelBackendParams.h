@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTMLIR_DIALECT_TTNN_UTILS_OPMODELBACKENDPARAMS_H
+#define TTMLIR_DIALECT_TTNN_UTILS_OPMODELBACKENDPARAMS_H
+
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/CommandLine.h"
+
+#include <optional>
+
+namespace mlir::tt {
+
+enum class OpModelBackendType {
+  // Query the op model library, which opens a device.
+  Device,
+  // Estimate L1 usage from layouts, without a device.
+  Analytical,
+  // Query both, use the device results and report disagreements.
+  Compare
+};
+
+struct OpModelBackendTypeParser : public llvm::cl::parser<OpModelBackendType> {
+public:
+  OpModelBackendTypeParser(llvm::cl::Option &opt)
+      : llvm::cl::parser<OpModelBackendType>(opt) {}
+
+  bool parse(llvm::cl::Option &opt, llvm::StringRef argName,
+             llvm::StringRef arg, OpModelBackendType &value) {
+    std::optional<OpModelBackendType> type =
+        llvm::StringSwitch<std::optional<OpModelBackendType>>(arg)
+            .Case("device", OpModelBackendType::Device)
+            .Case("analytical", OpModelBackendType::Analytical)
+            .Case("compare", OpModelBackendType::Compare)
+            .Default(std::nullopt);
+    if (!type) {
+      return opt.error("Invalid op model backend: " + arg);
+    }
+    value = *type;
+    return false;
+  }
+
+  static std::string toString(const OpModelBackendType &value) {
+    std::string res;
+    switch (value) {
+    case OpModelBackendType::Device:
+      res += "device";
+      break;
+    case OpModelBackendType::Analytical:
+      res += "analytical";
+      break;
+    case OpModelBackendType::Compare:
+      res += "compare";
+      break;
+    }
+    return res;
+  }
+
+  static void print(llvm::raw_ostream &os, const OpModelBackendType &value) {
+    os << "op-model-backend=" << OpModelBackendTypeParser::toString(value)
+       << "\n";
+  }
+};
+
+} // namespace mlir::tt
+
+#endif // TTMLIR_DIALECT_TTNN_UTILS_OPMODELBACKENDPARAMS_H
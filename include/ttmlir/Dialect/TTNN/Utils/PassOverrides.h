@@ -28,6 +28,9 @@ struct OptionNames {
   static constexpr StringRef systemDescPath = "system-desc-path";
   static constexpr StringRef maxLegalLayouts = "max-legal-layouts";
   static constexpr StringRef meshShape = "mesh-shape";
+  static constexpr StringRef opModelCachePath = "op-model-cache-path";
+  static constexpr StringRef opModelBackend = "op-model-backend";
+  static constexpr StringRef reportSpills = "report-spills";
 };
 
 struct Conv2dConfigOverrideParams {
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTMLIR_OPMODEL_TTNN_OPMODELCACHE_H
+#define TTMLIR_OPMODEL_TTNN_OPMODELCACHE_H
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+
+#include "mlir/IR/Attributes.h"
+#include "mlir/IR/MLIRContext.h"
+#include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace mlir::tt::op_model::ttnn {
+
+using OpConstraints =
+    std::tuple<size_t, size_t, size_t, ::mlir::tt::ttnn::TTNNLayoutAttr>;
+
+namespace detail {
+// Key serialization helpers. Every argument of an op model query is printed
+// into the key in a textual, context independent form so that identical
+// queries issued from different ops (or different processes, when the cache
+// is persisted) map to the same entry.
+inline void appendKey(llvm::raw_ostream &os, mlir::Attribute attr);
+inline void appendKey(llvm::raw_ostream &os, const llvm::APFloat &value);
+template <typename T>
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>
+appendKey(llvm::raw_ostream &os, T value);
+template <typename T>
+void appendKey(llvm::raw_ostream &os, llvm::ArrayRef<T> values);
+template <typename T>
+void appendKey(llvm::raw_ostream &os, const std::optional<T> &value);
+
+inline void appendKey(llvm::raw_ostream &os, mlir::Attribute attr) {
+  if (!attr) {
+    os << "null";
+    return;
+  }
+  attr.print(os);
+}
+
+inline void appendKey(llvm::raw_ostream &os, const llvm::APFloat &value) {
+  os << llvm::format_hex(value.bitcastToAPInt().getZExtValue(), 18);
+}
+
+template <typename T>
+std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>
+appendKey(llvm::raw_ostream &os, T value) {
+  if constexpr (std::is_enum_v<T>) {
+    os << static_cast<std::underlying_type_t<T>>(value);
+  } else {
+    os << value;
+  }
+}
+
+template <typename T>
+void appendKey(llvm::raw_ostream &os, llvm::ArrayRef<T> values) {
+  os << '[';
+  llvm::interleaveComma(values, os,
+                        [&](const T &value) { appendKey(os, value); });
+  os << ']';
+}
+
+template <typename T>
+void appendKey(llvm::raw_ostream &os, const std::optional<T> &value) {
+  if (!value.has_value()) {
+    os << "none";
+    return;
+  }
+  appendKey(os, *value);
+}
+} // namespace detail
+
+// Process wide, content addressed memoization of op model queries.
+//
+// Constraint and runtime queries are keyed by the op name and the full list of
+// query arguments (shapes, layouts, op specific attributes). Failed queries
+// are memoized as well, since they are just as expensive to re-issue. The
+// cache can optionally be persisted to disk; a persisted cache is only reused
+// when its fingerprint (tt-metal version and system descriptor) matches.
+//
+class OpModelCache {
+public:
+  struct Stats {
+    size_t constraintsHits = 0;
+    size_t constraintsMisses = 0;
+    size_t runtimeHits = 0;
+    size_t runtimeMisses = 0;
+  };
+
+  static OpModelCache &getInstance();
+
+  template <typename... Args>
+  static std::string makeKey(llvm::StringRef opName, const Args &...args) {
+    std::string key;
+    llvm::raw_string_ostream os(key);
+    os << opName;
+    ((os << '|', detail::appendKey(os, args)), ...);
+    return os.str();
+  }
+
+  // Returns the memoized constraints for the given key, or invokes the
+  // callable and memoizes its result. The output layout is materialized in
+  // the given context.
+  template <typename Callable>
+  llvm::Expected<OpConstraints>
+  getOrComputeConstraints(llvm::StringRef key, MLIRContext *context,
+                          Callable &&callable) {
+    if (!isEnabled()) {
+      return callable();
+    }
+    if (std::optional<llvm::Expected<OpConstraints>> cached =
+            lookupConstraints(key, context)) {
+      return std::move(*cached);
+    }
+    llvm::Expected<OpConstraints> result = callable();
+    return insertConstraints(key, std::move(result));
+  }
+
+  // Returns the memoized runtime for the given key, or invokes the callable
+  // and memoizes its result.
+  template <typename Callable>
+  llvm::Expected<size_t> getOrComputeRuntime(llvm::StringRef key,
+                                             Callable &&callable) {
+    if (!isEnabled()) {
+      return callable();
+    }
+    if (std::optional<llvm::Expected<size_t>> cached = lookupRuntime(key)) {
+      return std::move(*cached);
+    }
+    llvm::Expected<size_t> result = callable();
+    return insertRuntime(key, std::move(result));
+  }
+
+  // Fingerprint identifying the environment the cached results are valid for.
+  static std::string getFingerprint(SystemDescAttr systemDesc);
+
+  // Merges entries from a previously saved cache file. A missing file is not
+  // an error; a file with a different fingerprint is ignored.
+  llvm::Error loadFromFile(llvm::StringRef path, llvm::StringRef fingerprint);
+  llvm::Error saveToFile(llvm::StringRef path,
+                         llvm::StringRef fingerprint) const;
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const;
+
+  void clear();
+  size_t size() const;
+
+  Stats getStats() const;
+  void resetStats();
+
+private:
+  struct ConstraintsEntry {
+    bool success = false;
+    size_t cbPeakSize = 0;
+    size_t l1BuffersPeakSize = 0;
+    size_t l1OutputBufferSize = 0;
+    // Textual form of the output layout, or the error message on failure.
+    std::string payload;
+  };
+
+  struct RuntimeEntry {
+    bool success = false;
+    size_t runtime = 0;
+    std::string errorMessage;
+  };
+
+  OpModelCache() = default;
+  OpModelCache(const OpModelCache &) = delete;
+  OpModelCache &operator=(const OpModelCache &) = delete;
+
+  std::optional<llvm::Expected<OpConstraints>>
+  lookupConstraints(llvm::StringRef key, MLIRContext *context);
+  llvm::Expected<OpConstraints>
+  insertConstraints(llvm::StringRef key, llvm::Expected<OpConstraints> result);
+
+  std::optional<llvm::Expected<size_t>> lookupRuntime(llvm::StringRef key);
+  llvm::Expected<size_t> insertRuntime(llvm::StringRef key,
+                                       llvm::Expected<size_t> result);
+
+  mutable std::mutex mutex;
+  bool enabled = true;
+  llvm::StringMap<ConstraintsEntry> constraintsCache;
+  llvm::StringMap<RuntimeEntry> runtimeCache;
+  Stats stats;
+};
+
+} // namespace mlir::tt::op_model::ttnn
+
+#endif // TTMLIR_OPMODEL_TTNN_OPMODELCACHE_H
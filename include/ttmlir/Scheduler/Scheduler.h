@@ -5,6 +5,8 @@
 #ifndef TTMLIR_SCHEDULER_SCHEDULER_H
 #define TTMLIR_SCHEDULER_SCHEDULER_H
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "mlir/Dialect/Func/IR/FuncOps.h"
@@ -12,10 +14,36 @@
 
 namespace mlir::tt::scheduler {
 
+// Order in which ready ops are returned by getScheduleableOps.
+enum class SchedulePriority {
+  // Program order of the ops in the function.
+  ProgramOrder,
+  // Ops with the longest chain of dependent ops first.
+  CriticalPath,
+  // Ops that consume the most and produce the least tensor data first.
+  MemoryPressure,
+};
+
+// Ready queue scheduler. The dependency graph is built once, per op in-degree
+// counters are updated as ops are scheduled, so getting the ready ops costs
+// the number of ready ops and scheduling an op costs the number of its users.
+//
+// Copies and snapshots share the dependency graph and the scheduling state
+// until one of them schedules an op, at which point that one copies the
+// state.
+//
 class Scheduler {
 public:
+  // Static priority of an op. Ops with a higher priority are returned first
+  // by getScheduleableOps, ties are broken by program order.
+  using PriorityFn = std::function<int64_t(mlir::Operation *)>;
+
   // Constructor taking an MLIR Operation (or a module)
-  Scheduler(func::FuncOp *root);
+  Scheduler(func::FuncOp *root,
+            SchedulePriority priority = SchedulePriority::ProgramOrder);
+
+  // Constructor taking a custom priority function
+  Scheduler(func::FuncOp *root, PriorityFn priority);
 
   // Copy constructor
   Scheduler(const Scheduler &scheduler);
@@ -30,6 +58,9 @@ public:
   // Method to check if an operation can be scheduled
   bool canSchedule(mlir::Operation *op);
 
+  // Method to check if an operation is already scheduled
+  bool isScheduled(mlir::Operation *op) const;
+
   // Method to schedule an operation
   void scheduleOp(mlir::Operation *op);
 
@@ -43,15 +74,17 @@ public:
   bool hasUnscheduledOps() const;
 
 private:
-  // Map of scheduled operations
-  llvm::DenseSet<mlir::Operation *> scheduledOpsMap;
-  // Operation schedule in order of execution
-  llvm::SmallVector<mlir::Operation *> schedule;
-  // Set of unscheduled operations
-  llvm::DenseSet<mlir::Operation *> unscheduledOps;
-  // Map of dependencies
-  llvm::DenseMap<mlir::Operation *, llvm::SmallVector<mlir::Operation *>>
-      dependencies;
+  struct Graph;
+  struct State;
+
+  // Returns the state for modification, copying it first if it is shared
+  // with another scheduler.
+  State &getMutableState();
+
+  // Immutable dependency graph, shared by all copies
+  std::shared_ptr<const Graph> graph;
+  // Scheduling progress, shared by copies until modified
+  std::shared_ptr<State> state;
 };
 
 } // namespace mlir::tt::scheduler
@@ -11,7 +11,8 @@
 
 namespace mlir::tt::ttnn {
 
-// Convert a TTNNIR operation to a flatbuffer
+// Convert a TTNNIR operation to a flatbuffer. Returns nullptr, after emitting
+// an error, if the debug artifacts sidecar file cannot be written.
 std::shared_ptr<void> ttnnToFlatbuffer(
     Operation *op,
     const std::unordered_map<std::string, GoldenTensor> &goldenMap = {},
@@ -22,6 +22,9 @@ struct Program {
   std::vector<::flatbuffers::Offset<::tt::target::ttnn::TensorRef>> inputs;
   std::vector<::flatbuffers::Offset<::tt::target::ttnn::TensorRef>> outputs;
   std::vector<::flatbuffers::Offset<OpT>> ops;
+  // Range of global ids assigned to tensors of this program.
+  uint32_t tensorIdBegin = 0;
+  uint32_t numTensors = 0;
 };
 
 inline std::string getOpDebugString(mlir::Operation *op,
@@ -70,6 +73,7 @@ Program<OpT> funcOpToProgram(FlatbufferObjectCache &cache, func::FuncOp entry,
 
   Program<OpT> program;
   program.name = entry.getSymName().data();
+  program.tensorIdBegin = cache.global_id;
 
   for (auto &input : entry.getBody().getArguments()) {
     program.inputs.push_back(
@@ -90,6 +94,7 @@ Program<OpT> funcOpToProgram(FlatbufferObjectCache &cache, func::FuncOp entry,
     }
   });
 
+  program.numTensors = cache.global_id - program.tensorIdBegin;
   return program;
 }
 
@@ -14,8 +14,10 @@
 #include "ttmlir/Utils.h"
 
 #include "flatbuffers/buffer.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLForwardCompat.h"
 
+#include <memory>
 #include <type_traits>
 
 namespace mlir::tt {
@@ -26,6 +28,10 @@ struct GoldenTensor {
   std::vector<int64_t> strides;
   ::tt::target::DataType dtype;
   std::vector<std::uint8_t> data;
+  // Borrowed tensor data, used instead of 'data' when set. 'dataOwner' holds
+  // whatever keeps the borrowed memory alive and travels with every copy.
+  llvm::ArrayRef<std::uint8_t> dataRef;
+  std::shared_ptr<const void> dataOwner;
 
   GoldenTensor(std::string name, std::vector<int64_t> shape,
                std::vector<int64_t> strides, ::tt::target::DataType dtype,
@@ -33,8 +39,19 @@ struct GoldenTensor {
       : name(name), shape(shape), strides(strides), dtype(dtype),
         data(std::move(_data)) {}
 
+  GoldenTensor(std::string name, std::vector<int64_t> shape,
+               std::vector<int64_t> strides, ::tt::target::DataType dtype,
+               llvm::ArrayRef<std::uint8_t> dataRef,
+               std::shared_ptr<const void> dataOwner)
+      : name(name), shape(shape), strides(strides), dtype(dtype),
+        dataRef(dataRef), dataOwner(std::move(dataOwner)) {}
+
   // Create an explicit empty constructor
   GoldenTensor() = default;
+
+  llvm::ArrayRef<std::uint8_t> getData() const {
+    return dataRef.data() ? dataRef : llvm::ArrayRef<std::uint8_t>(data);
+  }
 };
 
 inline flatbuffers::Offset<::tt::target::MLIR>
@@ -55,19 +72,23 @@ inline flatbuffers::Offset<::tt::target::DebugInfo> debugInfoToFlatbuffer(
     ModuleOp module,
     const std::unordered_map<std::string, GoldenTensor> &goldenMap,
     const std::vector<std::pair<std::string, std::string>> &moduleCache,
-    const char *cpp = nullptr) {
+    const char *cpp = nullptr, const char *artifactsPath = nullptr) {
   std::vector<flatbuffers::Offset<::tt::target::GoldenKV>> goldenKVList;
   goldenKVList.reserve(goldenMap.size());
 
   for (const auto &[key, value] : goldenMap) {
-    auto goldenTensor = ::tt::target::CreateGoldenTensorDirect(
-        fbb, value.name.c_str(), &value.shape, &value.strides, value.dtype,
-        &value.data);
+    llvm::ArrayRef<std::uint8_t> data = value.getData();
+    auto goldenTensor = ::tt::target::CreateGoldenTensor(
+        fbb, fbb.CreateString(value.name), fbb.CreateVector(value.shape),
+        fbb.CreateVector(value.strides), value.dtype,
+        fbb.CreateVector(data.data(), data.size()));
     auto goldenKV =
         ::tt::target::CreateGoldenKVDirect(fbb, key.c_str(), goldenTensor);
     goldenKVList.push_back(goldenKV);
   }
 
+  // GoldenKV is keyed on the location, so the map is stored sorted and can be
+  // searched with LookupByKey.
   auto goldenInfo = ::tt::target::CreateGoldenInfoDirect(fbb, &goldenKVList);
 
   // Load the ModuleCache if present and populate DebugInfo
@@ -82,7 +103,8 @@ inline flatbuffers::Offset<::tt::target::DebugInfo> debugInfoToFlatbuffer(
   }
 
   return ::tt::target::CreateDebugInfoDirect(
-      fbb, toDebugInfo(fbb, name, module), cpp, &moduleCacheList, goldenInfo);
+      fbb, toDebugInfo(fbb, name, module), cpp, &moduleCacheList, goldenInfo,
+      artifactsPath);
 }
 
 inline ::tt::target::OOBVal toFlatbuffer(FlatbufferObjectCache &,
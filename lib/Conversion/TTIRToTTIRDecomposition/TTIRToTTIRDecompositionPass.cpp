@@ -85,7 +85,8 @@ struct TTIRToTTIRDecompositionPass
 
 namespace mlir::tt {
 
-std::unique_ptr<OperationPass<ModuleOp>> createTTIRToTTIRDecompositionPass() {
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTTIRToTTIRDecompositionPass() {
   return std::make_unique<TTIRToTTIRDecompositionPass>();
 }
 
@@ -449,10 +449,17 @@ public:
 
       // Both src and dst are local, use the metal cb pointers to determine
       // addressing
-      Value srcL1Start = rewriter.create<ttkernel::GetReadPtrOp>(
-          op.getLoc(), adaptor.getSrc());
       Value dstL1Start = rewriter.create<ttkernel::GetWritePtrOp>(
           op.getLoc(), adaptor.getDst());
+      // A DMA from a cb to itself forwards the block this thread just wrote,
+      // e.g. the multicast after a gather. The thread only reserves and pushes
+      // that cb, so its read pointer never advances past the first buffer;
+      // the data sits at the write pointer instead.
+      Value srcL1Start = dstL1Start;
+      if (adaptor.getSrc() != adaptor.getDst()) {
+        srcL1Start = rewriter.create<ttkernel::GetReadPtrOp>(op.getLoc(),
+                                                             adaptor.getSrc());
+      }
 
       Value transferSize = i32(rewriter, op->getLoc(),
                                getLocalMemrefSizeBytes(srcCb.getMemref()));
@@ -1134,9 +1134,8 @@ size_t DeviceAttr::getMemrefSizeBytes(MemRefType memrefType, size_t pageSize,
   bool isLocalMemref = (layout == nullptr);
   auto shardShape =
       isLocalMemref ? memrefType.getShape() : layout.getShardShape(memrefType);
-  return ttmlir::utils::volume(shardShape,
-                               elementSizeBytes *
-                                   (includeBuffers ? layout.getBuffers() : 1));
+  int64_t buffers = includeBuffers && layout ? layout.getBuffers() : 1;
+  return ttmlir::utils::volume(shardShape, elementSizeBytes * buffers);
 }
 
 size_t DeviceAttr::getMemrefCBPageSizeBytes(MemRefType memrefType) const {
@@ -4,14 +4,19 @@
 
 #include "ttmlir/Dialect/TTIR/Pipelines/TTIRPipelines.h"
 
+#include "mlir/Conversion/AffineToStandard/AffineToStandard.h"
 #include "mlir/Conversion/ArithToLLVM/ArithToLLVM.h"
 #include "mlir/Conversion/ControlFlowToLLVM/ControlFlowToLLVM.h"
 #include "mlir/Conversion/FuncToLLVM/ConvertFuncToLLVMPass.h"
 #include "mlir/Conversion/MathToLLVM/MathToLLVM.h"
 #include "mlir/Conversion/SCFToControlFlow/SCFToControlFlow.h"
 #include "mlir/Conversion/TensorToLinalg/TensorToLinalgPass.h"
+#include "mlir/Conversion/VectorToLLVM/ConvertVectorToLLVMPass.h"
+#include "mlir/Conversion/VectorToSCF/VectorToSCF.h"
+#include "mlir/Dialect/Affine/Passes.h"
 #include "mlir/Dialect/Bufferization/Pipelines/Passes.h"
 #include "mlir/Dialect/Bufferization/Transforms/Passes.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Linalg/Passes.h"
 #include "mlir/InitAllDialects.h"
 #include "mlir/InitAllPasses.h"
@@ -73,8 +78,19 @@ void createLinalgToLLVMPipeline(OpPassManager &manager,
   // eliminate some nasty bufferization::clone() calls.
   manager.addPass(mlir::createBufferizationToMemRefPass());
 
-  // This lowers linalg to scf-based loops.
-  manager.addPass(mlir::createConvertLinalgToLoopsPass());
+  if (options.vectorWidth > 0) {
+    // Affine loops let the super vectorizer turn the innermost loop of each
+    // op into vector transfers, which are then unrolled to 1-D vectors.
+    int64_t vectorWidth = options.vectorWidth;
+    manager.addPass(mlir::createConvertLinalgToAffineLoopsPass());
+    manager.addNestedPass<func::FuncOp>(
+        mlir::affine::createSuperVectorizePass(vectorWidth));
+    manager.addPass(mlir::createLowerAffinePass());
+    manager.addPass(mlir::createConvertVectorToSCFPass());
+  } else {
+    // This lowers linalg to scf-based loops.
+    manager.addPass(mlir::createConvertLinalgToLoopsPass());
+  }
 
   // This is needed to lower memref.subview before we can convert all memref ops
   // to LLVM.
@@ -84,6 +100,9 @@ void createLinalgToLLVMPipeline(OpPassManager &manager,
   manager.addPass(mlir::createConvertSCFToCFPass());
   manager.addPass(mlir::createConvertControlFlowToLLVMPass());
   // These passes convert corresponding primitives to their LLVM equivalents.
+  if (options.vectorWidth > 0) {
+    manager.addPass(mlir::createConvertVectorToLLVMPass());
+  }
   manager.addPass(mlir::createArithToLLVMConversionPass());
   manager.addPass(mlir::createConvertMathToLLVMPass());
   manager.addPass(mlir::createConvertFuncToLLVMPass());
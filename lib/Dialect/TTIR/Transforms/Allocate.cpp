@@ -10,8 +10,14 @@
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLForwardCompat.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/Support/FormatVariadic.h"
+
+#include <limits>
+#include <optional>
 
 // ----------------------------------------------------------------------------
 namespace mlir::tt::ttir {
@@ -34,41 +40,124 @@ inline MemorySpace getMemorySpace(MemRefType memref, MemorySpace dflt) {
 // Helper classes.
 //===----------------------------------------------------------------------===//
 namespace {
-struct SimpleAllocator {
-  struct MemorySpaceInfo {
-    uint64_t baseAddress = 0;
-    uint64_t size = 0;
-    uint64_t alignment = 0;
-
-    MemorySpaceInfo() = default;
-    MemorySpaceInfo(uint64_t baseAddress, uint64_t size, uint64_t alignment)
-        : baseAddress(baseAddress), size(size), alignment(alignment) {}
-    inline uint64_t end() const { return baseAddress + size; }
-  };
-
-  SimpleAllocator(SmallVector<MemorySpaceInfo> memorySpaceInfo)
-      : currPtr(llvm::map_to_vector(
-            memorySpaceInfo, [](auto &&info) { return info.baseAddress; })),
-        memorySpaceInfo(memorySpaceInfo) {}
-
-  std::array<uint64_t, 2> allocate(uint64_t size, MemorySpace memorySpace) {
-    if (isSystemMemorySpace(memorySpace)) {
-      return {0, 0};
+struct MemorySpaceInfo {
+  uint64_t baseAddress = 0;
+  uint64_t size = 0;
+  uint64_t alignment = 0;
+
+  MemorySpaceInfo() = default;
+  MemorySpaceInfo(uint64_t baseAddress, uint64_t size, uint64_t alignment)
+      : baseAddress(baseAddress), size(size), alignment(alignment) {}
+  inline uint64_t end() const { return baseAddress + size; }
+};
+
+// A device buffer and its live range, given as inclusive positions of the
+// top level ops of the function body.
+struct LiveBuffer {
+  memref::AllocOp alloc;
+  MemorySpace memorySpace;
+  uint64_t size = 0;
+  int64_t start = 0;
+  int64_t end = 0;
+  uint64_t address = 0;
+  // Buffer is only read through streams or written by host transfers, so it
+  // does not have to reside in L1.
+  bool spillable = false;
+  bool spilled = false;
+
+  bool overlaps(const LiveBuffer &other) const {
+    return start <= other.end && other.start <= end;
+  }
+};
+
+struct MemoryUsage {
+  // Highest address used, relative to the base of the memory space.
+  uint64_t peak = 0;
+  // Largest number of bytes live at the same time.
+  uint64_t maxLive = 0;
+
+  double fragmentation() const {
+    return peak ? static_cast<double>(peak - maxLive) / peak : 0.0;
+  }
+};
+
+// Static allocator for buffers with known live ranges. Buffers are placed
+// largest first, each at the start of the smallest free gap (best fit) left
+// by already placed buffers whose live ranges overlap it.
+//
+// Returns the first buffer that could not be placed, or nullptr on success.
+LiveBuffer *placeBuffers(MutableArrayRef<LiveBuffer *> buffers,
+                         const MemorySpaceInfo &info) {
+  llvm::stable_sort(buffers, [](const LiveBuffer *a, const LiveBuffer *b) {
+    if (a->size != b->size) {
+      return a->size > b->size;
+    }
+    return a->start < b->start;
+  });
+
+  SmallVector<LiveBuffer *> placed;
+  for (LiveBuffer *buffer : buffers) {
+    SmallVector<LiveBuffer *> conflicts;
+    for (LiveBuffer *other : placed) {
+      if (other->overlaps(*buffer)) {
+        conflicts.push_back(other);
+      }
     }
+    llvm::sort(conflicts, [](const LiveBuffer *a, const LiveBuffer *b) {
+      return a->address < b->address;
+    });
+
+    std::optional<uint64_t> bestAddress;
+    uint64_t bestGap = std::numeric_limits<uint64_t>::max();
+    uint64_t candidate =
+        ttmlir::utils::alignUp(info.baseAddress, info.alignment);
+    auto considerGap = [&](uint64_t gapEnd) {
+      if (candidate > gapEnd || gapEnd - candidate < buffer->size) {
+        return;
+      }
+      if (gapEnd - candidate < bestGap) {
+        bestGap = gapEnd - candidate;
+        bestAddress = candidate;
+      }
+    };
+    for (const LiveBuffer *other : conflicts) {
+      considerGap(other->address);
+      candidate = std::max(candidate,
+                           ttmlir::utils::alignUp(other->address + other->size,
+                                                  info.alignment));
+    }
+    considerGap(info.end());
 
-    const auto index = llvm::to_underlying(memorySpace);
-    uint64_t &ptr = currPtr[index];
-    const uint64_t alignment = memorySpaceInfo[index].alignment;
-    ptr = ttmlir::utils::alignUp(ptr, alignment);
-    const uint64_t result = ptr;
-    ptr += size;
-    assert(ptr <= memorySpaceInfo[index].end() && "Out of memory");
-    return {result, alignment};
+    if (!bestAddress) {
+      return buffer;
+    }
+    buffer->address = *bestAddress;
+    placed.push_back(buffer);
   }
 
-  SmallVector<uint64_t> currPtr;
-  SmallVector<MemorySpaceInfo> memorySpaceInfo;
-}; // end of class
+  return nullptr;
+}
+
+MemoryUsage getMemoryUsage(ArrayRef<LiveBuffer *> buffers,
+                           const MemorySpaceInfo &info) {
+  MemoryUsage usage;
+  SmallVector<std::pair<int64_t, int64_t>> events;
+  for (const LiveBuffer *buffer : buffers) {
+    usage.peak =
+        std::max(usage.peak, buffer->address + buffer->size - info.baseAddress);
+    events.emplace_back(buffer->start, buffer->size);
+    events.emplace_back(buffer->end + 1, -static_cast<int64_t>(buffer->size));
+  }
+
+  // Frees sort before allocations at the same position.
+  llvm::sort(events);
+  int64_t live = 0;
+  for (const auto &[position, delta] : events) {
+    live += delta;
+    usage.maxLive = std::max(usage.maxLive, static_cast<uint64_t>(live));
+  }
+  return usage;
+}
 } // namespace
 
 //===----------------------------------------------------------------------===//
@@ -78,10 +167,21 @@ namespace {
 class TTIRAllocateStreams final : public OpRewritePattern<ttir::GenericOp> {
   using base = OpRewritePattern<ttir::GenericOp>;
 
-  using base::base;
+public:
+  TTIRAllocateStreams(MLIRContext *context, uint32_t numStreamBuffers)
+      : base(context), numStreamBuffers(numStreamBuffers) {}
 
+private:
   LogicalResult matchAndRewrite(ttir::GenericOp op,
                                 PatternRewriter &rewriter) const final {
+    // Back every stream with several buffers so that the data movement
+    // thread can fetch the next block while compute works on the current
+    // one. A single block has nothing to overlap with.
+    uint32_t numBuffers =
+        ttmlir::utils::volume<int64_t>(op.getLoopBounds()) > 1
+            ? numStreamBuffers
+            : 1;
+
     bool modified = false;
     unsigned outputOperandsIndex = op.getOutputs().getBeginOperandIndex();
     ArrayAttr iteratorTypes = op.getIteratorTypes();
@@ -97,7 +197,7 @@ class TTIRAllocateStreams final : public OpRewritePattern<ttir::GenericOp> {
         continue;
       }
 
-      insertStream(rewriter, operand, op);
+      insertStream(rewriter, operand, op, numBuffers);
       modified = true;
     }
 
@@ -160,14 +260,14 @@ class TTIRAllocateStreams final : public OpRewritePattern<ttir::GenericOp> {
   }
 
   static void insertStream(PatternRewriter &rewriter, OpOperand &operand,
-                           ttir::GenericOp op) {
+                           ttir::GenericOp op, uint32_t numBuffers) {
     auto memref = mlir::cast<MemRefType>(operand.get().getType());
     auto streamAttr = rewriter.getAttr<ViewLayoutAttr>(
         rewriter.getMultiDimIdentityMap(memref.getRank()));
     auto streamMemref =
         MemRefType::get(memref.getShape(), memref.getElementType(), streamAttr,
                         memref.getMemorySpace());
-    auto storageAttr = ShardLayoutAttr::get(memref, /*buffers=*/1);
+    auto storageAttr = ShardLayoutAttr::get(memref, numBuffers);
     auto storageMemref =
         MemRefType::get(memref.getShape(), memref.getElementType(), storageAttr,
                         memref.getMemorySpace());
@@ -178,6 +278,7 @@ class TTIRAllocateStreams final : public OpRewritePattern<ttir::GenericOp> {
         op, [&]() { operand.assign(streamLayout.getResult()); });
   }
 
+  uint32_t numStreamBuffers;
 }; // end of class
 } // namespace
 // ............................................................................
@@ -207,7 +308,7 @@ class TTIRAllocate final : public impl::TTIRAllocateBase<TTIRAllocate> {
 
   LogicalResult runAllocateStreams(ModuleOp moduleOp) {
     RewritePatternSet patterns(&getContext());
-    patterns.add<TTIRAllocateStreams>(&getContext());
+    patterns.add<TTIRAllocateStreams>(&getContext(), numStreamBuffers);
     return mlir::applyPatternsGreedily(getOperation(), std::move(patterns));
   }
 
@@ -237,13 +338,112 @@ class TTIRAllocate final : public impl::TTIRAllocateBase<TTIRAllocate> {
            "found func that didn't have one block!");
 
     DeviceAttr device = lookupDevice(func);
-    SimpleAllocator allocator = createSimpleAllocator(chipDesc);
+    SmallVector<MemorySpaceInfo> memorySpaceInfo = getMemorySpaceInfo(chipDesc);
+    SmallVector<LiveBuffer> buffers = analyzeLiveBuffers(func, device);
+
+    auto getBuffers = [&](MemorySpace memorySpace) {
+      SmallVector<LiveBuffer *> result;
+      for (LiveBuffer &buffer : buffers) {
+        if (buffer.memorySpace == memorySpace) {
+          result.push_back(&buffer);
+        }
+      }
+      return result;
+    };
+
+    // Place L1 buffers first; while they don't fit, move buffers that are
+    // only accessed through streams out to DRAM.
+    const MemorySpaceInfo &l1Info =
+        memorySpaceInfo[llvm::to_underlying(MemorySpace::DeviceL1)];
+    while (true) {
+      SmallVector<LiveBuffer *> l1Buffers = getBuffers(MemorySpace::DeviceL1);
+      LiveBuffer *failed = placeBuffers(l1Buffers, l1Info);
+      if (!failed) {
+        break;
+      }
+      LiveBuffer *victim =
+          spillToDRAM ? pickSpillCandidate(buffers, *failed) : nullptr;
+      if (!victim) {
+        return failed->alloc.emitOpError()
+               << "out of L1 memory: buffer of " << failed->size
+               << " bytes does not fit, " << l1Info.size
+               << " bytes available";
+      }
+      victim->memorySpace = MemorySpace::DeviceDRAM;
+      victim->spilled = true;
+    }
+
+    const MemorySpaceInfo &dramInfo =
+        memorySpaceInfo[llvm::to_underlying(MemorySpace::DeviceDRAM)];
+    SmallVector<LiveBuffer *> dramBuffers = getBuffers(MemorySpace::DeviceDRAM);
+    if (LiveBuffer *failed = placeBuffers(dramBuffers, dramInfo)) {
+      return failed->alloc.emitOpError()
+             << "out of DRAM memory: buffer of " << failed->size
+             << " bytes does not fit, " << dramInfo.size << " bytes available";
+    }
 
     // Augment all 'memref.alloc's in device memory with allocated addresses and
     // correct alignments.
 
     IRRewriter rewriter(&getContext());
+    for (LiveBuffer &buffer : buffers) {
+      if (buffer.spilled) {
+        spillBuffer(rewriter, buffer.alloc);
+      }
+
+      const uint64_t alignment =
+          memorySpaceInfo[llvm::to_underlying(buffer.memorySpace)].alignment;
+      rewriter.modifyOpInPlace(buffer.alloc, [&]() {
+        buffer.alloc.setAlignment(alignment);
+        buffer.alloc->setAttr("address",
+                              rewriter.getI64IntegerAttr(buffer.address));
+      });
+    }
+
+    if (reportMemoryUsage) {
+      size_t numSpilled = llvm::count_if(
+          buffers, [](const LiveBuffer &buffer) { return buffer.spilled; });
+      for (auto [memorySpace, name] :
+           {std::make_pair(MemorySpace::DeviceL1, "L1"),
+            std::make_pair(MemorySpace::DeviceDRAM, "DRAM")}) {
+        const MemorySpaceInfo &info =
+            memorySpaceInfo[llvm::to_underlying(memorySpace)];
+        SmallVector<LiveBuffer *> spaceBuffers = getBuffers(memorySpace);
+        MemoryUsage usage = getMemoryUsage(spaceBuffers, info);
+        func.emitRemark() << name << " usage: " << spaceBuffers.size()
+                          << " buffers, peak " << usage.peak << " of "
+                          << info.size << " bytes, max live " << usage.maxLive
+                          << " bytes, fragmentation "
+                          << llvm::formatv("{0:F1}",
+                                           usage.fragmentation() * 100.0)
+                          << "%";
+      }
+      if (numSpilled) {
+        func.emitRemark() << numSpilled << " buffers spilled from L1 to DRAM";
+      }
+    }
 
+    return success();
+  }
+
+  // Computes live ranges of all device buffers allocated in 'func'. A buffer
+  // is live from its allocation until the last top level op that uses it,
+  // directly or through a view or stream of it.
+  static SmallVector<LiveBuffer> analyzeLiveBuffers(func::FuncOp func,
+                                                    DeviceAttr device) {
+    Block &body = func.getBody().front();
+    llvm::DenseMap<Operation *, int64_t> positions;
+    for (Operation &op : body) {
+      positions.try_emplace(&op, positions.size());
+    }
+    auto getPosition = [&](Operation *op) -> std::optional<int64_t> {
+      if (Operation *ancestor = body.findAncestorOpInBlock(*op)) {
+        return positions.lookup(ancestor);
+      }
+      return std::nullopt;
+    };
+
+    SmallVector<LiveBuffer> buffers;
     func->walk([&](memref::AllocOp alloc) {
       MemRefType memrefTy = alloc.getType();
       MemorySpace memorySpace = getMemorySpace(
@@ -253,37 +453,117 @@ class TTIRAllocate final : public impl::TTIRAllocateBase<TTIRAllocate> {
         return;
       }
 
-      const auto sizeBytes = device.getMemrefSizeBytes(memrefTy, 0);
-      const auto [address, alignment] =
-          allocator.allocate(sizeBytes, memorySpace);
+      LiveBuffer buffer;
+      buffer.alloc = alloc;
+      buffer.memorySpace = memorySpace;
+      buffer.size =
+          device.getMemrefSizeBytes(memrefTy, 0, /*includeBuffers=*/true);
+      buffer.start = buffer.end = getPosition(alloc).value_or(0);
+      buffer.spillable = memorySpace == MemorySpace::DeviceL1 &&
+                         !alloc->use_empty() &&
+                         llvm::all_of(alloc->getUses(), canLiveInDRAM);
+
+      // Follow memref results of users, e.g. views and streams, since they
+      // alias the buffer.
+      SmallVector<Value> worklist = {alloc.getResult()};
+      llvm::SmallPtrSet<Operation *, 8> visited;
+      while (!worklist.empty()) {
+        Value value = worklist.pop_back_val();
+        for (Operation *user : value.getUsers()) {
+          if (!visited.insert(user).second) {
+            continue;
+          }
+          if (std::optional<int64_t> position = getPosition(user)) {
+            buffer.end = std::max(buffer.end, *position);
+          }
+          for (Value result : user->getResults()) {
+            if (mlir::isa<MemRefType>(result.getType())) {
+              worklist.push_back(result);
+            }
+          }
+        }
+      }
 
-      rewriter.startOpModification(alloc);
-      {
-        alloc.setAlignment(alignment);
-        alloc->setAttr("address", rewriter.getI64IntegerAttr(address));
-      };
-      rewriter.finalizeOpModification(alloc);
+      buffers.push_back(buffer);
     });
 
-    // Currently, this step always succeeds; out-of-memory condition will result
-    // in hard assert failure.
+    return buffers;
+  }
 
-    return success();
+  // A buffer may reside in DRAM if it is only read by streams, which move
+  // the data to L1 storage of their own, or only written by host transfers.
+  static bool canLiveInDRAM(OpOperand &use) {
+    Operation *user = use.getOwner();
+    if (auto stream = mlir::dyn_cast<ttir::StreamLayoutOp>(user)) {
+      return use.get() == stream.getInput() && use.get() != stream.getStorage();
+    }
+    if (auto toLayout = mlir::dyn_cast<ttir::ToLayoutOp>(user)) {
+      auto inputTy = mlir::dyn_cast<MemRefType>(toLayout.getInput().getType());
+      return use.get() == toLayout.getOutput() &&
+             toLayout->getNumResults() == 0 && inputTy &&
+             !isDeviceMemorySpace(getMemorySpace(inputTy, MemorySpace::System));
+    }
+    return false;
+  }
+
+  // Picks the largest spillable L1 buffer whose live range overlaps 'failed',
+  // which frees the most space at the point where allocation failed.
+  static LiveBuffer *pickSpillCandidate(MutableArrayRef<LiveBuffer> buffers,
+                                        const LiveBuffer &failed) {
+    LiveBuffer *victim = nullptr;
+    for (LiveBuffer &buffer : buffers) {
+      if (buffer.memorySpace != MemorySpace::DeviceL1 || !buffer.spillable ||
+          !buffer.overlaps(failed)) {
+        continue;
+      }
+      if (!victim || buffer.size > victim->size) {
+        victim = &buffer;
+      }
+    }
+    return victim;
+  }
+
+  static MemRefType getDRAMMemRefType(MemRefType memrefTy) {
+    return MemRefType::get(
+        memrefTy.getShape(), memrefTy.getElementType(), memrefTy.getLayout(),
+        MemorySpaceAttr::get(memrefTy.getContext(), MemorySpace::DeviceDRAM));
+  }
+
+  // Moves 'alloc' to DRAM, along with the streams reading from it. Generic
+  // region arguments bound to those streams keep their L1 memory space: they
+  // describe the L1 storage of the stream, not the spilled buffer, which is
+  // never bound to a region argument directly (see canLiveInDRAM).
+  static void spillBuffer(RewriterBase &rewriter, memref::AllocOp alloc) {
+    assert(llvm::all_of(alloc->getUses(), canLiveInDRAM) &&
+           "spilled buffer must only be accessed through streams");
+    rewriter.modifyOpInPlace(alloc, [&]() {
+      alloc.getResult().setType(getDRAMMemRefType(alloc.getType()));
+    });
+    for (Operation *user : alloc->getUsers()) {
+      if (auto stream = mlir::dyn_cast<ttir::StreamLayoutOp>(user)) {
+        Value result = stream.getResult();
+        rewriter.modifyOpInPlace(stream, [&]() {
+          result.setType(
+              getDRAMMemRefType(mlir::cast<MemRefType>(result.getType())));
+        });
+      }
+    }
   }
 
-  static SimpleAllocator createSimpleAllocator(ChipDescAttr chipDesc) {
-    SmallVector<SimpleAllocator::MemorySpaceInfo> memorySpaceInfo;
+  static SmallVector<MemorySpaceInfo>
+  getMemorySpaceInfo(ChipDescAttr chipDesc) {
+    SmallVector<MemorySpaceInfo> memorySpaceInfo;
     memorySpaceInfo.resize(getMaxEnumValForMemorySpace() + 1llu);
     memorySpaceInfo[llvm::to_underlying(MemorySpace::DeviceL1)] =
-        SimpleAllocator::MemorySpaceInfo(chipDesc.getL1UnreservedBase(),
-                                         chipDesc.getL1Size() -
-                                             chipDesc.getScratchL1RegionSize(),
-                                         chipDesc.getNocL1AddressAlignBytes());
+        MemorySpaceInfo(chipDesc.getL1UnreservedBase(),
+                        chipDesc.getL1Size() -
+                            chipDesc.getScratchL1RegionSize(),
+                        chipDesc.getNocL1AddressAlignBytes());
     memorySpaceInfo[llvm::to_underlying(MemorySpace::DeviceDRAM)] =
-        SimpleAllocator::MemorySpaceInfo(
-            chipDesc.getDramUnreservedBase(), chipDesc.getDramChannelSize(),
-            chipDesc.getNocDRAMAddressAlignBytes());
-    return SimpleAllocator(memorySpaceInfo);
+        MemorySpaceInfo(chipDesc.getDramUnreservedBase(),
+                        chipDesc.getDramChannelSize(),
+                        chipDesc.getNocDRAMAddressAlignBytes());
+    return memorySpaceInfo;
   }
 
 }; // end of class
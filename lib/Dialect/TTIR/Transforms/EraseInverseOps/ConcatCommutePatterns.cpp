@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TTIR/IR/TTIROps.h"
+#include "ttmlir/Dialect/TTIR/Transforms/EraseInverseOps/EraseInverseOps.h"
+#include "ttmlir/Dialect/TTIR/Utils/Utils.h"
+#include "ttmlir/Utils.h"
+
+namespace mlir::tt::ttir {
+
+namespace {
+int64_t getNormalizedConcatDim(ttir::ConcatOp op) {
+  int64_t dim = op.getDim();
+  return dim < 0 ? dim + op.getType().getRank() : dim;
+}
+} // namespace
+
+namespace {
+template <typename TMOpType>
+class TTIRCommutePermutesAboveConcat
+    : public TTIRCommuteOpRewritePattern<TMOpType, ttir::ConcatOp> {
+public:
+  using TTIRCommuteOpRewritePattern<
+      TMOpType, ttir::ConcatOp>::TTIRCommuteOpRewritePattern;
+
+  void performCommuteRewrite(ttir::ConcatOp op, TMOpType tmUser,
+                             PatternRewriter &rewriter) const override {
+    SmallVector<int64_t> permutation = *getTMPermutation(tmUser);
+    auto tmResultType = tmUser.getResult().getType();
+
+    // Every input is permuted the same way, so the concatenated dimension
+    // moves to wherever the permutation places it.
+    SmallVector<Value> newInputs;
+    for (Value input : op.getInputs()) {
+      auto inputType = cast<RankedTensorType>(input.getType());
+      SmallVector<int64_t> newShape =
+          ttmlir::utils::applyPermutation(inputType.getShape(), permutation);
+      newInputs.push_back(ttir::utils::createDPSOp<TMOpType>(
+          rewriter, op->getLoc(), newShape, inputType.getElementType(),
+          tmResultType.getEncoding(), input, tmUser->getAttrs()));
+    }
+
+    int32_t newDim = ttmlir::utils::inversePermutation(
+        permutation)[getNormalizedConcatDim(op)];
+    auto newConcat = ttir::utils::createDPSOp<ttir::ConcatOp>(
+        rewriter, op->getLoc(), tmResultType, newInputs, newDim);
+
+    SmallVector<Operation *> users(op->getUsers());
+    for (auto *user : users) {
+      assert(checkIdenticalTms(tmUser, user) &&
+             "shouldCommute should have ensured this is true");
+    }
+
+    for (auto *user : users) {
+      rewriter.replaceOp(user, newConcat);
+    }
+  }
+
+private:
+  bool isCommuteViable(ttir::ConcatOp op, TMOpType) const override {
+    // We can always commute a permutation above a concat.
+    return true;
+  }
+
+  bool isCommuteFavorable(ttir::ConcatOp op, TMOpType) const override {
+    // As for elementwise ops, we should commute if all users are an identical
+    // TM. Whether the TMs placed on the inputs cancel is left to the cost
+    // model of the pass.
+    SmallVector<Operation *> users(op->getUsers());
+    return !users.empty() && checkAllUsersAreIdenticalTms(users);
+  }
+};
+} // namespace
+
+namespace {
+template <typename TMOpType>
+class TTIRCommutePermutesBelowConcat
+    : public TTIRCommuteOpRewritePattern<TMOpType, ttir::ConcatOp,
+                                         CommuteDirection::DOWNWARDS> {
+public:
+  using TTIRCommuteOpRewritePattern<
+      TMOpType, ttir::ConcatOp,
+      CommuteDirection::DOWNWARDS>::TTIRCommuteOpRewritePattern;
+
+  void performCommuteRewrite(ttir::ConcatOp op, TMOpType tmOperand,
+                             PatternRewriter &rewriter) const override {
+    SmallVector<int64_t> permutation = *getTMPermutation(tmOperand);
+    auto oldConcatType = op.getType();
+
+    SmallVector<Value> newInputs;
+    for (Value input : op.getInputs()) {
+      newInputs.push_back(input.getDefiningOp<TMOpType>().getInput());
+    }
+
+    // The concat now runs before the permutation, so its result shape and
+    // dimension are the ones the permutation maps onto the old ones.
+    SmallVector<int64_t> newShape = ttmlir::utils::applyPermutation(
+        oldConcatType.getShape(),
+        ttmlir::utils::inversePermutation(permutation));
+    int32_t newDim = permutation[getNormalizedConcatDim(op)];
+    auto newConcat = ttir::utils::createDPSOp<ttir::ConcatOp>(
+        rewriter, op->getLoc(), newShape, oldConcatType.getElementType(),
+        oldConcatType.getEncoding(), newInputs, newDim);
+
+    auto newTM = ttir::utils::createDPSOp<TMOpType>(
+        rewriter, op->getLoc(), oldConcatType, newConcat,
+        tmOperand->getAttrs());
+
+    rewriter.replaceOp(op, newTM);
+  }
+
+private:
+  bool isCommuteViable(ttir::ConcatOp op, TMOpType) const override {
+    // We can always commute a permutation below a concat.
+    return true;
+  }
+
+  bool isCommuteFavorable(ttir::ConcatOp op,
+                          TMOpType tmOperand) const override {
+    // Commuting is favorable if all inputs come from an identical TM used
+    // only by the concat, as a single TM on the result then replaces them.
+    return llvm::all_of(op.getInputs(), [&](Value input) {
+      auto inputTM = input.getDefiningOp<TMOpType>();
+      return inputTM && checkIdenticalTms(tmOperand, inputTM) &&
+             llvm::all_of(inputTM->getUsers(), [&](Operation *user) {
+               return user == op.getOperation();
+             });
+    });
+  }
+};
+} // namespace
+
+template <CommuteDirection commuteDirection>
+void populateConcatCommutePatterns(MLIRContext *ctx,
+                                   RewritePatternSet &patterns) {
+  if constexpr (commuteDirection == CommuteDirection::UPWARDS) {
+    patterns.add<TTIRCommutePermutesAboveConcat<TransposeOp>,
+                 TTIRCommutePermutesAboveConcat<PermuteOp>>(ctx);
+  } else {
+    patterns.add<TTIRCommutePermutesBelowConcat<TransposeOp>,
+                 TTIRCommutePermutesBelowConcat<PermuteOp>>(ctx);
+  }
+}
+
+template void populateConcatCommutePatterns<CommuteDirection::UPWARDS>(
+    MLIRContext *ctx, RewritePatternSet &patterns);
+template void populateConcatCommutePatterns<CommuteDirection::DOWNWARDS>(
+    MLIRContext *ctx, RewritePatternSet &patterns);
+
+} // namespace mlir::tt::ttir
@@ -133,14 +133,110 @@ private:
 };
 } // namespace
 
+namespace {
+template <typename TMOpType, typename ElementwiseInterfaceType>
+class TTIRCommuteTmsBelowElementwiseRewriter
+    : public TTIRCommuteOpInterfaceRewritePattern<
+          TMOpType, ElementwiseInterfaceType, CommuteDirection::DOWNWARDS> {
+public:
+  using TTIRCommuteOpInterfaceRewritePattern<
+      TMOpType, ElementwiseInterfaceType,
+      CommuteDirection::DOWNWARDS>::TTIRCommuteOpInterfaceRewritePattern;
+
+  void performCommuteRewrite(ElementwiseInterfaceType op, TMOpType tmOperand,
+                             PatternRewriter &rewriter) const override {
+    auto oldEltwiseType = cast<RankedTensorType>(op->getResult(0).getType());
+    auto tmInputType = tmOperand.getInput().getType();
+
+    // The elementwise op is applied to the TM inputs, so it takes their shape
+    // and keeps its own element type in case it is a typecast.
+    auto newEltwiseType = RankedTensorType::get(tmInputType.getShape(),
+                                                oldEltwiseType.getElementType(),
+                                                tmInputType.getEncoding());
+
+    SmallVector<Value> newEltwiseOperands;
+    for (uint32_t operandIdx = 0; operandIdx < op->getNumOperands() - 1;
+         operandIdx++) {
+      auto operandTM = op->getOperand(operandIdx).getDefiningOp<TMOpType>();
+      assert(operandTM && checkIdenticalTms(tmOperand, operandTM) &&
+             "shouldCommute should have ensured this is true");
+      newEltwiseOperands.push_back(operandTM.getInput());
+    }
+
+    newEltwiseOperands.push_back(rewriter.create<ttir::EmptyOp>(
+        op->getLoc(), newEltwiseType.getShape(),
+        newEltwiseType.getElementType(), newEltwiseType.getEncoding()));
+
+    Operation *newEltwise = rewriter.create(
+        op->getLoc(), rewriter.getStringAttr(op->getName().getStringRef()),
+        newEltwiseOperands, newEltwiseType, op->getAttrs());
+
+    auto newTM = ttir::utils::createDPSOp<TMOpType>(
+        rewriter, op->getLoc(), oldEltwiseType, newEltwise->getResult(0),
+        tmOperand->getAttrs());
+
+    rewriter.replaceOp(op, newTM);
+  }
+
+private:
+  bool isCommuteViable(ElementwiseInterfaceType op,
+                       TMOpType tmOperand) const override {
+    // We can always commute a TM below an elementwise op.
+    return true;
+  }
+
+  bool isCommuteFavorable(ElementwiseInterfaceType op,
+                          TMOpType tmOperand) const override {
+    // Commuting below is only favorable if it moves the TMs rather than copies
+    // them. That is every input must come from an identical TM with the same
+    // input type, so that no implicit broadcast is involved and one TM on the
+    // result replaces all of them, and the op must be the only user of those
+    // TMs.
+    auto tmInputType = tmOperand.getInput().getType();
+    for (uint32_t operandIdx = 0; operandIdx < op->getNumOperands() - 1;
+         operandIdx++) {
+      auto operandTM = op->getOperand(operandIdx).getDefiningOp<TMOpType>();
+      if (!operandTM || !checkIdenticalTms(tmOperand, operandTM) ||
+          operandTM.getInput().getType() != tmInputType) {
+        return false;
+      }
+
+      if (!llvm::all_of(operandTM->getUsers(), [&](Operation *user) {
+            return user == op.getOperation();
+          })) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+} // namespace
+
+template <CommuteDirection commuteDirection>
 void populateElementwiseCommutePatterns(MLIRContext *ctx,
                                         RewritePatternSet &patterns) {
-  patterns.add<TTIRCommuteTmsAboveElementwiseUnaryRewriter<TransposeOp>,
-               TTIRCommuteTmsAboveElementwiseUnaryRewriter<PermuteOp>,
-               TTIRCommuteTmsAboveElementwiseUnaryRewriter<ReshapeOp>,
-               TTIRCommuteTmsAboveElementwiseBinaryRewriter<TransposeOp>,
-               TTIRCommuteTmsAboveElementwiseBinaryRewriter<PermuteOp>,
-               TTIRCommuteTmsAboveElementwiseBinaryRewriter<ReshapeOp>>(ctx);
+  if constexpr (commuteDirection == CommuteDirection::UPWARDS) {
+    patterns.add<TTIRCommuteTmsAboveElementwiseUnaryRewriter<TransposeOp>,
+                 TTIRCommuteTmsAboveElementwiseUnaryRewriter<PermuteOp>,
+                 TTIRCommuteTmsAboveElementwiseUnaryRewriter<ReshapeOp>,
+                 TTIRCommuteTmsAboveElementwiseBinaryRewriter<TransposeOp>,
+                 TTIRCommuteTmsAboveElementwiseBinaryRewriter<PermuteOp>,
+                 TTIRCommuteTmsAboveElementwiseBinaryRewriter<ReshapeOp>>(ctx);
+  } else {
+    patterns.add<
+        TTIRCommuteTmsBelowElementwiseRewriter<TransposeOp, ElementwiseUnary>,
+        TTIRCommuteTmsBelowElementwiseRewriter<PermuteOp, ElementwiseUnary>,
+        TTIRCommuteTmsBelowElementwiseRewriter<ReshapeOp, ElementwiseUnary>,
+        TTIRCommuteTmsBelowElementwiseRewriter<TransposeOp, ElementwiseBinary>,
+        TTIRCommuteTmsBelowElementwiseRewriter<PermuteOp, ElementwiseBinary>,
+        TTIRCommuteTmsBelowElementwiseRewriter<ReshapeOp, ElementwiseBinary>>(
+        ctx);
+  }
 }
 
+template void populateElementwiseCommutePatterns<CommuteDirection::UPWARDS>(
+    MLIRContext *ctx, RewritePatternSet &patterns);
+template void populateElementwiseCommutePatterns<CommuteDirection::DOWNWARDS>(
+    MLIRContext *ctx, RewritePatternSet &patterns);
+
 } // namespace mlir::tt::ttir
@@ -5,32 +5,201 @@
 #include "ttmlir/Dialect/TTIR/Transforms/EraseInverseOps/EraseInverseOps.h"
 
 #include "ttmlir/Dialect/TT/IR/TT.h"
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h"
 
 #include "mlir/IR/OperationSupport.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/Rewrite/FrozenRewritePatternSet.h"
 #include "mlir/Support/LLVM.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
+
+#include <tuple>
 
 namespace mlir::tt::ttir {
 #define GEN_PASS_DEF_TTIRERASEINVERSEOPS
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h.inc"
 
+namespace {
+// Number and total size of the TMs of a function that run on device. TMs are
+// compared by size first, as that is what their data movement costs.
+struct TMCost {
+  int64_t bytes = 0;
+  int64_t count = 0;
+
+  bool operator<(const TMCost &other) const {
+    return std::tie(bytes, count) < std::tie(other.bytes, other.count);
+  }
+};
+
+// Returns true if `value` is known before the program runs, so that TMs on it
+// are hoisted out of the program by const-eval. Like the upward commute
+// patterns, this assumes that every function argument which is not marked as
+// a runtime input is a weight.
+bool isConstEvaluable(Value value) {
+  if (auto blockArg = dyn_cast<BlockArgument>(value)) {
+    auto funcOp = dyn_cast<func::FuncOp>(blockArg.getOwner()->getParentOp());
+    if (!funcOp) {
+      return false;
+    }
+
+    auto typeAttr = funcOp.getArgAttrOfType<ArgumentTypeAttr>(
+        blockArg.getArgNumber(), ArgumentTypeAttr::name);
+    return !typeAttr || typeAttr.getValue() != ArgumentType::Input;
+  }
+
+  Operation *op = value.getDefiningOp();
+  if (op->hasTrait<OpTrait::ConstantLike>()) {
+    return true;
+  }
+
+  if (isa<TransposeOp, PermuteOp, ReshapeOp, BroadcastOp>(op)) {
+    return isConstEvaluable(op->getOperand(0));
+  }
+
+  return false;
+}
+
+TMCost getTMCost(func::FuncOp funcOp) {
+  TMCost cost;
+  funcOp.walk([&](Operation *op) {
+    if (!isa<TransposeOp, PermuteOp, ReshapeOp>(op) ||
+        isConstEvaluable(op->getOperand(0))) {
+      return;
+    }
+
+    auto resultType = cast<RankedTensorType>(op->getResult(0).getType());
+    Type elementType = resultType.getElementType();
+    if (auto quantType = dyn_cast<quant::QuantizedType>(elementType)) {
+      elementType = quantType.getStorageType();
+    }
+    cost.bytes +=
+        resultType.getNumElements() * getElementSizeBytes(elementType);
+    cost.count++;
+  });
+  return cost;
+}
+} // namespace
+
 class TTIREraseInverseOps
     : public impl::TTIREraseInverseOpsBase<TTIREraseInverseOps> {
 public:
   using impl::TTIREraseInverseOpsBase<
       TTIREraseInverseOps>::TTIREraseInverseOpsBase;
+
+  LogicalResult initialize(MLIRContext *context) final {
+    // The original behaviour: elementwise and broadcast ops, upwards only.
+    RewritePatternSet legacyPatterns(context);
+    populateElementwiseCommutePatterns<CommuteDirection::UPWARDS>(
+        context, legacyPatterns);
+    populateBroadcastCommutePatterns(context, legacyPatterns);
+    legacyCommutePatterns = std::move(legacyPatterns);
+
+    // TMs that reach a matmul or linear operand are folded into its transpose
+    // flags by the canonicalization patterns of those ops.
+    RewritePatternSet abovePatterns(context);
+    populateElementwiseCommutePatterns<CommuteDirection::UPWARDS>(
+        context, abovePatterns);
+    populateBroadcastCommutePatterns(context, abovePatterns);
+    populateConcatCommutePatterns<CommuteDirection::UPWARDS>(context,
+                                                             abovePatterns);
+    populateReductionCommutePatterns<CommuteDirection::UPWARDS>(
+        context, abovePatterns);
+    MatmulOp::getCanonicalizationPatterns(abovePatterns, context);
+    LinearOp::getCanonicalizationPatterns(abovePatterns, context);
+    commuteAbovePatterns = std::move(abovePatterns);
+
+    RewritePatternSet belowPatterns(context);
+    populateElementwiseCommutePatterns<CommuteDirection::DOWNWARDS>(
+        context, belowPatterns);
+    populateConcatCommutePatterns<CommuteDirection::DOWNWARDS>(context,
+                                                               belowPatterns);
+    populateReductionCommutePatterns<CommuteDirection::DOWNWARDS>(
+        context, belowPatterns);
+    MatmulOp::getCanonicalizationPatterns(belowPatterns, context);
+    LinearOp::getCanonicalizationPatterns(belowPatterns, context);
+    commuteBelowPatterns = std::move(belowPatterns);
+
+    return success();
+  }
+
   void runOnOperation() final {
-    RewritePatternSet commutePatterns(&getContext());
-    populateElementwiseCommutePatterns(&getContext(), commutePatterns);
-    populateBroadcastCommutePatterns(&getContext(), commutePatterns);
+    func::FuncOp funcOp = getOperation();
+    if (funcOp.isDeclaration()) {
+      return;
+    }
+
+    // Whether a TM cancels depends on the whole graph rather than on the op
+    // it is commuted through, so each strategy is applied to a copy of the
+    // function and the one that leaves the least TM data movement wins. Ties
+    // go to the earlier strategy, so the original upward commuting is kept
+    // unless another strategy does strictly better. Strategies that do not
+    // converge are discarded.
+    SmallVector<SmallVector<const FrozenRewritePatternSet *>> strategies = {
+        {&legacyCommutePatterns},
+        {},
+        {&commuteAbovePatterns},
+        {&commuteBelowPatterns},
+        {&commuteAbovePatterns, &commuteBelowPatterns}};
+
+    TMCost initialCost = getTMCost(funcOp);
+    SmallVector<func::FuncOp> candidates;
+    std::optional<size_t> bestCandidate;
+    TMCost bestCost;
+    bool baselineConverged = true;
+    for (const auto &[index, strategy] : llvm::enumerate(strategies)) {
+      func::FuncOp candidate = funcOp.clone();
+      candidates.push_back(candidate);
+      bool converged = llvm::all_of(
+          strategy, [&](const FrozenRewritePatternSet *patterns) {
+            return succeeded(applyPatternsGreedily(candidate, *patterns));
+          });
+      if (!converged) {
+        // The first strategy is the baseline.
+        if (index == 0) {
+          baselineConverged = false;
+        }
+        continue;
+      }
 
-    if (failed(applyPatternsGreedily(getOperation(),
-                                     std::move(commutePatterns)))) {
-      signalPassFailure();
+      TMCost cost = getTMCost(candidate);
+      if (!bestCandidate || cost < bestCost) {
+        bestCandidate = index;
+        bestCost = cost;
+      }
+    }
+
+    if (baselineConverged) {
+      funcOp.getBody().takeBody(candidates[*bestCandidate].getBody());
+    }
+
+    for (func::FuncOp candidate : candidates) {
+      candidate.erase();
+    }
+
+    // Only the baseline not converging is an error, as it was before the
+    // other strategies were added. Apply it to the function itself so that
+    // the failure is reported on the same IR as before.
+    if (!baselineConverged) {
+      if (failed(applyPatternsGreedily(funcOp, legacyCommutePatterns))) {
+        signalPassFailure();
+      }
       return;
     }
+
+    if (reportRemovedTms) {
+      funcOp.emitRemark() << "Erased TMs: "
+                          << initialCost.count - bestCost.count << " ops, "
+                          << initialCost.bytes - bestCost.bytes
+                          << " bytes removed, " << bestCost.count << " ops, "
+                          << bestCost.bytes << " bytes left";
+    }
   }
+
+private:
+  FrozenRewritePatternSet legacyCommutePatterns;
+  FrozenRewritePatternSet commuteAbovePatterns;
+  FrozenRewritePatternSet commuteBelowPatterns;
 };
 } // namespace mlir::tt::ttir
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TTIR/IR/TTIROps.h"
+#include "ttmlir/Dialect/TTIR/Transforms/EraseInverseOps/EraseInverseOps.h"
+#include "ttmlir/Dialect/TTIR/Utils/Utils.h"
+#include "ttmlir/Utils.h"
+
+namespace mlir::tt::ttir {
+
+namespace {
+// Maps the reduced dimensions of `op` through `dimMapping` and returns them as
+// a sorted dim_arg attribute. Reductions over all dimensions have no dim_arg
+// and keep it that way.
+template <typename ReductionOpType>
+ArrayAttr remapReductionDims(ReductionOpType op,
+                             ArrayRef<int64_t> dimMapping,
+                             PatternRewriter &rewriter) {
+  if (!op.getDimArg()) {
+    return nullptr;
+  }
+
+  int64_t rank = op.getInput().getType().getRank();
+  SmallVector<int32_t> newDims;
+  for (Attribute dimAttr : *op.getDimArg()) {
+    int64_t dim = mlir::cast<IntegerAttr>(dimAttr).getInt();
+    newDims.push_back(dimMapping[dim < 0 ? dim + rank : dim]);
+  }
+  llvm::sort(newDims);
+  return rewriter.getI32ArrayAttr(newDims);
+}
+} // namespace
+
+// Permutations commute with reductions that keep the reduced dimensions, as
+// the rank, and so the meaning of the permutation, stays the same. Reductions
+// that drop dimensions are not handled yet.
+namespace {
+template <typename TMOpType, typename ReductionOpType>
+class TTIRCommutePermutesAboveReduction
+    : public TTIRCommuteOpRewritePattern<TMOpType, ReductionOpType> {
+public:
+  using TTIRCommuteOpRewritePattern<
+      TMOpType, ReductionOpType>::TTIRCommuteOpRewritePattern;
+
+  void performCommuteRewrite(ReductionOpType op, TMOpType tmUser,
+                             PatternRewriter &rewriter) const override {
+    SmallVector<int64_t> permutation = *getTMPermutation(tmUser);
+    auto inputType = op.getInput().getType();
+    auto tmResultType = tmUser.getResult().getType();
+
+    SmallVector<int64_t> newShape =
+        ttmlir::utils::applyPermutation(inputType.getShape(), permutation);
+    auto newTM = ttir::utils::createDPSOp<TMOpType>(
+        rewriter, op->getLoc(), newShape, inputType.getElementType(),
+        tmResultType.getEncoding(), op.getInput(), tmUser->getAttrs());
+
+    // Reduced dimension `d` of the input is dimension `inverse[d]` of the
+    // permuted input.
+    auto newReduction = ttir::utils::createDPSOp<ReductionOpType>(
+        rewriter, op->getLoc(), tmResultType, newTM.getResult(),
+        op.getKeepDimAttr(),
+        remapReductionDims(
+            op, ttmlir::utils::inversePermutation(permutation), rewriter));
+
+    SmallVector<Operation *> users(op->getUsers());
+    for (auto *user : users) {
+      assert(checkIdenticalTms(tmUser, user) &&
+             "shouldCommute should have ensured this is true");
+    }
+
+    for (auto *user : users) {
+      rewriter.replaceOp(user, newReduction);
+    }
+  }
+
+private:
+  bool isCommuteViable(ReductionOpType op, TMOpType) const override {
+    return op.getKeepDim();
+  }
+
+  bool isCommuteFavorable(ReductionOpType op, TMOpType) const override {
+    // The reduced result is smaller than its input, so this moves the TM onto
+    // a larger tensor. It is only worth it when the TM cancels above, which
+    // is left to the cost model of the pass.
+    SmallVector<Operation *> users(op->getUsers());
+    return !users.empty() && checkAllUsersAreIdenticalTms(users);
+  }
+};
+} // namespace
+
+namespace {
+template <typename TMOpType, typename ReductionOpType>
+class TTIRCommutePermutesBelowReduction
+    : public TTIRCommuteOpRewritePattern<TMOpType, ReductionOpType,
+                                         CommuteDirection::DOWNWARDS> {
+public:
+  using TTIRCommuteOpRewritePattern<
+      TMOpType, ReductionOpType,
+      CommuteDirection::DOWNWARDS>::TTIRCommuteOpRewritePattern;
+
+  void performCommuteRewrite(ReductionOpType op, TMOpType tmOperand,
+                             PatternRewriter &rewriter) const override {
+    SmallVector<int64_t> permutation = *getTMPermutation(tmOperand);
+    auto oldResultType = op.getType();
+
+    // Reduced dimension `d` of the permuted input is dimension
+    // `permutation[d]` of the TM input.
+    SmallVector<int64_t> newShape = ttmlir::utils::applyPermutation(
+        oldResultType.getShape(),
+        ttmlir::utils::inversePermutation(permutation));
+    auto newReduction = ttir::utils::createDPSOp<ReductionOpType>(
+        rewriter, op->getLoc(), newShape, oldResultType.getElementType(),
+        oldResultType.getEncoding(), tmOperand.getInput(),
+        op.getKeepDimAttr(), remapReductionDims(op, permutation, rewriter));
+
+    auto newTM = ttir::utils::createDPSOp<TMOpType>(
+        rewriter, op->getLoc(), oldResultType, newReduction.getResult(),
+        tmOperand->getAttrs());
+
+    rewriter.replaceOp(op, newTM);
+  }
+
+private:
+  bool isCommuteViable(ReductionOpType op, TMOpType) const override {
+    return op.getKeepDim();
+  }
+
+  bool isCommuteFavorable(ReductionOpType op,
+                          TMOpType tmOperand) const override {
+    // The TM is moved onto the smaller, reduced tensor, which is always
+    // favorable as long as the reduction is its only user.
+    return tmOperand->hasOneUse();
+  }
+};
+} // namespace
+
+template <CommuteDirection commuteDirection>
+void populateReductionCommutePatterns(MLIRContext *ctx,
+                                      RewritePatternSet &patterns) {
+  if constexpr (commuteDirection == CommuteDirection::UPWARDS) {
+    patterns.add<TTIRCommutePermutesAboveReduction<TransposeOp, SumOp>,
+                 TTIRCommutePermutesAboveReduction<PermuteOp, SumOp>,
+                 TTIRCommutePermutesAboveReduction<TransposeOp, MeanOp>,
+                 TTIRCommutePermutesAboveReduction<PermuteOp, MeanOp>,
+                 TTIRCommutePermutesAboveReduction<TransposeOp, MaxOp>,
+                 TTIRCommutePermutesAboveReduction<PermuteOp, MaxOp>,
+                 TTIRCommutePermutesAboveReduction<TransposeOp, MinOp>,
+                 TTIRCommutePermutesAboveReduction<PermuteOp, MinOp>,
+                 TTIRCommutePermutesAboveReduction<TransposeOp, ProdOp>,
+                 TTIRCommutePermutesAboveReduction<PermuteOp, ProdOp>>(ctx);
+  } else {
+    patterns.add<TTIRCommutePermutesBelowReduction<TransposeOp, SumOp>,
+                 TTIRCommutePermutesBelowReduction<PermuteOp, SumOp>,
+                 TTIRCommutePermutesBelowReduction<TransposeOp, MeanOp>,
+                 TTIRCommutePermutesBelowReduction<PermuteOp, MeanOp>,
+                 TTIRCommutePermutesBelowReduction<TransposeOp, MaxOp>,
+                 TTIRCommutePermutesBelowReduction<PermuteOp, MaxOp>,
+                 TTIRCommutePermutesBelowReduction<TransposeOp, MinOp>,
+                 TTIRCommutePermutesBelowReduction<PermuteOp, MinOp>,
+                 TTIRCommutePermutesBelowReduction<TransposeOp, ProdOp>,
+                 TTIRCommutePermutesBelowReduction<PermuteOp, ProdOp>>(ctx);
+  }
+}
+
+template void populateReductionCommutePatterns<CommuteDirection::UPWARDS>(
+    MLIRContext *ctx, RewritePatternSet &patterns);
+template void populateReductionCommutePatterns<CommuteDirection::DOWNWARDS>(
+    MLIRContext *ctx, RewritePatternSet &patterns);
+
+} // namespace mlir::tt::ttir
@@ -4,6 +4,8 @@
 
 #include "ttmlir/Dialect/TT/IR/TT.h"
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h"
+#include "ttmlir/Dialect/TTIR/Utils/CostModel.h"
+#include "ttmlir/Utils.h"
 
 #include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
@@ -138,6 +140,8 @@ public:
   // One implementation of mcast by which one core (the 0th core for the
   // respective dim) takes on the role of (the sender) gathering and sending the
   // data to all other cores (the receivers) via mcast along the same dimension.
+  // The gather only writes to the sender's own buffer, so it is left in flight
+  // while the sender waits for the receivers to be ready.
   static void createGatherMcastDMA(PatternRewriter &builder, Location loc,
                                    Value src, Value dst,
                                    AffineMap operandIndexingMap, GridAttr grid,
@@ -163,9 +167,9 @@ public:
         [&](OpBuilder &builder, Location loc) {
           Value gatherMemTx =
               createDMA(builder, loc, src, dst, operandIndexingMap);
-          builder.create<ttir::DMAWaitOp>(loc, gatherMemTx);
           builder.create<ttir::SemaphoreWaitOp>(loc, receiversReadySemaphore,
                                                 mcastVolumeMinusOne, zero);
+          builder.create<ttir::DMAWaitOp>(loc, gatherMemTx);
           Value mcastMemTx = createDMA(builder, loc, dst, dst, std::nullopt,
                                        coreIndex, mcastShape);
           builder.create<ttir::DMAWaitOp>(loc, mcastMemTx);
@@ -319,8 +323,74 @@ public:
     patterns.add<TTIRGenericGenerateDatamovementRewriter>(&getContext());
     if (failed(applyPatternsGreedily(getOperation(), std::move(patterns)))) {
       signalPassFailure();
+      return;
+    }
+
+    if (reportOverlap) {
+      getOperation()->walk([](GenericOp generic) { reportCycles(generic); });
     }
   }
+
+private:
+  // Estimates the cycles a core spends on the blocks of `generic`, with every
+  // block fetched and then computed in turn, and with the fetch of a block
+  // overlapping compute on the previous one, which needs more than one buffer
+  // per stream.
+  static void reportCycles(GenericOp generic) {
+    Block &block = generic.getRegion(0).front();
+    int64_t dmaCycles = 0;
+    int64_t maxTiles = 0;
+    std::optional<uint32_t> numBuffers;
+    for (OpOperand &operand : generic->getOpOperands()) {
+      auto blockType = mlir::cast<MemRefType>(
+          block.getArgument(operand.getOperandNumber()).getType());
+      Type elementType = blockType.getElementType();
+      int64_t blockBytes =
+          blockType.getNumElements() * getElementSizeBytes(elementType);
+      int64_t tileBytes = mlir::isa<TileType>(elementType)
+                              ? getElementSizeBytes(elementType)
+                              : TileType::get(elementType).getSizeBytes();
+      int64_t blockTiles = llvm::divideCeil(blockBytes, tileBytes);
+      maxTiles = std::max(maxTiles, blockTiles);
+
+      if (!TTIRGenericGenerateDatamovementRewriter::isStream(
+              operand.get().getType())) {
+        continue;
+      }
+
+      dmaCycles += cost::kDMASetupCycles + blockBytes / cost::kNocBytesPerCycle;
+      uint32_t operandBuffers = 1;
+      if (auto stream = operand.get().getDefiningOp<StreamLayoutOp>()) {
+        auto storageType =
+            mlir::cast<MemRefType>(stream.getStorage().getType());
+        if (auto storageLayout =
+                mlir::dyn_cast<ShardLayoutAttr>(storageType.getLayout())) {
+          operandBuffers = storageLayout.getBuffers();
+        }
+      }
+      numBuffers = std::min(numBuffers.value_or(operandBuffers),
+                            operandBuffers);
+    }
+
+    if (!numBuffers) {
+      return;
+    }
+
+    int64_t numBlocks = ttmlir::utils::volume<int64_t>(generic.getLoopBounds());
+    int64_t computeCycles = maxTiles * cost::kComputeCyclesPerTile;
+    int64_t serialCycles = numBlocks * (dmaCycles + computeCycles);
+    int64_t pipelinedCycles =
+        *numBuffers > 1 ? dmaCycles + computeCycles +
+                              (numBlocks - 1) *
+                                  std::max(dmaCycles, computeCycles)
+                        : serialCycles;
+    generic.emitRemark() << "Estimated cycles: " << numBlocks << " blocks, "
+                         << dmaCycles << " DMA and " << computeCycles
+                         << " compute cycles per block, " << serialCycles
+                         << " serial, " << pipelinedCycles
+                         << " pipelined at stream buffer depth "
+                         << *numBuffers;
+  }
 };
 } // namespace
 
@@ -3,7 +3,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "ttmlir/Dialect/TT/IR/TT.h"
+#include "ttmlir/Dialect/TT/IR/Utils.h"
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h"
+#include "ttmlir/Dialect/TTIR/Utils/CostModel.h"
+#include "ttmlir/Utils.h"
 
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/IR/Iterators.h"
@@ -11,73 +14,273 @@
 #include "mlir/Transforms/DialectConversion.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 
+#include <functional>
+#include <limits>
+#include <optional>
+#include <tuple>
+
 namespace mlir::tt::ttir {
 #define GEN_PASS_DEF_TTIROPTIMIZETENSORLAYOUT
 #include "ttmlir/Dialect/TTIR/Transforms/Passes.h.inc"
 
-static GridAttr getOptimalGrid(PatternRewriter &rewriter,
-                               ArrayRef<int64_t> memrefShape,
-                               ArrayRef<int64_t> deviceGridShape) {
-  std::vector<int64_t> gridShape;
-  for (size_t i = 0; i < memrefShape.size(); i++) {
-    int64_t dim = memrefShape[i];
-    for (size_t grid = deviceGridShape[i]; grid > 0; grid--) {
-      if (dim % grid == 0) {
-        gridShape.push_back(grid);
-        break;
-      }
+namespace {
+struct BlockingConstraints {
+  SmallVector<int64_t> workerGridShape;
+  int64_t usableL1Size;
+  uint32_t numStreamBuffers;
+  bool allowPaddedShards;
+};
+
+// The number of ways each loop dimension of a generic op is split. Loop
+// dimensions indexing the output are split across cores, the others into
+// blocks that every core streams in turn.
+struct Blocking {
+  SmallVector<int64_t> factors;
+  int64_t cycles = 0;
+  int64_t l1Bytes = 0;
+  int64_t paddedBytes = 0;
+  int64_t numCores = 0;
+  bool fitsInL1 = true;
+
+  // Blockings that fit in L1 come first, then the fastest ones. Ties go to
+  // the one that pads the least and then to the one using fewer cores.
+  bool operator<(const Blocking &other) const {
+    return std::make_tuple(!fitsInL1, cycles, paddedBytes, numCores) <
+           std::make_tuple(!other.fitsInL1, other.cycles, other.paddedBytes,
+                           other.numCores);
+  }
+};
+
+struct OperandShape {
+  AffineMap indexingMap;
+  // Memref shape of the operand on a single core, i.e. without any padding.
+  SmallVector<int64_t> shape;
+  int64_t elementBytes;
+  int64_t tileBytes;
+  bool isInput;
+};
+} // namespace
+
+static MetalLayoutAttr getMetalLayout(Value tensor) {
+  auto encoding = mlir::cast_if_present<MetalLayoutAttr>(
+      mlir::cast<RankedTensorType>(tensor.getType()).getEncoding());
+  assert(encoding && "Tensor type must have a MetalLayoutAttr encoding");
+  assert(encoding.getGrid().getShape().size() ==
+             encoding.getMemref().getShape().size() &&
+         "Grid rank must match memref rank.");
+  return encoding;
+}
+
+static SmallVector<OperandShape> getOperandShapes(GenericOp op) {
+  SmallVector<OperandShape> operandShapes;
+  SmallVector<AffineMap> indexingMaps = op.getIndexingMapsValue();
+  for (OpOperand &operand : op->getOpOperands()) {
+    auto tensorType = mlir::cast<RankedTensorType>(operand.get().getType());
+    MetalLayoutAttr layout = getMetalLayout(operand.get());
+    auto unpaddedGrid =
+        GridAttr::get(op.getContext(), layout.getGrid().getShape().size());
+    MemRefType memref =
+        layout.withGrid(op.getContext(), tensorType, unpaddedGrid).getMemref();
+    Type elementType = memref.getElementType();
+    int64_t elementBytes = getElementSizeBytes(elementType);
+    int64_t tileBytes = mlir::isa<TileType>(elementType)
+                            ? elementBytes
+                            : TileType::get(elementType).getSizeBytes();
+    operandShapes.push_back({indexingMaps[operand.getOperandNumber()],
+                             llvm::to_vector(memref.getShape()), elementBytes,
+                             tileBytes, op.isDpsInput(&operand)});
+  }
+  return operandShapes;
+}
+
+// Returns the grid `operandShape` is sharded on under `factors`. Dimensions
+// not indexed by a loop dimension are not split.
+static SmallVector<int64_t>
+getOperandGridShape(const OperandShape &operandShape,
+                    ArrayRef<int64_t> factors) {
+  SmallVector<int64_t> gridShape;
+  for (AffineExpr expr : operandShape.indexingMap.getResults()) {
+    auto dimExpr = mlir::dyn_cast<AffineDimExpr>(expr);
+    gridShape.push_back(dimExpr ? factors[dimExpr.getPosition()] : 1);
+  }
+  return gridShape;
+}
+
+static Blocking evaluateBlocking(ArrayRef<OperandShape> operandShapes,
+                                 ArrayRef<int64_t> extents,
+                                 ArrayRef<bool> isCoreDim,
+                                 ArrayRef<int64_t> factors,
+                                 const BlockingConstraints &constraints) {
+  Blocking blocking;
+  blocking.factors = llvm::to_vector(factors);
+
+  // Compute on a block visits every point of its iteration space once, e.g.
+  // m * n * k tile products for a matmul.
+  int64_t numBlocks = 1;
+  int64_t blockIterations = 1;
+  blocking.numCores = 1;
+  for (auto [extent, factor, isCore] :
+       llvm::zip(extents, factors, isCoreDim)) {
+    (isCore ? blocking.numCores : numBlocks) *= factor;
+    blockIterations *= llvm::divideCeil(extent, factor);
+  }
+  int64_t numBuffers = numBlocks > 1 ? constraints.numStreamBuffers : 1;
+
+  int64_t dmaCycles = 0;
+  int64_t computeTiles = 0;
+  for (const OperandShape &operandShape : operandShapes) {
+    SmallVector<int64_t> gridShape = getOperandGridShape(operandShape, factors);
+    int64_t blockElements = 1;
+    int64_t elements = 1;
+    for (auto [dim, grid] : llvm::zip(operandShape.shape, gridShape)) {
+      blockElements *= llvm::divideCeil(dim, grid);
+      elements *= dim;
+    }
+    int64_t blockBytes = blockElements * operandShape.elementBytes;
+    if (!operandShape.isInput) {
+      computeTiles = llvm::divideCeil(
+          blockIterations * operandShape.elementBytes, operandShape.tileBytes);
+    }
+    blocking.paddedBytes +=
+        (blockElements * ttmlir::utils::volume<int64_t>(gridShape) -
+         elements) *
+        operandShape.elementBytes;
+
+    // Every core holds a shard of each operand, and inputs are additionally
+    // streamed into circular buffers one block at a time.
+    blocking.l1Bytes += blockBytes;
+    if (operandShape.isInput) {
+      blocking.l1Bytes += blockBytes * numBuffers;
+      dmaCycles += cost::kDMASetupCycles + blockBytes / cost::kNocBytesPerCycle;
     }
   }
-  return rewriter.getAttr<GridAttr>(gridShape);
+
+  // With more than one buffer per stream, fetching a block overlaps compute
+  // on the previous one.
+  int64_t computeCycles = computeTiles * cost::kComputeCyclesPerTile;
+  blocking.cycles =
+      numBuffers > 1
+          ? dmaCycles + computeCycles +
+                (numBlocks - 1) * std::max(dmaCycles, computeCycles)
+          : numBlocks * (dmaCycles + computeCycles);
+  blocking.fitsInL1 = blocking.l1Bytes <= constraints.usableL1Size;
+  return blocking;
 }
 
-static RankedTensorType calculateOptimalLayoutForTensorType(
-    PatternRewriter &rewriter, Value tensor,
-    const SmallVector<int64_t> &workerGridShape) {
-  RankedTensorType resultType = mlir::cast<RankedTensorType>(tensor.getType());
-  auto resultEncoding =
-      mlir::cast_if_present<MetalLayoutAttr>(resultType.getEncoding());
-  assert(resultEncoding && "Tensor type must have a MetalLayoutAttr encoding");
-  assert(resultEncoding.getGrid().getShape().size() ==
-             resultEncoding.getMemref().getShape().size() &&
-         "Grid rank must match memref rank.");
+// Returns the ways a loop dimension of `extent` can be split at most
+// `maxFactor` times. Without padding only divisors are considered. With
+// padding, only the smallest factor giving each shard size is kept, as larger
+// ones pad more for the same amount of work per core.
+static SmallVector<int64_t> getCandidateFactors(int64_t extent,
+                                                int64_t maxFactor,
+                                                bool allowPaddedShards) {
+  SmallVector<int64_t> factors;
+  int64_t lastShardSize = 0;
+  for (int64_t factor = 1; factor <= std::min(extent, maxFactor); ++factor) {
+    int64_t shardSize = llvm::divideCeil(extent, factor);
+    if (allowPaddedShards ? shardSize != lastShardSize : extent % factor == 0) {
+      factors.push_back(factor);
+    }
+    lastShardSize = shardSize;
+  }
+  return factors;
+}
 
-  SmallVector<int64_t> canonicalShape;
-  canonicalShape.reserve(resultEncoding.getMemref().getShape().size());
+// Searches the splits of every loop dimension of `op` together for the one
+// that the cost model estimates to run fastest within L1. The grid size is
+// bounded by the worker grid, for both the cores an output dimension is split
+// across and the cores the blocks of other dimensions are sharded on.
+static Blocking findBlocking(GenericOp op,
+                             const BlockingConstraints &constraints) {
+  SmallVector<OperandShape> operandShapes = getOperandShapes(op);
+  unsigned numDims = op.getIndexingMapsValue().front().getNumDims();
+  ArrayRef<int64_t> workerGridShape = constraints.workerGridShape;
 
-  for (size_t i = 0; i < resultEncoding.getMemref().getShape().size(); i++) {
-    canonicalShape.push_back(resultEncoding.getMemref().getShape()[i] *
-                             resultEncoding.getGrid().getShape()[i]);
+  SmallVector<int64_t> extents(numDims, 1);
+  SmallVector<int64_t> maxFactors(numDims, std::numeric_limits<int64_t>::max());
+  SmallVector<bool> isCoreDim(numDims, false);
+  for (const OperandShape &operandShape : operandShapes) {
+    for (auto [i, expr] :
+         llvm::enumerate(operandShape.indexingMap.getResults())) {
+      auto dimExpr = mlir::dyn_cast<AffineDimExpr>(expr);
+      if (!dimExpr) {
+        continue;
+      }
+      unsigned dim = dimExpr.getPosition();
+      extents[dim] = std::max(extents[dim], operandShape.shape[i]);
+      maxFactors[dim] = std::min(
+          maxFactors[dim], i < workerGridShape.size() ? workerGridShape[i] : 1);
+      isCoreDim[dim] = isCoreDim[dim] || !operandShape.isInput;
+    }
   }
 
-  auto optimalOutputGrid =
-      getOptimalGrid(rewriter, canonicalShape, workerGridShape);
-  auto newResultEncoding = resultEncoding.withGrid(
-      tensor.getContext(), resultType, optimalOutputGrid);
+  SmallVector<SmallVector<int64_t>> candidates;
+  for (unsigned dim = 0; dim < numDims; ++dim) {
+    candidates.push_back(getCandidateFactors(extents[dim], maxFactors[dim],
+                                             constraints.allowPaddedShards));
+  }
 
-  return RankedTensorType::get(resultType.getShape(),
-                               resultType.getElementType(), newResultEncoding);
+  std::optional<Blocking> best;
+  SmallVector<int64_t> factors(numDims);
+  std::function<void(unsigned)> search = [&](unsigned dim) {
+    if (dim == numDims) {
+      Blocking blocking = evaluateBlocking(operandShapes, extents, isCoreDim,
+                                           factors, constraints);
+      if (!best || blocking < *best) {
+        best = std::move(blocking);
+      }
+      return;
+    }
+    for (int64_t factor : candidates[dim]) {
+      factors[dim] = factor;
+      search(dim + 1);
+    }
+  };
+  search(0);
+  return *best;
 }
 
 namespace {
 struct TTIRGenericTensorLayoutRewriter
     : public OpRewritePattern<ttir::GenericOp> {
   TTIRGenericTensorLayoutRewriter(MLIRContext *context,
-                                  SmallVector<int64_t> workerGridShape)
+                                  BlockingConstraints constraints)
       : OpRewritePattern<ttir::GenericOp>(context),
-        workerGridShape(workerGridShape) {}
+        constraints(std::move(constraints)) {}
 
   LogicalResult matchAndRewrite(ttir::GenericOp op,
                                 PatternRewriter &rewriter) const final {
-    // Update output tensor type
+    if (!op.isAffineMapForm()) {
+      return failure();
+    }
+
     assert(op->getResults().size() == 1 &&
            "Only one result tensor is supported for now");
-    auto newTensorType = calculateOptimalLayoutForTensorType(
-        rewriter, op->getResult(0), workerGridShape);
-    if (op->getResult(0).getType() == newTensorType) {
+    Blocking blocking = findBlocking(op, constraints);
+    SmallVector<OperandShape> operandShapes = getOperandShapes(op);
+
+    SmallVector<RankedTensorType> newOperandTypes;
+    for (auto [operand, operandShape] :
+         llvm::zip(op->getOperands(), operandShapes)) {
+      auto operandType = mlir::cast<RankedTensorType>(operand.getType());
+      auto grid = rewriter.getAttr<GridAttr>(
+          getOperandGridShape(operandShape, blocking.factors));
+      auto newEncoding = getMetalLayout(operand).withGrid(
+          rewriter.getContext(), operandType, grid);
+      newOperandTypes.push_back(
+          RankedTensorType::get(operandType.getShape(),
+                                operandType.getElementType(), newEncoding));
+    }
+
+    if (llvm::equal(op->getOperandTypes(), newOperandTypes)) {
       return failure();
     }
 
+    auto dpsOp = mlir::cast<DestinationStyleOpInterface>(op.getOperation());
+    assert(dpsOp.getNumDpsInits() == 1 &&
+           "Only one result tensor is supported for now");
+    RankedTensorType newTensorType =
+        newOperandTypes[dpsOp.getDpsInitOperand(0)->getOperandNumber()];
     Type originalType = op->getResult(0).getType();
     rewriter.modifyOpInPlace(op, [&]() {
       // Update generic grid (match worker cores to output grid)
@@ -85,12 +288,8 @@ struct TTIRGenericTensorLayoutRewriter
           mlir::cast<MetalLayoutAttr>(newTensorType.getEncoding()).getGrid());
     });
 
-    auto dpsOp = mlir::cast<DestinationStyleOpInterface>(op.getOperation());
-    assert(dpsOp.getNumDpsInits() == 1 &&
-           "Only one result tensor is supported for now");
-    for (OpOperand &operand : op->getOpOperands()) {
-      auto newOperandType = calculateOptimalLayoutForTensorType(
-          rewriter, operand.get(), workerGridShape);
+    for (auto [operand, newOperandType] :
+         llvm::zip(op->getOpOperands(), newOperandTypes)) {
       if (operand.get().getType() != newOperandType) {
         auto emptyOp =
             rewriter.create<ttir::EmptyOp>(op->getLoc(), newOperandType);
@@ -98,16 +297,15 @@ struct TTIRGenericTensorLayoutRewriter
             op->getLoc(), operand.get(), emptyOp.getResult());
         rewriter.modifyOpInPlace(
             op, [&]() { operand.set(toLayoutOp.getResult(0)); });
-
-        if (dpsOp.isDpsInit(&operand)) {
-          assert(newOperandType == newTensorType &&
-                 "DPS init tensor must have the same type as the result");
-          rewriter.modifyOpInPlace(
-              op, [&]() { op->getResult(0).setType(newTensorType); });
-        }
       }
     }
 
+    if (originalType == newTensorType) {
+      return success();
+    }
+
+    rewriter.modifyOpInPlace(
+        op, [&]() { op->getResult(0).setType(newTensorType); });
     rewriter.setInsertionPointAfter(op);
     auto emptyOp = rewriter.create<ttir::EmptyOp>(op->getLoc(), originalType);
     auto toLayoutOp = rewriter.create<ttir::ToLayoutOp>(
@@ -118,7 +316,7 @@ struct TTIRGenericTensorLayoutRewriter
     return success();
   }
 
-  SmallVector<int64_t> workerGridShape;
+  BlockingConstraints constraints;
 };
 } // namespace
 
@@ -164,17 +362,24 @@ class TTIROptimizeTensorLayout
       TTIROptimizeTensorLayout>::TTIROptimizeTensorLayoutBase;
 
   void runOnOperation() final {
-    SmallVector<int64_t> workerGridShape = llvm::to_vector(overrideDeviceShape);
-    if (workerGridShape.empty()) {
+    BlockingConstraints constraints;
+    constraints.workerGridShape = llvm::to_vector(overrideDeviceShape);
+    if (constraints.workerGridShape.empty()) {
       auto device = lookupDevice(getOperation());
       assert(device && "Device not found");
-      workerGridShape = llvm::to_vector(device.getWorkerGrid().getShape());
+      constraints.workerGridShape =
+          llvm::to_vector(device.getWorkerGrid().getShape());
     }
+    ChipDescAttr chipDesc =
+        getCurrentScopeSystemDesc(getOperation()).getChipDescs().front();
+    constraints.usableL1Size = chipDesc.getUsableL1Size();
+    constraints.numStreamBuffers = numStreamBuffers;
+    constraints.allowPaddedShards = allowPaddedShards;
 
     {
       RewritePatternSet patterns(&getContext());
       patterns.add<TTIRGenericTensorLayoutRewriter>(&getContext(),
-                                                    workerGridShape);
+                                                    constraints);
       if (failed(applyPatternsGreedily(getOperation(), std::move(patterns)))) {
         signalPassFailure();
         return;
@@ -189,6 +394,21 @@ class TTIROptimizeTensorLayout
         return;
       }
     }
+
+    if (reportBlocking) {
+      getOperation()->walk([&](GenericOp op) {
+        if (!op.isAffineMapForm()) {
+          return;
+        }
+        Blocking blocking = findBlocking(op, constraints);
+        op.emitRemark() << "Blocking: loop factors "
+                        << ttmlir::utils::join(blocking.factors, "x") << ", "
+                        << blocking.numCores << " cores, " << blocking.cycles
+                        << " estimated cycles, " << blocking.l1Bytes
+                        << " bytes of L1 per core, " << blocking.paddedBytes
+                        << " bytes of padding";
+      });
+    }
   }
 
   void getDependentDialects(mlir::DialectRegistry &registry) const override {
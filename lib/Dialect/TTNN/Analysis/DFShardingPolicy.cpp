@@ -12,9 +12,31 @@
 #include "ttmlir/Utils.h"
 
 #include "mlir/IR/Diagnostics.h"
+#include "llvm/ADT/STLExtras.h"
 
 namespace mlir::tt::ttnn {
 
+uint64_t DFShardingPolicy::getLiveL1Usage(const L1ChainConfig &l1ChainConfig,
+                                          Operation *currentOp) const {
+  // Output of a chain op stays in L1 until all of its users are executed.
+  // Ops are added to the chain in schedule order, so users that are neither
+  // in the chain nor the currentOp are yet to be executed, e.g. the other
+  // branch of a fork waiting for its join.
+  //
+  const llvm::DenseSet<Operation *> &chainedOps =
+      l1ChainConfig.getL1ChainedOps();
+  uint64_t liveL1Usage = 0;
+  for (const auto &shardSpec : l1ChainConfig.getOpL1MemSpecs()) {
+    bool isLive = llvm::any_of(shardSpec.op->getUsers(), [&](Operation *user) {
+      return user != currentOp && !chainedOps.contains(user);
+    });
+    if (isLive) {
+      liveL1Usage += shardSpec.config.outputLayout.getShardSizeInBytes();
+    }
+  }
+  return liveL1Usage;
+}
+
 void DFShardingPolicy::run() {
   rootOp->walk([&](func::FuncOp func) {
     if (ttmlir::utils::isConstEvalFunc(func)) {
@@ -29,10 +51,16 @@ void DFShardingPolicy::run() {
 
     // Produce shard chain configs.
     // 1. Schedule ops in DFS order.
-    // 2. Check if currentOp has a valid successor. (no forking for now)
-    // 3. Check if currentOp/nextOp pair is valid for sharding.
+    // 2. Check if currentOp has a valid successor.
+    // 3. Check if currentOp/nextOp pair is valid for sharding, accounting for
+    //    outputs of forked chain ops which are still live in L1.
     // 4. Op is considered sharded if its output is sharded to L1.
     //
+    // Chains follow a single successor at a time, but ops may fork and join
+    // within a chain, e.g. a residual connection whose both branches are
+    // scheduled while the chain is being built. Uses of chain ops outside of
+    // the chain read a DRAM copy of the output.
+    //
     while (scheduler.hasUnscheduledOps()) {
       scheduleableOps = scheduler.getScheduleableOps();
 
@@ -84,11 +112,7 @@ void DFShardingPolicy::run() {
 
         if (nextOp) {
 
-          // V0 Before adding to shard chain config check that currentOp is not
-          // fork/join op.
-          //
-          bool validForSharding = currentOp->hasOneUse() &&
-                                  legalConfigs.lookup(currentOp).size() > 0 &&
+          bool validForSharding = legalConfigs.lookup(currentOp).size() > 0 &&
                                   legalConfigs.lookup(nextOp).size() > 0;
 
           // TODO(odjuricic): Skip all ops that don't support sharding due to
@@ -118,7 +142,7 @@ void DFShardingPolicy::run() {
             //
             // Calculate L1 tensor memory usage based on :
             // currentOp output tensor shard spec, nextOp exec and nextOp output
-            // tensor.
+            // tensor, on top of the outputs of chain ops that are still live.
             //
             OpConfig currentOpConfig = legalConfigs.lookup(currentOp).front();
             assert(
@@ -135,7 +159,10 @@ void DFShardingPolicy::run() {
             // with API.
             //
             constexpr float tensorL1UsageCap = 0.8;
-            bool l1UsageValid = (currentOpL1OutputUsage + nextOpL1OutputUsage) <
+            uint64_t liveL1Usage =
+                getLiveL1Usage(l1ChainConfigs->back(), currentOp);
+            bool l1UsageValid = (liveL1Usage + currentOpL1OutputUsage +
+                                 nextOpL1OutputUsage) <
                                 tensorL1UsageCap * usableL1CacheSize;
 
             if (l1UsageValid) {
@@ -182,6 +209,12 @@ void DFShardingPolicy::run() {
                 OpL1MemSpec shardSpec;
                 shardSpec.op = currentOp;
 
+                // Config the L1 usage of the op was checked with. It is
+                // replaced by the config picked by the ShardSolver once the
+                // chain is completed.
+                //
+                shardSpec.config = currentOpConfig;
+
                 // Hardcoded tensor split factor for now, until pipeline OP
                 // support is added.
                 //
@@ -215,7 +248,7 @@ void DFShardingPolicy::run() {
   for (auto &l1ChainConfig : *l1ChainConfigs) {
     ShardSolver shardSolver = l1ChainConfig.resolveWithSolver(
         tensorTypePossibleLayouts, legalConfigs, usableL1CacheSize,
-        overrideReshardEdges);
+        overrideReshardEdges, opModelBackend);
 
     if (l1ChainConfig.getState() == L1ChainState::Failed) {
       mlir::emitWarning(l1ChainConfig.getOpL1MemSpecs().front().op->getLoc(),
@@ -238,6 +271,24 @@ void DFShardingPolicy::run() {
              .outputLayout.hasDRAMBufferType()) {
       l1ChainConfig.spillEndToDRAM = true;
     }
+
+    // Forked ops with users outside of the chain also need their output in
+    // DRAM for those users.
+    //
+    const llvm::DenseSet<Operation *> &chainedOps =
+        l1ChainConfig.getL1ChainedOps();
+    for (const auto &shardSpec : l1ChainConfig.getOpL1MemSpecs()) {
+      Operation *op = shardSpec.op;
+      if (op == l1ChainConfig.getLastOp() ||
+          shardSpec.config.outputLayout.hasDRAMBufferType()) {
+        continue;
+      }
+      if (llvm::any_of(op->getUsers(), [&](Operation *user) {
+            return !chainedOps.contains(user);
+          })) {
+        l1ChainConfig.spillForksToDRAM.push_back(op);
+      }
+    }
   }
 }
 
@@ -9,43 +9,66 @@
 #include "ttmlir/Dialect/TTNN/Utils/Utils.h"
 #include "ttmlir/Scheduler/Scheduler.h"
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
 namespace mlir::tt::ttnn {
 
+// Returns true if `a` comes before `b` in program order.
+static bool isBeforeInProgramOrder(Operation *a, Operation *b) {
+  if (a->getBlock() == b->getBlock()) {
+    return a->isBeforeInBlock(b);
+  }
+  if (Operation *bAncestor = a->getBlock()->findAncestorOpInBlock(*b)) {
+    return a == bAncestor || a->isBeforeInBlock(bAncestor);
+  }
+  if (Operation *aAncestor = b->getBlock()->findAncestorOpInBlock(*a)) {
+    return aAncestor->isBeforeInBlock(b);
+  }
+  return false;
+}
+
 GreedyL1InterleavedPolicy::GreedyPolicyChoice
 GreedyL1InterleavedPolicy::getGreedyConfig(
     Operation *baseOp, llvm::DenseMap<Operation *, L1Usage> &opsL1Usage) {
-  uint64_t numOfOps, bitIndex, currentMask;
-  uint64_t currentL1Usage, optimalL1Usage;
-  llvm::DenseMap<Operation *, OpConfig> optimalConfigs;
-  llvm::DenseMap<Operation *, OpConfig> currentConfigs;
-  llvm::SmallVector<Operation *> optimalPrecedence;
-
-  constexpr uint64_t maxNumOfOps = sizeof(numOfOps) * 8;
-  numOfOps = opsL1Usage.size();
-  assert(numOfOps <= maxNumOfOps);
+  // Visit the ops in program order so that the choice does not depend on
+  // where the ops happen to be allocated.
+  //
+  llvm::SmallVector<Operation *> ops;
+  for (const auto &[op, l1Usage] : opsL1Usage) {
+    ops.push_back(op);
+  }
+  std::sort(ops.begin(), ops.end(), isBeforeInProgramOrder);
+  const size_t numOfOps = ops.size();
 
-  optimalL1Usage = 0;
-  for (currentMask = 0; currentMask < (1 << numOfOps); currentMask++) {
-    std::bitset<maxNumOfOps> bitset(currentMask);
-    llvm::DenseMap<Operation *, OpConfig> currentConfigs;
-    llvm::SmallVector<Operation *> currentPrecedence, optimalL1Precedence,
-        L1Precedence;
+  // Builds the configs and precedence of the ops for the given choice of
+  // L1 interleaved ops. Returns the L1 usage of the choice, or std::nullopt
+  // if it does not fit into L1.
+  //
+  auto evaluate =
+      [&](const llvm::BitVector &inL1,
+          llvm::DenseMap<Operation *, OpConfig> &currentConfigs,
+          llvm::SmallVector<Operation *> &currentPrecedence)
+      -> std::optional<uint64_t> {
+    llvm::SmallVector<Operation *> L1Precedence;
 
     // Calculate the L1 usage of the current configuration.
     //
-    currentL1Usage = 0;
-    bitIndex = 0;
-    for (const auto &[op, l1Usage] : opsL1Usage) {
-      if (bitset[bitIndex]) {
+    uint64_t currentL1Usage = 0;
+    for (size_t i = 0; i < numOfOps; i++) {
+      Operation *op = ops[i];
+      if (inL1[i]) {
         // In case we have an operand with L1 interleaved layout, we need to
         // figure out its schedule among the other operands with L1 interleaved
         // layout. Therefore, we insert all of them into the L1Precedence where
         // calculate the optimal L1Precedence and then concatenate it with the
         // currentPrecedence.
         //
-        currentL1Usage += l1Usage.outputL1Usage;
+        currentL1Usage += opsL1Usage[op].outputL1Usage;
         currentConfigs[op] = OpConfig(getL1InterleavedLayout(op));
 
         // Skip the baseOp.
@@ -66,60 +89,103 @@ GreedyL1InterleavedPolicy::getGreedyConfig(
           currentPrecedence.push_back(op);
         }
       }
-      bitIndex += 1;
+    }
+
+    if (currentL1Usage > getAvailableL1CacheSize()) {
+      return std::nullopt;
     }
 
     // Calculate the optimal L1Precedence.
     //
-    bool isMaskLegal = false;
-    uint64_t minRequiredL1Usage = getAvailableL1CacheSize();
-
-    std::sort(L1Precedence.begin(), L1Precedence.end());
-    do {
-      // Check if the current order of L1Precedence is legal.
-      //
-      bool isLegal = true;
-      uint64_t intermediateL1Usage = 0;
-      uint64_t intermediateRequiredL1Usage = 0;
-      for (Operation *op : L1Precedence) {
-        if (intermediateL1Usage + opsL1Usage[op].requiredL1Usage >
-            getAvailableL1CacheSize()) {
-          isLegal = false;
-          break;
-        }
+    // Scheduling op X requires the outputs of all the previously scheduled
+    // ops plus X's required usage, so the peak usage of a precedence is the
+    // max over its ops of that sum. Swapping adjacent ops X and Y never
+    // lowers the peak when X.required - X.output >= Y.required - Y.output and
+    // X is already first, therefore ordering the ops by that difference in
+    // descending order yields the minimal peak. If any precedence is legal,
+    // this one is. Ties keep program order.
+    //
+    std::stable_sort(L1Precedence.begin(), L1Precedence.end(),
+                     [&](Operation *a, Operation *b) {
+                       const L1Usage &aUsage = opsL1Usage[a];
+                       const L1Usage &bUsage = opsL1Usage[b];
+                       int64_t aSlack =
+                           static_cast<int64_t>(aUsage.requiredL1Usage) -
+                           static_cast<int64_t>(aUsage.outputL1Usage);
+                       int64_t bSlack =
+                           static_cast<int64_t>(bUsage.requiredL1Usage) -
+                           static_cast<int64_t>(bUsage.outputL1Usage);
+                       return aSlack > bSlack;
+                     });
+
+    uint64_t intermediateL1Usage = 0;
+    uint64_t intermediateRequiredL1Usage = 0;
+    for (Operation *op : L1Precedence) {
+      intermediateRequiredL1Usage =
+          std::max(intermediateRequiredL1Usage,
+                   intermediateL1Usage + opsL1Usage[op].requiredL1Usage);
+      intermediateL1Usage += opsL1Usage[op].outputL1Usage;
+    }
 
-        intermediateRequiredL1Usage =
-            std::max(intermediateRequiredL1Usage,
-                     intermediateL1Usage + opsL1Usage[op].requiredL1Usage);
-        intermediateL1Usage += opsL1Usage[op].outputL1Usage;
-      }
+    // The choice is legal only if its optimal L1Precedence is legal.
+    //
+    if (intermediateRequiredL1Usage >= getAvailableL1CacheSize()) {
+      return std::nullopt;
+    }
 
-      // Pick optimal L1Precedence among all legal L1Precedence.
-      // The one that requires the least amount of L1 cache overall is
-      // considered optimal.
-      //
-      if (isLegal && intermediateRequiredL1Usage < minRequiredL1Usage) {
-        isMaskLegal = true;
-        minRequiredL1Usage = intermediateRequiredL1Usage;
-        optimalL1Precedence = L1Precedence;
+    // Append the legal L1Precedence to the currentPrecedence and therefore
+    // create a complete precedence for the baseOp.
+    //
+    currentPrecedence.append(L1Precedence.begin(), L1Precedence.end());
+    return currentL1Usage;
+  };
+
+  uint64_t optimalL1Usage = 0;
+  llvm::DenseMap<Operation *, OpConfig> optimalConfigs;
+  llvm::SmallVector<Operation *> optimalPrecedence;
+
+  // Keeps the choice if it uses more L1 than the best one so far.
+  //
+  auto tryChoice = [&](const llvm::BitVector &inL1) {
+    llvm::DenseMap<Operation *, OpConfig> currentConfigs;
+    llvm::SmallVector<Operation *> currentPrecedence;
+    std::optional<uint64_t> currentL1Usage =
+        evaluate(inL1, currentConfigs, currentPrecedence);
+    if (!currentL1Usage || *currentL1Usage <= optimalL1Usage) {
+      return false;
+    }
+    optimalL1Usage = *currentL1Usage;
+    optimalConfigs = std::move(currentConfigs);
+    optimalPrecedence = std::move(currentPrecedence);
+    return true;
+  };
+
+  llvm::BitVector inL1(numOfOps);
+  if (numOfOps <= maxNumOfExhaustiveOps) {
+    // Try every subset of ops placed in L1.
+    //
+    for (uint64_t currentMask = 0; currentMask < (uint64_t{1} << numOfOps);
+         currentMask++) {
+      for (size_t i = 0; i < numOfOps; i++) {
+        inL1[i] = (currentMask >> i) & 1;
+      }
+      tryChoice(inL1);
+    }
+  } else {
+    // Too many subsets to enumerate. Greedily move ops into L1, largest
+    // output first, as long as the choice stays legal.
+    //
+    llvm::SmallVector<size_t> order(numOfOps);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return opsL1Usage[ops[a]].outputL1Usage >
+             opsL1Usage[ops[b]].outputL1Usage;
+    });
+    for (size_t i : order) {
+      inL1.set(i);
+      if (!tryChoice(inL1)) {
+        inL1.reset(i);
       }
-    } while (std::next_permutation(L1Precedence.begin(), L1Precedence.end()));
-
-    if (isMaskLegal && optimalL1Usage < currentL1Usage &&
-        currentL1Usage <= getAvailableL1CacheSize()) {
-
-      // Append the legal L1Precedence to the currentPrecedence and therefore
-      // create a complete precedence for the baseOp and currentMask.
-      //
-      currentPrecedence.insert(currentPrecedence.end(),
-                               optimalL1Precedence.begin(),
-                               optimalL1Precedence.end());
-
-      // Update the optimal configuration.
-      //
-      optimalL1Usage = currentL1Usage;
-      optimalConfigs = std::move(currentConfigs);
-      optimalPrecedence = std::move(currentPrecedence);
     }
   }
 
@@ -27,7 +27,8 @@ ShardSolver L1ChainConfig::resolveWithSolver(
     const TensorTypeLayoutsMap *tensorTypePossibleLayouts,
     const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs,
     unsigned usableL1CacheSize,
-    const llvm::DenseSet<Edge> &overrideReshardEdges) {
+    const llvm::DenseSet<Edge> &overrideReshardEdges,
+    std::shared_ptr<OpModelBackend> opModelBackend) {
   assert(state == L1ChainState::Built);
 
   // Reconcile adjacent shard specs.
@@ -35,7 +36,9 @@ ShardSolver L1ChainConfig::resolveWithSolver(
   //
   ShardSolver shardSolver(tensorTypePossibleLayouts, legalConfigs, opL1MemSpecs,
                           l1ChainedOps, usableL1CacheSize,
-                          overrideReshardEdges);
+                          overrideReshardEdges,
+                          /*customCheckShardCompatible=*/nullptr,
+                          std::move(opModelBackend));
 
   state = shardSolver.resolve() ? L1ChainState::Resolved : L1ChainState::Failed;
 
@@ -9,6 +9,7 @@
 #include "ttmlir/Dialect/TTNN/Analysis/GreedyL1InterleavedPolicy.h"
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
 #include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+#include "ttmlir/Support/Logger.h"
 
 namespace mlir::tt::ttnn {
 
@@ -66,6 +67,7 @@ void MemoryLayoutAnalysis::analysisImplementation() {
         analysisInput.usableL1CacheSize);
     dfShardingPolicy.setOverrideReshardEdges(
         analysisInput.overrideReshardEdges);
+    dfShardingPolicy.setOpModelBackend(analysisInput.opModelBackend);
     dfShardingPolicy.run();
     break;
   }
@@ -111,6 +113,27 @@ void MemoryLayoutAnalysis::analysisImplementation() {
     if (l1ChainConfig.spillEndToDRAM) {
       analysisResult.spillToDramOps.push_back(l1ChainConfig.getLastOp());
     }
+    analysisResult.spillToDramOps.insert(
+        analysisResult.spillToDramOps.end(),
+        l1ChainConfig.spillForksToDRAM.begin(),
+        l1ChainConfig.spillForksToDRAM.end());
+
+    const llvm::DenseSet<Operation *> &chainedOps =
+        l1ChainConfig.getL1ChainedOps();
+    for (const auto &opL1MemSpec : l1ChainConfig.getOpL1MemSpecs()) {
+      Operation *op = opL1MemSpec.op;
+      for (OpOperand &operand : op->getOpOperands()) {
+        Operation *producerOp = operand.get().getDefiningOp();
+        if (producerOp && chainedOps.contains(producerOp)) {
+          analysisResult.l1ChainEdges.insert(
+              Edge(producerOp, op, operand.getOperandNumber()));
+        }
+      }
+    }
   }
+
+  TTMLIR_DEBUG(ttmlir::LogComponent::Optimizer,
+               "Memory layout analysis: {0} L1 chains, {1} spills to DRAM",
+               l1ChainConfigs.size(), analysisResult.spillToDramOps.size());
 }
 } // namespace mlir::tt::ttnn
@@ -4,6 +4,13 @@
 
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfigAnalysis.h"
 
+#include "ttmlir/Support/Logger.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Sequence.h"
+
+#include <limits>
+
 namespace mlir::tt::ttnn {
 
 bool OpConfigAnalysis::applyOverrides() {
@@ -13,13 +20,112 @@ bool OpConfigAnalysis::applyOverrides() {
   return false;
 }
 
-void OpConfigAnalysis::analysisImplementation() {
+OpConfig OpConfigAnalysis::pickConfig(Operation *op,
+                                      const std::vector<OpConfig> &configs,
+                                      const OpCostModel &costModel) const {
+  if (configs.size() == 1) {
+    return configs.front();
+  }
+
+  // L1 usage is only accounted for by the memory layout analysis, which
+  // narrows ops it places in L1 down to a single config. If multiple configs
+  // remain, rank only the DRAM ones so that L1 is never oversubscribed.
+  //
+  llvm::SmallVector<size_t> candidates;
+  for (size_t i = 0; i < configs.size(); i++) {
+    if (configs[i].outputLayout.hasDRAMBufferType()) {
+      candidates.push_back(i);
+    }
+  }
+  if (candidates.empty()) {
+    candidates = llvm::to_vector(llvm::seq<size_t>(0, configs.size()));
+  }
+
+  // Input layouts are the ones picked for producers so far, or the current
+  // operand layouts for values produced outside of the analysis.
+  //
+  std::vector<TTNNLayoutAttr> inputLayouts;
+  for (Value operand : getOpModelInputOperands(op)) {
+    OpResult result = mlir::dyn_cast<OpResult>(operand);
+    if (result && result.getResultNumber() == 0) {
+      auto producerConfig = analysisResult.find(result.getOwner());
+      if (producerConfig != analysisResult.end()) {
+        inputLayouts.push_back(producerConfig->second.outputLayout);
+        continue;
+      }
+    }
+    auto operandType = mlir::dyn_cast<RankedTensorType>(operand.getType());
+    inputLayouts.push_back(
+        operandType ? mlir::dyn_cast_if_present<TTNNLayoutAttr>(
+                          operandType.getEncoding())
+                    : TTNNLayoutAttr());
+  }
 
-  // Future entrypoint for picking optimal op config.
-  // Placeholder: pick the first legal config.
+  // Consumers outside of the analysis keep expecting the current output
+  // layout, so a different layout implies a conversion on those edges.
   //
-  for (auto opConfigs : analysisInput.legalConfigs) {
-    analysisResult[opConfigs.first] = opConfigs.second[0];
+  RankedTensorType outputType =
+      mlir::cast<RankedTensorType>(op->getResult(0).getType());
+  TTNNLayoutAttr currentLayout =
+      mlir::dyn_cast_if_present<TTNNLayoutAttr>(outputType.getEncoding());
+  size_t numUnanalyzedUses =
+      llvm::count_if(op->getResult(0).getUses(), [&](OpOperand &use) {
+        return !analysisInput.legalConfigs.contains(use.getOwner());
+      });
+
+  size_t bestIndex = candidates.front();
+  double bestScore = std::numeric_limits<double>::infinity();
+  for (size_t i : candidates) {
+    const OpConfig &config = configs[i];
+    OpCost opCost = costModel.getOpCost(op, inputLayouts, config);
+    double conversionCost = costModel.getLayoutConversionCost(
+        outputType, config.outputLayout, currentLayout);
+    conversionCost *= numUnanalyzedUses;
+    double score = opCost.runtime + conversionCost;
+
+    TTMLIR_TRACE(ttmlir::LogComponent::Optimizer,
+                 "OpConfigAnalysis: {0} at {1} config #{2} {3}: runtime {4} ns "
+                 "({5}), conversion {6} ns, score {7}",
+                 op->getName(), op->getLoc(), i, config.outputLayout,
+                 opCost.runtime, opCost.measured ? "measured" : "analytical",
+                 conversionCost, score);
+
+    // Ties keep the earlier config, preserving the legal layout ordering.
+    //
+    if (score < bestScore) {
+      bestScore = score;
+      bestIndex = i;
+    }
+  }
+
+  TTMLIR_DEBUG(ttmlir::LogComponent::Optimizer,
+               "OpConfigAnalysis: {0} at {1} picked config #{2} {3} with "
+               "score {4} out of {5} candidates",
+               op->getName(), op->getLoc(), bestIndex,
+               configs[bestIndex].outputLayout, bestScore, candidates.size());
+
+  return configs[bestIndex];
+}
+
+void OpConfigAnalysis::analysisImplementation() {
+  std::shared_ptr<OpCostModel> costModel = analysisInput.costModel;
+  if (!costModel) {
+    costModel = std::make_shared<OpModelRuntimeCostModel>();
   }
+
+  analysisResult.clear();
+
+  // Visit ops in program order so that layouts of producers are already
+  // decided when their consumers are scored.
+  //
+  op->walk([&](Operation *nestedOp) {
+    auto opConfigs = analysisInput.legalConfigs.find(nestedOp);
+    if (opConfigs == analysisInput.legalConfigs.end() ||
+        opConfigs->second.empty()) {
+      return;
+    }
+    analysisResult[nestedOp] =
+        pickConfig(nestedOp, opConfigs->second, *costModel);
+  });
 }
 } // namespace mlir::tt::ttnn
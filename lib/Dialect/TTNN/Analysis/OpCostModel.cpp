@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TTNN/Analysis/OpCostModel.h"
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+#include "ttmlir/Support/Logger.h"
+
+#include "mlir/Interfaces/DestinationStyleOpInterface.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+
+namespace mlir::tt::ttnn {
+
+namespace {
+// Rough device characteristics used by the analytical estimate. Only the
+// relative magnitudes matter since the estimate is used for ranking.
+//
+constexpr double kDRAMBandwidth = 256.0;        // bytes/ns, whole chip
+constexpr double kL1BandwidthPerCore = 64.0;    // bytes/ns
+constexpr double kHostBandwidth = 16.0;         // bytes/ns
+constexpr double kTilizeBandwidthPerCore = 4.0; // bytes/ns
+constexpr double kTileComputeTime = 32.0;       // ns per tile per core
+} // namespace
+
+llvm::SmallVector<Value> getOpModelInputOperands(Operation *op) {
+  uint32_t numOperands = op->getNumOperands();
+  // Discard DPS operand since it's not used in runtime.
+  // TODO(odjuricic,#2088): Remove once fix this on MLIR / runtime side.
+  if (llvm::isa<DestinationStyleOpInterface>(op)) {
+    numOperands = numOperands - 1;
+  }
+
+  llvm::SmallVector<Value> operands;
+  for (uint32_t i = 0; i < numOperands; i++) {
+    Value operand = op->getOperand(i);
+    if (mlir::isa<TypedValue<mlir::tt::ttnn::DeviceType>>(operand)) {
+      continue;
+    }
+    operands.push_back(operand);
+  }
+  return operands;
+}
+
+uint64_t
+AnalyticalOpCostModel::getTensorSizeInBytes(RankedTensorType tensorType,
+                                            TTNNLayoutAttr layout) {
+  llvm::ArrayRef<int64_t> shape = tensorType.getShape();
+  if (!layout.isTiled()) {
+    return tensorType.getNumElements() *
+           mlir::tt::getElementSizeBytes(layout.getElementType());
+  }
+
+  TileType tileType = mlir::cast<TileType>(layout.getElementType());
+  int64_t height = shape.size() >= 2 ? shape[shape.size() - 2] : 1;
+  int64_t width = shape.empty() ? 1 : shape.back();
+  int64_t numTiles = llvm::divideCeil(height, tileType.getHeight()) *
+                     llvm::divideCeil(width, tileType.getWidth());
+  for (size_t i = 0; i + 2 < shape.size(); i++) {
+    numTiles *= shape[i];
+  }
+  return numTiles * tileType.getSizeBytes();
+}
+
+int64_t AnalyticalOpCostModel::getNumCores(TTNNLayoutAttr layout) {
+  if (layout.isSystemBufferType()) {
+    return 1;
+  }
+  return std::max<int64_t>(layout.getGrid().getGridVolume(), 1);
+}
+
+double AnalyticalOpCostModel::getBandwidth(TTNNLayoutAttr layout) {
+  switch (layout.getBufferType()) {
+  case BufferType::DRAM:
+    return kDRAMBandwidth;
+  case BufferType::L1:
+  case BufferType::L1Small:
+  case BufferType::Trace:
+    return kL1BandwidthPerCore * getNumCores(layout);
+  case BufferType::SystemMemory:
+    return kHostBandwidth;
+  }
+  llvm_unreachable("Unknown buffer type");
+}
+
+OpCost AnalyticalOpCostModel::getOpCost(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  TTNNLayoutAttr outputLayout = config.outputLayout;
+  RankedTensorType outputType =
+      mlir::cast<RankedTensorType>(op->getResult(0).getType());
+  uint64_t outputBytes = getTensorSizeInBytes(outputType, outputLayout);
+  int64_t numCores = getNumCores(outputLayout);
+
+  double runtime = outputBytes / getBandwidth(outputLayout);
+
+  // Compute happens on tiles; row major operands are tilized on the way in
+  // and a row major output is untilized on the way out.
+  //
+  llvm::SmallVector<Value> operands = getOpModelInputOperands(op);
+  for (auto [operand, inputLayout] : llvm::zip(operands, inputLayouts)) {
+    auto inputType = mlir::dyn_cast<RankedTensorType>(operand.getType());
+    if (!inputType || !inputLayout) {
+      continue;
+    }
+    uint64_t inputBytes = getTensorSizeInBytes(inputType, inputLayout);
+    runtime += inputBytes / getBandwidth(inputLayout);
+    if (!inputLayout.isTiled()) {
+      runtime += inputBytes / (kTilizeBandwidthPerCore * numCores);
+    }
+  }
+  if (!outputLayout.isTiled()) {
+    runtime += outputBytes / (kTilizeBandwidthPerCore * numCores);
+  }
+
+  TileType tileType = TileType::get(outputLayout.getScalarElementType());
+  uint64_t numTiles =
+      llvm::divideCeil(outputType.getNumElements(),
+                       tileType.getHeight() * tileType.getWidth());
+  runtime += numTiles * kTileComputeTime / numCores;
+
+  return OpCost{runtime, /*measured=*/false};
+}
+
+double AnalyticalOpCostModel::getLayoutConversionCost(
+    RankedTensorType tensorType, TTNNLayoutAttr from, TTNNLayoutAttr to) const {
+  if (!from || !to || from == to) {
+    return 0.0;
+  }
+
+  uint64_t fromBytes = getTensorSizeInBytes(tensorType, from);
+  uint64_t toBytes = getTensorSizeInBytes(tensorType, to);
+  double cost = fromBytes / getBandwidth(from) + toBytes / getBandwidth(to);
+
+  if (from.isTiled() != to.isTiled()) {
+    int64_t numCores = getNumCores(from.isTiled() ? from : to);
+    cost += std::max(fromBytes, toBytes) / (kTilizeBandwidthPerCore * numCores);
+  }
+
+  if (from.getDataType() != to.getDataType()) {
+    cost += toBytes / getBandwidth(to);
+  }
+
+  return cost;
+}
+
+OpCost OpModelRuntimeCostModel::getOpCost(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  llvm::Expected<size_t> runtime =
+      backend->getOpRuntime(op, inputLayouts, config);
+  if (runtime) {
+    return OpCost{static_cast<double>(*runtime), /*measured=*/true};
+  }
+  std::string error = llvm::toString(runtime.takeError());
+  TTMLIR_TRACE(ttmlir::LogComponent::Optimizer,
+               "OpModel runtime unavailable for {0}, using fallback: {1}",
+               op->getName(), error);
+  return fallback->getOpCost(op, inputLayouts, config);
+}
+
+} // namespace mlir::tt::ttnn
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+#include "ttmlir/Support/Logger.h"
+
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mlir::tt::ttnn {
+
+namespace {
+// Circular buffers are double buffered so that data movement of the next page
+// overlaps with compute on the current one.
+//
+constexpr size_t kNumCBBuffers = 2;
+
+uint64_t getTileSizeBytes(TTNNLayoutAttr layout) {
+  return TileType::get(layout.getScalarElementType()).getSizeBytes();
+}
+
+// Height and width of the per core shard, in tiles.
+//
+std::pair<int64_t, int64_t> getShardShapeInTiles(TTNNLayoutAttr layout) {
+  llvm::SmallVector<int64_t> shape = layout.getScalarShardShape();
+  TileType tileType = TileType::get(layout.getScalarElementType());
+  int64_t height = shape.size() >= 2 ? shape[shape.size() - 2] : 1;
+  int64_t width = shape.empty() ? 1 : shape.back();
+  return {llvm::divideCeil(height, tileType.getHeight()),
+          llvm::divideCeil(width, tileType.getWidth())};
+}
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// DeviceOpModelBackend
+//===----------------------------------------------------------------------===//
+
+bool DeviceOpModelBackend::isAvailable() {
+#ifdef TTMLIR_ENABLE_OPMODEL
+  return true;
+#else
+  return false;
+#endif
+}
+
+llvm::Expected<OpConstraints> DeviceOpModelBackend::getOpConstraints(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  OpModel backend = mlir::dyn_cast<OpModel>(op);
+  if (!backend) {
+    // This function should not be called for ops without backend constraints.
+    llvm::report_fatal_error(
+        ("Backend constraints are not implemented for op " +
+         op->getName().getStringRef()));
+  }
+  return backend.getOpConstraints(inputLayouts, config);
+}
+
+llvm::Expected<size_t> DeviceOpModelBackend::getOpRuntime(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  OpModel backend = mlir::dyn_cast<OpModel>(op);
+  if (!backend) {
+    return llvm::createStringError("OpModel interface is not implemented for " +
+                                   op->getName().getStringRef());
+  }
+  return backend.getOpRuntime(inputLayouts, config);
+}
+
+//===----------------------------------------------------------------------===//
+// AnalyticalOpModelBackend
+//===----------------------------------------------------------------------===//
+
+size_t AnalyticalOpModelBackend::getCBUsage(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    TTNNLayoutAttr outputLayout) {
+  // Operands sharded in L1 are read and written in place, others are streamed
+  // a tile at a time.
+  //
+  size_t usage = 0;
+  for (TTNNLayoutAttr inputLayout : inputLayouts) {
+    if (inputLayout && !inputLayout.hasShardedL1TensorMemoryLayout()) {
+      usage += kNumCBBuffers * getTileSizeBytes(inputLayout);
+    }
+  }
+  if (!outputLayout.hasShardedL1TensorMemoryLayout()) {
+    usage += kNumCBBuffers * getTileSizeBytes(outputLayout);
+  }
+
+  if (isa<MatmulOp, LinearOp>(op) && inputLayouts.size() >= 2 &&
+      inputLayouts[0] && inputLayouts[1]) {
+    // Blocks of both inputs along the inner dimension, plus the partial
+    // results of the whole output shard.
+    //
+    auto [shardHeight, shardWidth] = getShardShapeInTiles(outputLayout);
+    usage += kNumCBBuffers * shardHeight * getTileSizeBytes(inputLayouts[0]);
+    usage += kNumCBBuffers * shardWidth * getTileSizeBytes(inputLayouts[1]);
+    usage += shardHeight * shardWidth * getTileSizeBytes(outputLayout);
+  } else if (isa<SoftmaxOp, SumOp, MeanOp, MaxOp, MinOp>(op) &&
+             !inputLayouts.empty() && inputLayouts[0]) {
+    // Whole rows of the input shard are staged for the reduction.
+    //
+    int64_t shardWidth = getShardShapeInTiles(inputLayouts[0]).second;
+    usage += kNumCBBuffers * shardWidth * getTileSizeBytes(inputLayouts[0]);
+  }
+
+  return usage;
+}
+
+llvm::Expected<OpConstraints> AnalyticalOpModelBackend::getOpConstraints(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  TTNNLayoutAttr outputLayout = config.outputLayout;
+  if (!outputLayout) {
+    return llvm::createStringError(
+        "Analytical op model requires an output layout");
+  }
+
+  size_t outputUsage =
+      outputLayout.hasL1BufferType() ? outputLayout.getShardSizeInBytes() : 0;
+  return std::make_tuple(getCBUsage(op, inputLayouts, outputLayout),
+                         outputUsage, outputUsage, outputLayout);
+}
+
+llvm::Expected<size_t> AnalyticalOpModelBackend::getOpRuntime(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  return llvm::createStringError("Analytical op model has no runtime estimate");
+}
+
+//===----------------------------------------------------------------------===//
+// ComparingOpModelBackend
+//===----------------------------------------------------------------------===//
+
+llvm::Expected<OpConstraints> ComparingOpModelBackend::getOpConstraints(
+    Operation *op, const std::vector<TTNNLayoutAttr> &inputLayouts,
+    const OpConfig &config) const {
+  llvm::Expected<OpConstraints> deviceResult =
+      device.getOpConstraints(op, inputLayouts, config);
+  llvm::Expected<OpConstraints> analyticalResult =
+      analytical.getOpConstraints(op, inputLayouts, config);
+
+  stats.numCompared++;
+  if (static_cast<bool>(deviceResult) != static_cast<bool>(analyticalResult)) {
+    stats.numValidityMismatches++;
+    TTMLIR_TRACE(ttmlir::LogComponent::Optimizer,
+                 "OpModel backends disagree on validity of {0} at {1} with "
+                 "output layout {2}: device {3}, analytical {4}",
+                 op->getName(), op->getLoc(), config.outputLayout,
+                 deviceResult ? "valid" : "invalid",
+                 analyticalResult ? "valid" : "invalid");
+  } else if (deviceResult) {
+    // Peak circular buffer and L1 tensor usage.
+    //
+    size_t deviceUsage =
+        std::get<0>(*deviceResult) + std::get<1>(*deviceResult);
+    size_t analyticalUsage =
+        std::get<0>(*analyticalResult) + std::get<1>(*analyticalResult);
+    size_t difference = deviceUsage > analyticalUsage
+                            ? deviceUsage - analyticalUsage
+                            : analyticalUsage - deviceUsage;
+    size_t scale = std::max({deviceUsage, analyticalUsage, size_t{1}});
+    if (difference > tolerance * scale) {
+      stats.numUsageMismatches++;
+      TTMLIR_TRACE(ttmlir::LogComponent::Optimizer,
+                   "OpModel backends disagree on L1 usage of {0} at {1} with "
+                   "output layout {2}: device {3}, analytical {4}",
+                   op->getName(), op->getLoc(), config.outputLayout,
+                   deviceUsage, analyticalUsage);
+    }
+  }
+
+  if (!analyticalResult) {
+    llvm::consumeError(analyticalResult.takeError());
+  }
+  return deviceResult;
+}
+
+std::shared_ptr<OpModelBackend> createOpModelBackend(OpModelBackendType type) {
+  switch (type) {
+  case OpModelBackendType::Device:
+    return std::make_shared<DeviceOpModelBackend>();
+  case OpModelBackendType::Analytical:
+    return std::make_shared<AnalyticalOpModelBackend>();
+  case OpModelBackendType::Compare:
+    if (!DeviceOpModelBackend::isAvailable()) {
+      return std::make_shared<AnalyticalOpModelBackend>();
+    }
+    return std::make_shared<ComparingOpModelBackend>();
+  }
+  llvm_unreachable("Unknown op model backend type");
+}
+
+} // namespace mlir::tt::ttnn
@@ -25,13 +25,12 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 namespace mlir::tt::ttnn {
 
-ShardSolver::Bitset ShardSolver::kBitsetAll = ~kBitsetNone;
-
 ShardSolver::ShardSolver(
     const TensorTypeLayoutsMap *tensorTypePossibleLayouts,
     const llvm::DenseMap<Operation *, std::vector<OpConfig>> &legalConfigs,
@@ -41,12 +40,16 @@ ShardSolver::ShardSolver(
     const llvm::DenseSet<Edge> &overrideReshardEdges,
     std::function<llvm::Expected<TTNNLayoutAttr>(Value, TTNNLayoutAttr,
                                                  Operation *, OpConfig)>
-        customCheckShardCompatible)
+        customCheckShardCompatible,
+    std::shared_ptr<OpModelBackend> opModelBackend)
     : tensorTypePossibleLayouts(tensorTypePossibleLayouts),
       legalConfigs(&legalConfigs), shardSpecs(&shardSpecs),
       shardedOps(&shardedOps), usableL1CacheSize(usableL1CacheSize),
       memReconfigEdges(overrideReshardEdges),
-      customCheckShardCompatible(customCheckShardCompatible) {
+      customCheckShardCompatible(customCheckShardCompatible),
+      opModelBackend(opModelBackend
+                         ? std::move(opModelBackend)
+                         : std::make_shared<DeviceOpModelBackend>()) {
   pathSets.reserve(shardSpecs.size());
   pathSetIds.reserve(shardSpecs.size());
   bitsets.reserve(shardedOps.size());
@@ -98,7 +101,7 @@ bool ShardSolver::resolveStep() {
                  "Resolving constraints for: {}", shardSpec.op->getName());
 
     Operation *consumerOp = shardSpec.op;
-    Bitset *consumerBitset = getOrInsertBitset(consumerOp, kBitsetAll);
+    Bitset *consumerBitset = getOrInsertBitset(consumerOp);
     const std::vector<OpConfig> &consumerConfigs = getLegalConfigs(consumerOp);
 
     // For now, we don't change op-specific attributes in this analysis so we
@@ -128,7 +131,7 @@ bool ShardSolver::resolveStep() {
       }
 
       Operation *producerOp = edge.producerOp;
-      Bitset *producerBitset = getOrInsertBitset(producerOp, kBitsetAll);
+      Bitset *producerBitset = getOrInsertBitset(producerOp);
       const std::vector<OpConfig> &producerConfigs =
           getLegalConfigs(producerOp);
 
@@ -136,12 +139,10 @@ bool ShardSolver::resolveStep() {
 
       PathSet::Paths paths;
       std::unordered_map<std::string, int> errorCount;
-      Bitset edgeProducerBitset = kBitsetNone;
-      Bitset edgeConsumerBitset = kBitsetNone;
-      std::uint64_t producerCount =
-          std::min(kNumBitsetBits, std::max(1lu, producerConfigs.size()));
-      std::uint64_t consumerCount =
-          std::min(kNumBitsetBits, std::max(1lu, consumerConfigs.size()));
+      std::uint64_t producerCount = producerBitset->size();
+      std::uint64_t consumerCount = consumerBitset->size();
+      Bitset edgeProducerBitset(producerCount);
+      Bitset edgeConsumerBitset(consumerCount);
 
       // reshardOnEdge can only happen if an override exists for the edge. This
       // is because we have only one resolve step per chain in the current
@@ -211,8 +212,8 @@ bool ShardSolver::resolveStep() {
           }
         }
       }
-      if (paths.empty() || ((*producerBitset & edgeProducerBitset) == 0) ||
-          ((*consumerBitset & edgeConsumerBitset) == 0)) {
+      if (paths.empty() || !producerBitset->anyCommon(edgeProducerBitset) ||
+          !consumerBitset->anyCommon(edgeConsumerBitset)) {
 
         if (llvm::DebugFlag) {
           std::string errorStr;
@@ -324,7 +325,7 @@ bool ShardSolver::preprocessFirstOp() {
     return true;
   }
 
-  Bitset *firstOpBitset = getOrInsertBitset(firstOp, kBitsetAll);
+  Bitset *firstOpBitset = getOrInsertBitset(firstOp);
   const std::vector<OpConfig> &firstOpConfigs = getLegalConfigs(firstOp);
 
   bool hasValidConfig = false;
@@ -372,8 +373,8 @@ bool ShardSolver::insertReshard(const Edge &edge) {
   assert(memReconfigMap.count(edge) == 0);
 
   Operation *consumerOp = edge.consumerOp;
-  Bitset *consumerBitset = getOrInsertBitset(consumerOp, kBitsetAll);
-  *consumerBitset = kBitsetNone;
+  Bitset *consumerBitset = getOrInsertBitset(consumerOp);
+  consumerBitset->reset();
 
   const std::vector<OpConfig> &consumerConfigs = getLegalConfigs(consumerOp);
 
@@ -676,14 +677,14 @@ const ShardSolver::Bitset *ShardSolver::getBitset(Operation *op) const {
   return &bitsets[bitsetIds.at(op)];
 }
 
-ShardSolver::Bitset *ShardSolver::getOrInsertBitset(Operation *op,
-                                                    const Bitset &init) {
+ShardSolver::Bitset *ShardSolver::getOrInsertBitset(Operation *op) {
   auto match = bitsetIds.find(op);
   if (match == bitsetIds.end()) {
     BitsetId bitset_id = bitsets.size();
     bitsetIds.insert({op, bitset_id});
     auto *tmp = bitsets.data();
-    bitsets.push_back(init);
+    bitsets.emplace_back(std::max<size_t>(1, getLegalConfigs(op).size()),
+                         /*t=*/true);
 
     // Bitsets reallocated, pointers invalid.
     //
@@ -708,6 +709,40 @@ const std::vector<OpConfig> &ShardSolver::getLegalConfigs(Operation *op) const {
   return nullConfigs;
 }
 
+// Returns the output layout of an op in the chain: the selected config if
+// there is one, otherwise the first config still left in its bitset. Returns
+// null for ops outside of the chain.
+//
+// When checking one operand of a join, the other in-chain operands are pinned
+// to this layout rather than checked jointly over all their remaining
+// configs. A join can therefore be rejected even though another combination
+// of operand configs would fit; the solver then resolves it by spilling.
+//
+TTNNLayoutAttr ShardSolver::getCandidateOutputLayout(Operation *op) const {
+  if (!op || !shardedOps->contains(op)) {
+    return nullptr;
+  }
+
+  auto selectedIt = selectedOpConfig.find(op);
+  if (selectedIt != selectedOpConfig.end()) {
+    return selectedIt->second.outputLayout;
+  }
+
+  const std::vector<OpConfig> &configs = getLegalConfigs(op);
+  if (configs.empty()) {
+    return nullptr;
+  }
+
+  auto bitsetIt = bitsetIds.find(op);
+  if (bitsetIt != bitsetIds.end()) {
+    int first = bitsets[bitsetIt->second].find_first();
+    if (first >= 0 && static_cast<size_t>(first) < configs.size()) {
+      return configs[first].outputLayout;
+    }
+  }
+  return configs.front().outputLayout;
+}
+
 ShardSolver::RemainingConfigAttrs ShardSolver::at(Operation *op) const {
   auto configs = RemainingConfigAttrs(getLegalConfigs(op), *getBitset(op));
   assert(configs.begin() != configs.end());
@@ -775,23 +810,16 @@ llvm::Expected<TTNNLayoutAttr> ShardSolver::checkShardCompatible(
   //
   constexpr float tensorL1UsageCap = 0.8;
 
-  OpModel backend = mlir::dyn_cast<OpModel>(consumerOp);
-  if (!backend) {
-    // This function should not be called for ops without backend constraints.
-    llvm::report_fatal_error(
-        ("Backend constraints are not implemented for op " +
-         consumerOp->getName().getStringRef()));
-  }
-
   // Constraints are implemented for this op.
   //
   auto deviceAttr = mlir::tt::lookupDevice(consumerOp);
   assert(deviceAttr);
   auto workerGrid = deviceAttr.getWorkerGrid();
 
-  // Map consumer operands to DRAM interleave or provided producerLayout
-  // only one operand can be mapped to producerLayout, it's picked as first
-  // operand matching producerOp output shape.
+  // Map consumer operands to provided producerLayout, to the candidate L1
+  // layout of other producers in the chain (joins), or to DRAM interleave for
+  // producers outside of the chain. Only one operand can be mapped to
+  // producerLayout.
 
   uint32_t numOperands = consumerOp->getNumOperands();
   // Discard DPS operand since it's not used in runtime.
@@ -801,6 +829,7 @@ llvm::Expected<TTNNLayoutAttr> ShardSolver::checkShardCompatible(
   }
 
   std::vector<TTNNLayoutAttr> inputLayouts;
+  uint64_t otherOperandsL1Usage = 0;
 
   bool inputUnderCheckFound = false;
   for (uint32_t i = 0; i < numOperands; i++) {
@@ -819,10 +848,19 @@ llvm::Expected<TTNNLayoutAttr> ShardSolver::checkShardCompatible(
       continue;
     }
 
+    // Other in-chain producer of a join, its output stays in L1. It is pinned
+    // to a single candidate layout, see getCandidateOutputLayout.
+    if (TTNNLayoutAttr chainLayout =
+            getCandidateOutputLayout(operand.getDefiningOp())) {
+      inputLayouts.push_back(chainLayout);
+      otherOperandsL1Usage += chainLayout.getShardSizeInBytes();
+      continue;
+    }
+
     RankedTensorType input = mlir::cast<RankedTensorType>(operand.getType());
 
-    // TODO(odjuricic): Hardcode other operands to TILE DRAM INTERLEAVED for
-    // now. This will change once fork joins are supported.
+    // TODO(odjuricic): Hardcode operands from outside of the chain to TILE
+    // DRAM INTERLEAVED for now.
     Type elementType = input.getElementType();
     if (!llvm::isa<TileType>(elementType)) {
       elementType = TileType::get(input.getElementType());
@@ -839,7 +877,8 @@ llvm::Expected<TTNNLayoutAttr> ShardSolver::checkShardCompatible(
 
   llvm::Expected<
       std::tuple<size_t, size_t, size_t, ::mlir::tt::ttnn::TTNNLayoutAttr>>
-      l1UsageExp = backend.getOpConstraints(inputLayouts, consumerConfig);
+      l1UsageExp = opModelBackend->getOpConstraints(consumerOp, inputLayouts,
+                                                    consumerConfig);
 
   if (!l1UsageExp) {
     llvm::Error error = l1UsageExp.takeError();
@@ -869,8 +908,9 @@ llvm::Expected<TTNNLayoutAttr> ShardSolver::checkShardCompatible(
 
   uint64_t producerL1OutputUsage = producerLayout.getShardSizeInBytes();
 
-  bool l1UsageValid = (producerL1OutputUsage + outputTensorUsage +
-                       cBUsagePeak) < tensorL1UsageCap * usableL1CacheSize;
+  bool l1UsageValid =
+      (producerL1OutputUsage + otherOperandsL1Usage + outputTensorUsage +
+       cBUsagePeak) < tensorL1UsageCap * usableL1CacheSize;
 
   if (!l1UsageValid) {
     TTMLIR_DEBUG(ttmlir::LogComponent::Optimizer,
@@ -15,6 +15,7 @@
 #include "ttmlir/Dialect/TTNN/Transforms/Passes.h"
 #include "ttmlir/Transforms/Passes.h"
 
+#include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
 
@@ -36,9 +37,10 @@ void createTTNNPipelineTTIRPasses(
   pm.addPass(mlir::tt::createTTPopulateArgumentTypes(options.argumentTypeMap));
   pm.addPass(mlir::createCanonicalizerPass());
   if (options.enableFusing) {
-    pm.addPass(mlir::tt::ttir::createTTIRFusing());
+    pm.addNestedPass<func::FuncOp>(mlir::tt::ttir::createTTIRFusing());
   }
-  pm.addPass(mlir::tt::createTTIRToTTIRDecompositionPass());
+  pm.addNestedPass<func::FuncOp>(
+      mlir::tt::createTTIRToTTIRDecompositionPass());
   pm.addPass(mlir::createCanonicalizerPass());
 
   // Inlines all private functions. I.e flattens the program into the main
@@ -46,12 +48,14 @@ void createTTNNPipelineTTIRPasses(
   pm.addPass(mlir::createInlinerPass());
 
   // Flattening sliding window ops for compatibility with conversion to TTNN
-  pm.addPass(mlir::tt::ttir::createTTIRFlattenSlidingWindow());
+  pm.addNestedPass<func::FuncOp>(
+      mlir::tt::ttir::createTTIRFlattenSlidingWindow());
 
   // Add pass to erase inverse ops. This is enabled by default
   // while the pass is experimental.
   if (options.eraseInverseOpsEnabled) {
-    pm.addPass(mlir::tt::ttir::createTTIREraseInverseOps());
+    pm.addNestedPass<func::FuncOp>(
+        mlir::tt::ttir::createTTIREraseInverseOps());
   }
 }
 
@@ -69,6 +73,9 @@ void createTTNNPipelineAnalysisPasses(
         options.memoryLayoutAnalysisPolicy;
     optimizerOptions.maxLegalLayouts = options.maxLegalLayouts;
     optimizerOptions.rowMajorEnabled = options.rowMajorEnabled;
+    optimizerOptions.opModelCachePath = options.opModelCachePath;
+    optimizerOptions.opModelBackend = options.opModelBackend;
+    optimizerOptions.reportSpills = options.reportSpills;
     pm.addPass(mlir::tt::ttnn::createTTNNOptimizer(optimizerOptions));
     pm.addPass(mlir::tt::ttnn::createTTNNPrepareConv2dWeights());
   }
@@ -97,24 +104,31 @@ void createTTNNPipelineWorkaroundPass(
   if (options.optimizerPassEnabled) {
     workaroundOptions.layoutWorkaroundsEnabled = false;
   }
-  pm.addPass(createTTNNWorkarounds(workaroundOptions));
+  pm.addNestedPass<func::FuncOp>(createTTNNWorkarounds(workaroundOptions));
   pm.addPass(mlir::createCanonicalizerPass());
 }
 
 void createTTNNPipelineLayoutDecompositionPass(
     OpPassManager &pm, const TTIRToTTNNBackendPipelineOptions &options) {
-  pm.addPass(createTTNNDecomposeLayouts());
+  if (options.layoutCoalescingEnabled) {
+    pm.addNestedPass<func::FuncOp>(createTTNNCoalesceLayouts());
+  }
+  pm.addNestedPass<func::FuncOp>(createTTNNDecomposeLayouts());
 }
 
 void createTTNNPipelineDeallocPass(
     OpPassManager &pm, const TTIRToTTNNBackendPipelineOptions &options) {
-  pm.addPass(createTTNNDeallocate());
+  if (options.memoryAwareSchedulingEnabled) {
+    pm.addNestedPass<func::FuncOp>(createTTNNMemoryAwareSchedule());
+  }
+  pm.addNestedPass<func::FuncOp>(createTTNNDeallocate());
 }
 
 void createTTNNPipelineTTIRImplicitBroadcastFoldPass(
     OpPassManager &pm, const TTIRToTTNNBackendPipelineOptions &options) {
   if (options.implicitBroadcastFoldingEnabled) {
-    pm.addPass(mlir::tt::ttir::createTTIRImplicitBroadcastFold());
+    pm.addNestedPass<func::FuncOp>(
+        mlir::tt::ttir::createTTIRImplicitBroadcastFold());
   }
 }
 
@@ -140,7 +154,7 @@ void createTTIRToTTNNBackendPipeline(
 
   createTTNNPipelineLoweringPasses(devicePm, options);
   if (options.enableFusing) {
-    devicePm.addPass(tt::ttnn::createTTNNFusing());
+    devicePm.addNestedPass<func::FuncOp>(tt::ttnn::createTTNNFusing());
   }
   createTTNNPipelineWorkaroundPass(devicePm, options);
   if (options.enableConstEval) {
@@ -151,6 +165,11 @@ void createTTIRToTTNNBackendPipeline(
   // split during the analysis passes.
   if (options.enableConstEval) {
     devicePm.addPass(transforms::createConstEvalHoistTransform());
+    if (options.constEvalFoldingEnabled) {
+      TTNNConstEvalFoldOptions constEvalFoldOptions;
+      constEvalFoldOptions.maxFoldedBytes = options.constEvalFoldingMaxBytes;
+      devicePm.addPass(createTTNNConstEvalFold(constEvalFoldOptions));
+    }
   }
   createTTNNPipelineLayoutDecompositionPass(devicePm, options);
   createTTNNPipelineDeallocPass(devicePm, options);
@@ -159,6 +178,7 @@ void createTTIRToTTNNBackendPipeline(
   OpPassManager &cpuPm = pm.nest<tt::CPUModuleOp>().nest<mlir::ModuleOp>();
   cpuPm.addPass(createConvertTTIRToLinalgPass());
   ttir::LinalgToLLVMPipelineOptions linalgToLLLVMOptions;
+  linalgToLLLVMOptions.vectorWidth = options.cpuVectorWidth;
   ttir::createLinalgToLLVMPipeline(cpuPm, linalgToLLLVMOptions);
   cpuPm.addPass(llvm_util::createLLVMEmitCallingConventionWrapperFuncs());
 }
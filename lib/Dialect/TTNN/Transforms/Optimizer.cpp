@@ -11,6 +11,8 @@
 #include "ttmlir/Dialect/TTNN/Analysis/MemoryLayoutAnalysis.h"
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
 #include "ttmlir/Dialect/TTNN/Analysis/OpConfigAnalysis.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpCostModel.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
 #include "ttmlir/Dialect/TTNN/Analysis/ScalarDataTypeAnalysis.h"
 #include "ttmlir/Dialect/TTNN/Analysis/ShardSolver.h"
 #include "ttmlir/Dialect/TTNN/Analysis/TensorLayouts.h"
@@ -20,6 +22,7 @@
 #include "ttmlir/Dialect/TTNN/Transforms/Passes.h"
 #include "ttmlir/Dialect/TTNN/Utils/PassOverrides.h"
 #include "ttmlir/Dialect/TTNN/Utils/Utils.h"
+#include "ttmlir/OpModel/TTNN/OpModelCache.h"
 #include "ttmlir/Support/Logger.h"
 #include "ttmlir/Utils.h"
 
@@ -103,6 +106,9 @@ public:
     memoryLayoutAnalysisPolicy = std::move(options.memoryLayoutAnalysisPolicy);
     maxLegalLayouts = std::move(options.maxLegalLayouts);
     rowMajorEnabled = std::move(options.rowMajorEnabled);
+    opModelCachePath = std::move(options.opModelCachePath);
+    opModelBackend = std::move(options.opModelBackend);
+    reportSpills = std::move(options.reportSpills);
   }
 
 protected:
@@ -149,6 +155,23 @@ protected:
       ::llvm::cl::desc(
           "Enable row major layout generation in legal layout analysis."),
       ::llvm::cl::init(false)};
+  ::mlir::Pass::Option<std::string> opModelCachePath{
+      *this, OptionNames::opModelCachePath,
+      ::llvm::cl::desc("Path to a file used to persist op model query results "
+                       "across compiler invocations."),
+      ::llvm::cl::init("")};
+  ::mlir::Pass::Option<mlir::tt::OpModelBackendType,
+                       mlir::tt::OpModelBackendTypeParser>
+      opModelBackend{
+          *this, OptionNames::opModelBackend,
+          ::llvm::cl::desc("Op model backend used by the optimizer: device, "
+                           "analytical or compare."),
+          ::llvm::cl::init(OpModelBackendType::Device)};
+  ::mlir::Pass::Option<bool> reportSpills{
+      *this, OptionNames::reportSpills,
+      ::llvm::cl::desc("Emit a remark with the number of L1 chain outputs "
+                       "spilled to DRAM."),
+      ::llvm::cl::init(false)};
 
 private:
   friend std::unique_ptr<::mlir::Pass> createTTNNOptimizer() {
@@ -193,6 +216,32 @@ public:
     ChipDescAttr chipDesc = systemDesc.getChipDescs()[0];
     llvm::DenseMap<Operation *, std::vector<OpConfig>> legalConfigs;
 
+    // Identical op model queries are served from the op model cache. Reuse
+    // results persisted by previous compiles, if requested.
+    //
+    op_model::ttnn::OpModelCache &opModelCache =
+        op_model::ttnn::OpModelCache::getInstance();
+    opModelCache.resetStats();
+    std::string opModelCacheFingerprint =
+        op_model::ttnn::OpModelCache::getFingerprint(systemDesc);
+    if (!opModelCachePath.empty()) {
+      if (llvm::Error error = opModelCache.loadFromFile(
+              opModelCachePath, opModelCacheFingerprint)) {
+        moduleOp->emitWarning() << llvm::toString(std::move(error));
+      }
+    }
+
+    // Op constraints and runtimes are queried through the selected backend.
+    // Only the device backend needs a device to be opened.
+    //
+    std::shared_ptr<OpModelBackend> backend =
+        createOpModelBackend(opModelBackend);
+    if (backend->getKind() != opModelBackend) {
+      moduleOp->emitWarning()
+          << "Device op model is not available, using the analytical op "
+             "model without comparison";
+    }
+
     // Step 1: Run ScalarDataTypeAnalysis to collect all scalar types used in
     // the graph
     ScalarDataTypeAnalysis scalarDataTypeAnalysis =
@@ -260,6 +309,7 @@ public:
     llvm::DenseMap<func::FuncOp, llvm::SmallVector<Operation *>> opSchedule;
     llvm::DenseMap<Edge, MemReconfigEntry> memReconfigEntryMap;
     std::vector<Operation *> spillToDramOps;
+    llvm::DenseSet<Edge> l1ChainEdges;
 
     // Extract override resharding edges
     //
@@ -273,12 +323,18 @@ public:
           getAnalysis<MemoryLayoutAnalysis>();
       memoryLayoutAnalysis.init(MemoryLayoutAnalysisInput(
           &tensorTypePossibleLayouts, legalConfigs, chipDesc.getUsableL1Size(),
-          overrideReshardEdges, memoryLayoutAnalysisPolicy));
+          overrideReshardEdges, memoryLayoutAnalysisPolicy, backend));
       legalConfigs = memoryLayoutAnalysis.getResult().legalConfigs;
       opSchedule = memoryLayoutAnalysis.getResult().schedule;
       memReconfigEntryMap =
           memoryLayoutAnalysis.getResult().memReconfigEntryMap;
       spillToDramOps = memoryLayoutAnalysis.getResult().spillToDramOps;
+      l1ChainEdges = memoryLayoutAnalysis.getResult().l1ChainEdges;
+
+      if (reportSpills) {
+        moduleOp->emitRemark()
+            << spillToDramOps.size() << " L1 chain outputs spilled to DRAM";
+      }
     }
 
     // Manually overriden resharding edges should be added to the
@@ -295,7 +351,38 @@ public:
     // Pick optimal op configuration.
     //
     OpConfigAnalysis opConfigAnalysis = getAnalysis<OpConfigAnalysis>();
-    opConfigAnalysis.init(OpConfigAnalysisInput(std::move(legalConfigs)));
+    OpConfigAnalysisInput opConfigAnalysisInput(std::move(legalConfigs));
+    opConfigAnalysisInput.costModel =
+        std::make_shared<OpModelRuntimeCostModel>(backend);
+    opConfigAnalysis.init(opConfigAnalysisInput);
+
+    op_model::ttnn::OpModelCache::Stats opModelCacheStats =
+        opModelCache.getStats();
+    TTMLIR_DEBUG(ttmlir::LogComponent::Optimizer,
+                 "OpModelCache: constraints {0} hits / {1} misses, runtime "
+                 "{2} hits / {3} misses, {4} entries",
+                 opModelCacheStats.constraintsHits,
+                 opModelCacheStats.constraintsMisses,
+                 opModelCacheStats.runtimeHits, opModelCacheStats.runtimeMisses,
+                 opModelCache.size());
+
+    if (auto *comparingBackend =
+            mlir::dyn_cast<ComparingOpModelBackend>(backend.get())) {
+      const ComparingOpModelBackend::Stats &stats =
+          comparingBackend->getStats();
+      moduleOp->emitRemark()
+          << "Analytical op model disagrees with the device op model on "
+          << stats.numMismatches() << " of " << stats.numCompared
+          << " constraint queries (" << stats.numValidityMismatches
+          << " validity, " << stats.numUsageMismatches << " L1 usage)";
+    }
+
+    if (!opModelCachePath.empty()) {
+      if (llvm::Error error = opModelCache.saveToFile(
+              opModelCachePath, opModelCacheFingerprint)) {
+        moduleOp->emitWarning() << llvm::toString(std::move(error));
+      }
+    }
 
     // Pure application of determined grid sizes to the operations.
     // No further analysis.
@@ -430,7 +517,7 @@ public:
         processMemReconfigEdges(memReconfigEntryMap);
       }
 
-      processSpillOps(spillToDramOps);
+      processSpillOps(spillToDramOps, l1ChainEdges);
 
       // Update the function type to reflect the updated return operation's
       // result types.
@@ -642,7 +729,8 @@ private:
     }
   }
 
-  void processSpillOps(const std::vector<Operation *> &spillToDramOps) {
+  void processSpillOps(const std::vector<Operation *> &spillToDramOps,
+                       const llvm::DenseSet<Edge> &l1ChainEdges) {
     for (Operation *op : spillToDramOps) {
       TTMLIR_TRACE(ttmlir::LogComponent::Optimizer, "Processing spill op: {}",
                    op->getName());
@@ -683,8 +771,12 @@ private:
                    "Inserted spill to DRAM prevLayout: {}\nnewLayout: {}",
                    layoutAttr, newLayout);
 
-      for (auto &use : op->getResult(0).getUses()) {
-        if (use.getOwner() != toLayoutOp) {
+      // Users in the same L1 chain as the op keep reading its L1 output.
+      //
+      for (auto &use : llvm::make_early_inc_range(op->getResult(0).getUses())) {
+        if (use.getOwner() != toLayoutOp &&
+            !l1ChainEdges.contains(
+                Edge(op, use.getOwner(), use.getOperandNumber()))) {
           use.getOwner()->setOperand(use.getOperandNumber(),
                                      toLayoutOp->getResult(0));
         }
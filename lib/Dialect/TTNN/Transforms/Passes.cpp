@@ -66,75 +66,73 @@ public:
   }
 
   void runOnOperation() final {
-    ModuleOp moduleOp = getOperation();
+    func::FuncOp func = getOperation();
     IRRewriter rewriter(&getContext());
 
-    moduleOp->walk([&](func::FuncOp func) {
-      if (func.isDeclaration()) {
-        return;
-      }
-      assert(func.getBody().hasOneBlock() &&
-             "found func that didn't have one block!");
-      Liveness liveness(func.getOperation());
-      const LivenessBlockInfo *livenessInfo =
-          liveness.getLiveness(&func.getBody().front());
-
-      // Const eval subgraphs may not dealloc their params since they don't own
-      // them.
-      if (!ttmlir::utils::isConstEvalFunc(func)) {
-        // Handle func op input parameters
-        for (BlockArgument arg : func.getArguments()) {
-          if (!isa<RankedTensorType>(arg.getType())) {
-            continue;
-          }
-          Operation *lastOp = getLastValueUsageOp(livenessInfo, arg);
-
-          if (isa<func::ReturnOp>(lastOp)) {
-            continue;
-          }
-
-          rewriter.setInsertionPointAfter(lastOp);
-          rewriter.create<DeallocateOp>(lastOp->getLoc(), arg);
+    if (func.isDeclaration()) {
+      return;
+    }
+    assert(func.getBody().hasOneBlock() &&
+           "found func that didn't have one block!");
+    Liveness liveness(func.getOperation());
+    const LivenessBlockInfo *livenessInfo =
+        liveness.getLiveness(&func.getBody().front());
+
+    // Const eval subgraphs may not dealloc their params since they don't own
+    // them.
+    if (!ttmlir::utils::isConstEvalFunc(func)) {
+      // Handle func op input parameters
+      for (BlockArgument arg : func.getArguments()) {
+        if (!isa<RankedTensorType>(arg.getType())) {
+          continue;
         }
+        Operation *lastOp = getLastValueUsageOp(livenessInfo, arg);
+
+        if (isa<func::ReturnOp>(lastOp)) {
+          continue;
+        }
+
+        rewriter.setInsertionPointAfter(lastOp);
+        rewriter.create<DeallocateOp>(lastOp->getLoc(), arg);
+      }
+    }
+
+    // Handle non DPS ops which do not store function result and are used to
+    // allocate tensors. DPS ops are handled via ttnn::EmptyOp.
+    //
+    func->walk([&](Operation *op) {
+      if (isa<DestinationStyleOpInterface>(op)) {
+        return;
       }
 
-      // Handle non DPS ops which do not store function result and are used to
-      // allocate tensors. DPS ops are handled via ttnn::EmptyOp.
+      // Skip ops which do not have results.
       //
-      func->walk([&](Operation *op) {
-        if (isa<DestinationStyleOpInterface>(op)) {
-          return;
-        }
+      if (op->getNumResults() == 0) {
+        return;
+      }
 
-        // Skip ops which do not have results.
+      // Iterate over all results of the op.
+      //
+      for (OpResult result : op->getResults()) {
+        // Check if result is ranked tensor type.
         //
-        if (op->getNumResults() == 0) {
-          return;
+        if (!isa<RankedTensorType>(result.getType())) {
+          continue;
         }
 
-        // Iterate over all results of the op.
-        //
-        for (OpResult result : op->getResults()) {
-          // Check if result is ranked tensor type.
-          //
-          if (!isa<RankedTensorType>(result.getType())) {
-            continue;
-          }
+        RankedTensorType resultTy =
+            mlir::cast<RankedTensorType>(result.getType());
+        assert(resultTy.getEncoding());
 
-          RankedTensorType resultTy =
-              mlir::cast<RankedTensorType>(result.getType());
-          assert(resultTy.getEncoding());
+        Operation *lastOp = getLastValueUsageOp(livenessInfo, result);
 
-          Operation *lastOp = getLastValueUsageOp(livenessInfo, result);
-
-          if (isa<func::ReturnOp>(lastOp)) {
-            continue;
-          }
-
-          rewriter.setInsertionPointAfter(lastOp);
-          rewriter.create<DeallocateOp>(lastOp->getLoc(), result);
+        if (isa<func::ReturnOp>(lastOp)) {
+          continue;
         }
-      });
+
+        rewriter.setInsertionPointAfter(lastOp);
+        rewriter.create<DeallocateOp>(lastOp->getLoc(), result);
+      }
     });
   }
 };
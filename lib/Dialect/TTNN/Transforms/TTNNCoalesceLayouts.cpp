@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+#include "ttmlir/Dialect/TTNN/Transforms/Passes.h"
+#include "ttmlir/Dialect/TTNN/Utils/TransformUtils.h"
+#include "ttmlir/Support/Logger.h"
+
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "llvm/ADT/SetVector.h"
+
+#include <algorithm>
+
+namespace mlir::tt::ttnn {
+#define GEN_PASS_DEF_TTNNCOALESCELAYOUTS
+#include "ttmlir/Dialect/TTNN/Transforms/Passes.h.inc"
+
+namespace {
+// Relative cost per byte of the steps a layout conversion is decomposed to.
+// Host to device transfers and layout changes or typecasts done on the host
+// are much slower than data movement and compute on the device.
+//
+constexpr uint64_t kDeviceOpCost = 1;
+constexpr uint64_t kTransferCost = 4;
+constexpr uint64_t kHostOpCost = 8;
+
+// Whether every value of `from` is exactly representable in `to`, so that
+// converting back yields the original tensor.
+//
+bool isLosslessDataTypeConversion(DataType from, DataType to) {
+  if (from == to) {
+    return true;
+  }
+
+  switch (to) {
+  case DataType::Float32:
+    return from == DataType::Float16 || from == DataType::BFloat16;
+  case DataType::UInt16:
+    return from == DataType::UInt8;
+  case DataType::UInt32:
+  case DataType::Int32:
+    return from == DataType::UInt8 || from == DataType::UInt16;
+  default:
+    return false;
+  }
+}
+
+TTNNLayoutAttr getLayout(Value value) {
+  return mlir::cast<TTNNLayoutAttr>(
+      mlir::cast<RankedTensorType>(value.getType()).getEncoding());
+}
+
+bool isLosslessConversion(ToLayoutOp op) {
+  return isLosslessDataTypeConversion(getLayout(op.getInput()).getDataType(),
+                                      getLayout(op.getResult()).getDataType());
+}
+
+// Estimates the cost of converting `from` to `to`, following the choices the
+// decompose layouts pass makes: tilizing and untilizing run on device only for
+// bf16, and typecasts run on device only for tilized device tensors.
+//
+uint64_t getConversionCost(RankedTensorType fromType, RankedTensorType toType) {
+  auto from = mlir::cast<TTNNLayoutAttr>(fromType.getEncoding());
+  auto to = mlir::cast<TTNNLayoutAttr>(toType.getEncoding());
+  bool fromHost = from.isSystemBufferType();
+  bool toHost = to.isSystemBufferType();
+
+  uint64_t cost = 0;
+  if (fromHost != toHost) {
+    cost += kTransferCost;
+  }
+
+  if (from.getLayout() != to.getLayout()) {
+    DataType layoutDataType = fromHost ? to.getDataType() : from.getDataType();
+    if (fromHost && toHost) {
+      cost += kHostOpCost;
+    } else if (layoutDataType == DataType::BFloat16) {
+      cost += kDeviceOpCost;
+    } else {
+      // Device tensors are moved to the host to change their layout.
+      cost += kHostOpCost;
+      if (!fromHost && !toHost) {
+        cost += 2 * kTransferCost;
+      }
+    }
+  }
+
+  if (from.getDataType() != to.getDataType()) {
+    cost += !toHost && to.isTiled() ? kDeviceOpCost : kHostOpCost;
+  }
+
+  if (!fromHost && !toHost &&
+      (from.getBufferType() != to.getBufferType() ||
+       from.getMemLayoutOpt() != to.getMemLayoutOpt() ||
+       from.getGrid() != to.getGrid())) {
+    cost += kDeviceOpCost;
+  }
+
+  uint64_t elementSize =
+      std::max(getElementSizeBytes(from.getScalarElementType()),
+               getElementSizeBytes(to.getScalarElementType()));
+  return cost * toType.getNumElements() * elementSize;
+}
+
+uint64_t getTotalConversionCost(func::FuncOp func) {
+  uint64_t cost = 0;
+  func.walk([&](ToLayoutOp op) {
+    cost += getConversionCost(op.getInput().getType(), op.getType());
+  });
+  return cost;
+}
+} // namespace
+
+class TTNNCoalesceLayouts
+    : public impl::TTNNCoalesceLayoutsBase<TTNNCoalesceLayouts> {
+public:
+  using impl::TTNNCoalesceLayoutsBase<
+      TTNNCoalesceLayouts>::TTNNCoalesceLayoutsBase;
+
+  void runOnOperation() final {
+    func::FuncOp func = getOperation();
+    if (func.isDeclaration()) {
+      return;
+    }
+
+    size_t numOpsBefore = 0;
+    func.walk([&](ToLayoutOp) { numOpsBefore++; });
+    uint64_t costBefore = getTotalConversionCost(func);
+
+    IRRewriter rewriter(&getContext());
+    for (Block &block : func.getBody()) {
+      for (ToLayoutOp op :
+           llvm::make_early_inc_range(block.getOps<ToLayoutOp>())) {
+        coalesce(op, rewriter);
+      }
+
+      // Conversions whose consumers were moved to other sources are dead now.
+      for (Operation &op : llvm::make_early_inc_range(llvm::reverse(block))) {
+        if (isa<ToLayoutOp>(op) && op.use_empty()) {
+          rewriter.eraseOp(&op);
+        }
+      }
+    }
+
+    if (reportCoalescing) {
+      size_t numOpsAfter = 0;
+      func.walk([&](ToLayoutOp) { numOpsAfter++; });
+      func.emitRemark() << "Layout conversions coalesced: " << numOpsBefore
+                        << " -> " << numOpsAfter << " ops, estimated cost "
+                        << costBefore << " -> "
+                        << getTotalConversionCost(func);
+    }
+  }
+
+private:
+  // Returns the values defined before `op` that hold the same data as its
+  // input. These are the values connected to the input through ToLayoutOps
+  // that lose no precision, in either direction. A conversion is a copy, so
+  // once one of these values is written in place, e.g. by a KV cache update,
+  // only the conversions made after the write still match.
+  //
+  llvm::SetVector<Value> getEquivalentSources(ToLayoutOp op) const {
+    llvm::SetVector<Value> sources = collectSources(op, nullptr);
+    for (Operation *prev = op->getPrevNode(); prev;
+         prev = prev->getPrevNode()) {
+      if (mayWriteTo(prev, sources)) {
+        return collectSources(op, prev);
+      }
+    }
+    return sources;
+  }
+
+  // Returns the values connected to the input of `op` through lossless
+  // ToLayoutOps placed after `lastWrite`, if set, and before `op`.
+  //
+  static llvm::SetVector<Value> collectSources(ToLayoutOp op,
+                                               Operation *lastWrite) {
+    auto isAfterLastWrite = [&](Operation *def) {
+      return !lastWrite || (def->getBlock() == lastWrite->getBlock() &&
+                            lastWrite->isBeforeInBlock(def));
+    };
+
+    Value root = op.getInput();
+    while (auto producer = root.getDefiningOp<ToLayoutOp>()) {
+      if (!isLosslessConversion(producer) || !isAfterLastWrite(producer)) {
+        break;
+      }
+      root = producer.getInput();
+    }
+
+    llvm::SetVector<Value> sources;
+    sources.insert(root);
+    for (size_t i = 0; i < sources.size(); ++i) {
+      for (Operation *user : sources[i].getUsers()) {
+        auto userOp = dyn_cast<ToLayoutOp>(user);
+        if (userOp && userOp != op && userOp->getBlock() == op->getBlock() &&
+            userOp->isBeforeInBlock(op) && isAfterLastWrite(userOp) &&
+            isLosslessConversion(userOp)) {
+          sources.insert(userOp.getResult());
+        }
+      }
+    }
+    return sources;
+  }
+
+  // Returns true if `op` may write to one of `values`. Writes that do not
+  // name the value, like those of in-place ops, may write to any of them.
+  //
+  static bool mayWriteTo(Operation *op, const llvm::SetVector<Value> &values) {
+    auto effectOp = dyn_cast<MemoryEffectOpInterface>(op);
+    if (!effectOp) {
+      return false;
+    }
+
+    SmallVector<MemoryEffects::EffectInstance> effects;
+    effectOp.getEffects(effects);
+    return llvm::any_of(effects, [&](const MemoryEffects::EffectInstance &e) {
+      return isa<MemoryEffects::Write>(e.getEffect()) &&
+             (!e.getValue() || values.contains(e.getValue()));
+    });
+  }
+
+  // Returns the last op of `block` that uses `value`, directly or from a
+  // nested region, or nullptr if there is none.
+  //
+  static Operation *getLastUserInBlock(Value value, Block *block) {
+    Operation *lastUser = nullptr;
+    for (Operation *user : value.getUsers()) {
+      Operation *ancestor = block->findAncestorOpInBlock(*user);
+      if (ancestor && (!lastUser || lastUser->isBeforeInBlock(ancestor))) {
+        lastUser = ancestor;
+      }
+    }
+    return lastUser;
+  }
+
+  // Returns true if using `source` in place of `op`, or as its input when
+  // `fold` is false, keeps an L1 tensor alive past its last use. The L1 usage
+  // the optimizer budgeted for assumes these tensors are freed after their last
+  // use, so extending their lifetime may run out of L1 at runtime.
+  //
+  static bool extendsL1LiveRange(Value source, ToLayoutOp op, bool fold) {
+    // Arguments are owned by the caller and stay alive for the whole body.
+    if (mlir::isa<BlockArgument>(source) ||
+        !getLayout(source).hasL1BufferType()) {
+      return false;
+    }
+
+    Block *block = op->getBlock();
+    Operation *newLastUser = op;
+    if (fold) {
+      if (Operation *lastUser = getLastUserInBlock(op.getResult(), block)) {
+        newLastUser = lastUser;
+      }
+    }
+
+    Operation *lastUser = getLastUserInBlock(source, block);
+    return !lastUser || lastUser->isBeforeInBlock(newLastUser);
+  }
+
+  void coalesce(ToLayoutOp op, IRRewriter &rewriter) const {
+    RankedTensorType resultType = op.getType();
+    Value bestSource = op.getInput();
+    uint64_t bestCost = getConversionCost(op.getInput().getType(), resultType);
+
+    for (Value source : getEquivalentSources(op)) {
+      auto sourceType = mlir::cast<RankedTensorType>(source.getType());
+      if (extendsL1LiveRange(source, op, sourceType == resultType)) {
+        continue;
+      }
+
+      if (sourceType == resultType) {
+        bestSource = source;
+        bestCost = 0;
+        break;
+      }
+
+      uint64_t cost = getConversionCost(sourceType, resultType);
+      if (cost < bestCost) {
+        bestSource = source;
+        bestCost = cost;
+      }
+    }
+
+    if (bestSource.getType() == resultType) {
+      TTMLIR_DEBUG(ttmlir::LogComponent::General,
+                   "Coalesce layouts: folding {} into {}", op, bestSource);
+      rewriter.replaceOp(op, bestSource);
+      return;
+    }
+
+    if (bestSource == op.getInput()) {
+      return;
+    }
+
+    TTMLIR_DEBUG(ttmlir::LogComponent::General,
+                 "Coalesce layouts: converting {} from {}", op, bestSource);
+    // Conversions from device tensors may not carry a device, which is needed
+    // once the source is on the host.
+    Value device = op.getDevice();
+    if (!device && !getLayout(op.getResult()).isSystemBufferType()) {
+      device = utils::getOrInsertDevice(rewriter, op);
+    }
+    rewriter.modifyOpInPlace(op, [&]() {
+      op.getInputMutable().assign(bestSource);
+      if (device) {
+        op.getDeviceMutable().assign(device);
+      }
+    });
+  }
+};
+} // namespace mlir::tt::ttnn
@@ -0,0 +1,684 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TT/IR/TTOps.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpCostModel.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+#include "ttmlir/Dialect/TTNN/Transforms/Passes.h"
+#include "ttmlir/Dialect/TTNN/Utils/TransformUtils.h"
+#include "ttmlir/Support/Logger.h"
+#include "ttmlir/Utils.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/PatternMatch.h"
+#include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mlir::tt::ttnn {
+#define GEN_PASS_DEF_TTNNCONSTEVALFOLD
+#include "ttmlir/Dialect/TTNN/Transforms/Passes.h.inc"
+
+namespace {
+// Values of a tensor in row major order. Every supported element type is
+// exactly representable as a double.
+//
+struct HostTensor {
+  llvm::SmallVector<int64_t> shape;
+  std::vector<double> values;
+};
+} // namespace
+
+// Element type the tensor is stored in on the device, which may differ from
+// the tensor type's element type.
+//
+static Type getStorageElementType(Value value) {
+  auto type = mlir::cast<RankedTensorType>(value.getType());
+  if (auto layout = mlir::dyn_cast_if_present<TTNNLayoutAttr>(
+          type.getEncoding())) {
+    return layout.getScalarElementType();
+  }
+  return type.getElementType();
+}
+
+static bool isUnsignedType(IntegerType type) {
+  return type.isUnsigned() || type.getWidth() == 1;
+}
+
+static bool isFoldableElementType(Type type) {
+  if (auto intType = mlir::dyn_cast<IntegerType>(type)) {
+    return intType.getWidth() <= 32;
+  }
+  if (auto floatType = mlir::dyn_cast<FloatType>(type)) {
+    return floatType.getWidth() <= 32;
+  }
+  return false;
+}
+
+static double roundToElementType(double value, Type elementType) {
+  if (auto floatType = mlir::dyn_cast<FloatType>(elementType)) {
+    llvm::APFloat result(value);
+    bool losesInfo = false;
+    result.convert(floatType.getFloatSemantics(),
+                   llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+    return result.convertToDouble();
+  }
+
+  auto intType = mlir::cast<IntegerType>(elementType);
+  unsigned width = intType.getWidth();
+  double min = isUnsignedType(intType) ? 0.0 : -std::ldexp(1.0, width - 1);
+  double max = isUnsignedType(intType) ? std::ldexp(1.0, width) - 1
+                                       : std::ldexp(1.0, width - 1) - 1;
+  return std::clamp(std::trunc(value), min, max);
+}
+
+static double toDouble(const llvm::APInt &bits, Type elementType) {
+  if (auto floatType = mlir::dyn_cast<FloatType>(elementType)) {
+    return llvm::APFloat(floatType.getFloatSemantics(), bits)
+        .convertToDouble();
+  }
+  return isUnsignedType(mlir::cast<IntegerType>(elementType))
+             ? static_cast<double>(bits.getZExtValue())
+             : static_cast<double>(bits.getSExtValue());
+}
+
+// Resource blobs hold every element, little endian, in as many bytes as its
+// bit width needs.
+//
+static std::optional<std::vector<double>>
+readResourceElements(DenseResourceElementsAttr resource) {
+  ShapedType type = resource.getType();
+  Type elementType = type.getElementType();
+  if (!isFoldableElementType(elementType) ||
+      elementType.getIntOrFloatBitWidth() % 8 != 0) {
+    return std::nullopt;
+  }
+
+  unsigned width = elementType.getIntOrFloatBitWidth();
+  size_t elementBytes = width / 8;
+  ArrayRef<char> data = resource.getData();
+  if (data.size() != type.getNumElements() * elementBytes) {
+    return std::nullopt;
+  }
+
+  std::vector<double> values;
+  values.reserve(type.getNumElements());
+  for (size_t offset = 0; offset < data.size(); offset += elementBytes) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, data.data() + offset, elementBytes);
+    values.push_back(toDouble(llvm::APInt(width, bits), elementType));
+  }
+  return values;
+}
+
+static std::optional<std::vector<double>> readElements(ElementsAttr attr) {
+  if (auto resource = mlir::dyn_cast<DenseResourceElementsAttr>(attr)) {
+    return readResourceElements(resource);
+  }
+  auto dense = mlir::dyn_cast<DenseElementsAttr>(attr);
+  if (!dense) {
+    return std::nullopt;
+  }
+
+  std::vector<double> values;
+  values.reserve(dense.getNumElements());
+  if (mlir::isa<FloatType>(dense.getElementType())) {
+    for (const llvm::APFloat &value : dense.getValues<llvm::APFloat>()) {
+      values.push_back(value.convertToDouble());
+    }
+  } else if (mlir::isa<IntegerType>(dense.getElementType())) {
+    for (const llvm::APInt &value : dense.getValues<llvm::APInt>()) {
+      values.push_back(toDouble(value, dense.getElementType()));
+    }
+  } else {
+    return std::nullopt;
+  }
+  return values;
+}
+
+static DenseElementsAttr materialize(const HostTensor &tensor,
+                                     Type elementType) {
+  auto type = RankedTensorType::get(tensor.shape, elementType);
+  if (auto floatType = mlir::dyn_cast<FloatType>(elementType)) {
+    llvm::SmallVector<llvm::APFloat> values;
+    values.reserve(tensor.values.size());
+    for (double value : tensor.values) {
+      llvm::APFloat element(value);
+      bool losesInfo = false;
+      element.convert(floatType.getFloatSemantics(),
+                      llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+      values.push_back(element);
+    }
+    return DenseElementsAttr::get(type, values);
+  }
+
+  auto intType = mlir::cast<IntegerType>(elementType);
+  llvm::SmallVector<llvm::APInt> values;
+  values.reserve(tensor.values.size());
+  for (double value : tensor.values) {
+    values.emplace_back(intType.getWidth(),
+                        static_cast<uint64_t>(static_cast<int64_t>(value)),
+                        /*isSigned=*/!isUnsignedType(intType));
+  }
+  return DenseElementsAttr::get(type, values);
+}
+
+static llvm::SmallVector<int64_t> getStrides(llvm::ArrayRef<int64_t> shape) {
+  llvm::SmallVector<int64_t> strides(shape.size(), 1);
+  for (int64_t i = static_cast<int64_t>(shape.size()) - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * shape[i + 1];
+  }
+  return strides;
+}
+
+// Index of the source element read for every element of a tensor of shape
+// outShape, where the source is broadcast to outShape (numpy semantics) and
+// its dims are reordered by permutation, i.e. out dim i reads source dim
+// permutation[i].
+//
+static std::vector<int64_t>
+getSourceIndices(llvm::ArrayRef<int64_t> shape,
+                 llvm::ArrayRef<int64_t> outShape,
+                 llvm::ArrayRef<int64_t> permutation = {}) {
+  llvm::SmallVector<int64_t> sourceStrides = getStrides(shape);
+  llvm::SmallVector<int64_t> strides(outShape.size(), 0);
+  for (size_t i = 0; i < outShape.size(); ++i) {
+    if (!permutation.empty()) {
+      strides[i] = sourceStrides[permutation[i]];
+      continue;
+    }
+    // Broadcasting aligns the trailing dims.
+    int64_t dim = static_cast<int64_t>(i) -
+                  static_cast<int64_t>(outShape.size() - shape.size());
+    if (dim >= 0 && shape[dim] != 1) {
+      strides[i] = sourceStrides[dim];
+    }
+  }
+
+  int64_t numElements = 1;
+  for (int64_t dim : outShape) {
+    numElements *= dim;
+  }
+
+  std::vector<int64_t> indices;
+  indices.reserve(numElements);
+  llvm::SmallVector<int64_t> index(outShape.size(), 0);
+  int64_t offset = 0;
+  for (int64_t n = 0; n < numElements; ++n) {
+    indices.push_back(offset);
+    for (int64_t i = static_cast<int64_t>(outShape.size()) - 1; i >= 0; --i) {
+      if (++index[i] < outShape[i]) {
+        offset += strides[i];
+        break;
+      }
+      offset -= strides[i] * (outShape[i] - 1);
+      index[i] = 0;
+    }
+  }
+  return indices;
+}
+
+static double applyUnary(Operation *op, double x) {
+  return llvm::TypeSwitch<Operation *, double>(op)
+      .Case<AbsOp>([&](auto) { return std::abs(x); })
+      .Case<NegOp>([&](auto) { return -x; })
+      .Case<ExpOp>([&](auto) { return std::exp(x); })
+      .Case<SqrtOp>([&](auto) { return std::sqrt(x); })
+      .Case<RsqrtOp>([&](auto) { return 1.0 / std::sqrt(x); })
+      .Case<ReciprocalOp>([&](auto) { return 1.0 / x; })
+      .Case<ReluOp>([&](auto) { return std::max(x, 0.0); });
+}
+
+static double applyBinary(Operation *op, double x, double y) {
+  return llvm::TypeSwitch<Operation *, double>(op)
+      .Case<AddOp>([&](auto) { return x + y; })
+      .Case<SubtractOp>([&](auto) { return x - y; })
+      .Case<MultiplyOp>([&](auto) { return x * y; })
+      .Case<DivideOp>([&](auto) { return x / y; })
+      .Case<MaximumOp>([&](auto) { return std::max(x, y); })
+      .Case<MinimumOp>([&](auto) { return std::min(x, y); });
+}
+
+namespace {
+// Evaluates TTNN ops on the host. Only ops commonly found in weight
+// preparation are supported: creation, layout and data type conversions,
+// reshapes, permutes and simple elementwise math.
+//
+class HostEvaluator {
+public:
+  void bind(Value value, HostTensor tensor) {
+    values[value] = std::move(tensor);
+  }
+
+  const HostTensor *lookup(Value value) const {
+    auto it = values.find(value);
+    return it == values.end() ? nullptr : &it->second;
+  }
+
+  // Evaluates the op and binds its result. Fails on unsupported ops and
+  // element types, or if an operand has no value.
+  //
+  LogicalResult evaluate(Operation *op) {
+    if (op->getNumResults() != 1 ||
+        !mlir::isa<RankedTensorType>(op->getResult(0).getType())) {
+      return failure();
+    }
+    Value result = op->getResult(0);
+    Type elementType = getStorageElementType(result);
+    if (!isFoldableElementType(elementType)) {
+      return failure();
+    }
+
+    llvm::SmallVector<const HostTensor *> operands;
+    for (Value operand : op->getOperands()) {
+      if (mlir::isa<DeviceType>(operand.getType())) {
+        continue;
+      }
+      const HostTensor *operandTensor = lookup(operand);
+      if (!operandTensor) {
+        return failure();
+      }
+      operands.push_back(operandTensor);
+    }
+
+    auto resultShape =
+        mlir::cast<RankedTensorType>(result.getType()).getShape();
+    std::optional<HostTensor> tensor =
+        llvm::TypeSwitch<Operation *, std::optional<HostTensor>>(op)
+            .Case<ConstantOp>([&](ConstantOp constantOp)
+                                  -> std::optional<HostTensor> {
+              std::optional<std::vector<double>> elements =
+                  readElements(constantOp.getValue());
+              if (!elements) {
+                return std::nullopt;
+              }
+              return HostTensor{llvm::to_vector(resultShape),
+                                std::move(*elements)};
+            })
+            .Case<FullOp>([&](FullOp fullOp) {
+              int64_t numElements =
+                  mlir::cast<RankedTensorType>(result.getType())
+                      .getNumElements();
+              return HostTensor{
+                  llvm::to_vector(resultShape),
+                  std::vector<double>(
+                      numElements,
+                      fullOp.getFillValue().convertToDouble())};
+            })
+            .Case<ToLayoutOp, ToDeviceOp, FromDeviceOp, ToMemoryConfigOp,
+                  TypecastOp, ToDTypeOp, ReshapeOp>([&](auto) {
+              return HostTensor{llvm::to_vector(resultShape),
+                                operands[0]->values};
+            })
+            .Case<PermuteOp>([&](PermuteOp permuteOp) {
+              return permute(*operands[0], permuteOp.getPermutation());
+            })
+            .Case<TransposeOp>([&](TransposeOp transposeOp) {
+              int64_t rank = operands[0]->shape.size();
+              int64_t dim0 = (transposeOp.getDim0() + rank) % rank;
+              int64_t dim1 = (transposeOp.getDim1() + rank) % rank;
+              llvm::SmallVector<int64_t> permutation(rank);
+              std::iota(permutation.begin(), permutation.end(), 0);
+              std::swap(permutation[dim0], permutation[dim1]);
+              return permute(*operands[0], permutation);
+            })
+            .Case<AbsOp, NegOp, ExpOp, SqrtOp, RsqrtOp, ReciprocalOp, ReluOp>(
+                [&](auto) {
+                  HostTensor out{llvm::to_vector(resultShape),
+                                 operands[0]->values};
+                  for (double &value : out.values) {
+                    value = applyUnary(op, value);
+                  }
+                  return out;
+                })
+            .Case<AddOp, SubtractOp, MultiplyOp, DivideOp, MaximumOp,
+                  MinimumOp>([&](auto) {
+              std::vector<int64_t> lhsIndices =
+                  getSourceIndices(operands[0]->shape, resultShape);
+              std::vector<int64_t> rhsIndices =
+                  getSourceIndices(operands[1]->shape, resultShape);
+              HostTensor out{llvm::to_vector(resultShape), {}};
+              out.values.reserve(lhsIndices.size());
+              for (size_t i = 0; i < lhsIndices.size(); ++i) {
+                out.values.push_back(
+                    applyBinary(op, operands[0]->values[lhsIndices[i]],
+                                operands[1]->values[rhsIndices[i]]));
+              }
+              return out;
+            })
+            .Default([](Operation *) { return std::nullopt; });
+
+    if (!tensor) {
+      return failure();
+    }
+
+    // Round to the stored element type after every op, as the device would.
+    //
+    for (double &value : tensor->values) {
+      value = roundToElementType(value, elementType);
+    }
+    bind(result, std::move(*tensor));
+    return success();
+  }
+
+private:
+  static HostTensor permute(const HostTensor &input,
+                            llvm::ArrayRef<int64_t> permutation) {
+    HostTensor out;
+    for (int64_t dim : permutation) {
+      out.shape.push_back(input.shape[dim]);
+    }
+    std::vector<int64_t> indices =
+        getSourceIndices(input.shape, out.shape, permutation);
+    out.values.reserve(indices.size());
+    for (int64_t index : indices) {
+      out.values.push_back(input.values[index]);
+    }
+    return out;
+  }
+
+  llvm::DenseMap<Value, HostTensor> values;
+};
+} // namespace
+
+// Bytes of constant data the attribute adds to the binary.
+//
+static uint64_t getConstantBytes(ElementsAttr attr) {
+  if (auto dense = mlir::dyn_cast<DenseElementsAttr>(attr)) {
+    return dense.getRawData().size();
+  }
+  if (auto resource = mlir::dyn_cast<DenseResourceElementsAttr>(attr)) {
+    return resource.getData().size();
+  }
+  return 0;
+}
+
+static uint64_t getTensorBytes(RankedTensorType type, Type elementType) {
+  return type.getNumElements() *
+         llvm::divideCeil(elementType.getIntOrFloatBitWidth(), 8);
+}
+
+static bool isSplat(const HostTensor &tensor) {
+  return std::all_of(tensor.values.begin(), tensor.values.end(),
+                     [&](double value) {
+                       return value == tensor.values.front() ||
+                              (std::isnan(value) &&
+                               std::isnan(tensor.values.front()));
+                     });
+}
+
+// Full ops carry their fill value as f32 all the way to the runtime, which
+// only holds integers up to 2^24 exactly.
+//
+static bool isExactFillValue(double value, Type elementType) {
+  return !mlir::isa<IntegerType>(elementType) ||
+         static_cast<double>(static_cast<float>(value)) == value;
+}
+
+// Whether a result is materialized as a full op rather than a constant.
+//
+static bool isFullResult(const HostTensor &tensor, Value result) {
+  auto layout = mlir::dyn_cast_if_present<TTNNLayoutAttr>(
+      mlir::cast<RankedTensorType>(result.getType()).getEncoding());
+  return layout && layout.isDeviceBufferType() && !tensor.values.empty() &&
+         isSplat(tensor);
+}
+
+class TTNNConstEvalFold
+    : public impl::TTNNConstEvalFoldBase<TTNNConstEvalFold> {
+public:
+  using impl::TTNNConstEvalFoldBase<TTNNConstEvalFold>::TTNNConstEvalFoldBase;
+
+  void runOnOperation() final {
+    ModuleOp moduleOp = getOperation();
+
+    llvm::DenseMap<StringRef, llvm::SmallVector<tt::LoadCachedOp>> callers;
+    moduleOp->walk([&](tt::LoadCachedOp callOp) {
+      callers[callOp.getCallee()].push_back(callOp);
+    });
+
+    llvm::SmallVector<func::FuncOp> constEvalFuncs;
+    moduleOp->walk([&](func::FuncOp funcOp) {
+      if (ttmlir::utils::isConstEvalFunc(funcOp)) {
+        constEvalFuncs.push_back(funcOp);
+      }
+    });
+
+    // Bytes of constant data that may still be added.
+    //
+    int64_t remainingBytes = maxFoldedBytes;
+    for (func::FuncOp funcOp : constEvalFuncs) {
+      auto it = callers.find(funcOp.getName());
+      if (it == callers.end() || it->second.size() != 1) {
+        continue;
+      }
+      foldConstEvalFunc(funcOp, it->second.front(), remainingBytes);
+    }
+  }
+
+private:
+  void foldConstEvalFunc(func::FuncOp funcOp, tt::LoadCachedOp callOp,
+                         int64_t &remainingBytes) {
+    auto skip = [&](const std::string &reason) {
+      TTMLIR_DEBUG(ttmlir::LogComponent::General,
+                   "Not folding const-eval function {0}: {1}",
+                   funcOp.getName(), reason);
+      if (reportFolding) {
+        funcOp.emitRemark() << "Const-eval function not folded: " << reason;
+      }
+    };
+
+    // Arguments are only known if the caller passes compile time constants.
+    //
+    HostEvaluator evaluator;
+    llvm::SmallVector<Operation *> callerConstants;
+    for (auto [arg, input] :
+         llvm::zip(funcOp.getArguments(), callOp.getInputs())) {
+      Operation *definingOp = input.getDefiningOp();
+      if (!mlir::isa_and_present<ConstantOp, FullOp>(definingOp) ||
+          failed(evaluator.evaluate(definingOp))) {
+        return skip("argument " + std::to_string(arg.getArgNumber()) +
+                    " is not a compile time constant");
+      }
+      evaluator.bind(arg, *evaluator.lookup(input));
+      callerConstants.push_back(definingOp);
+    }
+
+    // Constant data removed from the binary along with the function, which
+    // offsets the data added by folding.
+    //
+    uint64_t removedBytes = 0;
+    auto returnOp =
+        mlir::cast<func::ReturnOp>(funcOp.getBody().front().getTerminator());
+    for (Operation &op : funcOp.getBody().front().without_terminator()) {
+      if (auto constantOp = mlir::dyn_cast<ConstantOp>(op)) {
+        removedBytes += getConstantBytes(constantOp.getValue());
+      }
+    }
+    for (Operation *op : callerConstants) {
+      if (auto constantOp = mlir::dyn_cast<ConstantOp>(op);
+          constantOp && llvm::all_of(op->getUsers(), [&](Operation *user) {
+            return user == callOp;
+          })) {
+        removedBytes += getConstantBytes(constantOp.getValue());
+      }
+    }
+
+    // Bail out before evaluating if even the worst case doesn't fit.
+    //
+    uint64_t maxAddedBytes = 0;
+    for (Value result : returnOp.getOperands()) {
+      maxAddedBytes +=
+          getTensorBytes(mlir::cast<RankedTensorType>(result.getType()),
+                         getStorageElementType(result));
+    }
+    if (static_cast<int64_t>(maxAddedBytes - removedBytes) > remainingBytes) {
+      return skip("folded results of " + std::to_string(maxAddedBytes) +
+                  " bytes exceed the size budget");
+    }
+
+    AnalyticalOpCostModel costModel;
+    double savedRuntime = 0.0;
+    size_t numFoldedOps = 0;
+    for (Operation &op : funcOp.getBody().front().without_terminator()) {
+      if (mlir::isa<GetDeviceOp>(op)) {
+        continue;
+      }
+      if (failed(evaluator.evaluate(&op))) {
+        return skip("unsupported op " + op.getName().getStringRef().str());
+      }
+      savedRuntime += getOpRuntime(costModel, &op);
+      numFoldedOps++;
+    }
+
+    // Device splats can only become full ops, constants of a splat are stored
+    // with a single element. Integer splats a full op can't hold exactly are
+    // left to the device.
+    //
+    for (auto [result, value] :
+         llvm::zip(callOp.getResults(), returnOp.getOperands())) {
+      const HostTensor &tensor = *evaluator.lookup(value);
+      if (isFullResult(tensor, result) &&
+          !isExactFillValue(tensor.values.front(),
+                            getStorageElementType(result))) {
+        return skip("integer splat " +
+                    std::to_string(
+                        static_cast<int64_t>(tensor.values.front())) +
+                    " is not exactly representable as a fill value");
+      }
+    }
+
+    IRRewriter rewriter(&getContext());
+    rewriter.setInsertionPoint(callOp);
+    uint64_t addedBytes = 0;
+    for (auto [result, value] :
+         llvm::zip(callOp.getResults(), returnOp.getOperands())) {
+      Value folded = materializeResult(rewriter, callOp,
+                                       *evaluator.lookup(value), result,
+                                       addedBytes, costModel, savedRuntime);
+      rewriter.replaceAllUsesWith(result, folded);
+    }
+    remainingBytes -= static_cast<int64_t>(addedBytes - removedBytes);
+
+    TTMLIR_DEBUG(ttmlir::LogComponent::General,
+                 "Folded const-eval function {0}: {1} ops, {2} bytes added, "
+                 "{3} bytes removed",
+                 funcOp.getName(), numFoldedOps, addedBytes, removedBytes);
+    if (reportFolding) {
+      funcOp.emitRemark() << "Const-eval function folded: " << numFoldedOps
+                          << " ops, "
+                          << static_cast<uint64_t>(std::max(savedRuntime, 0.0))
+                          << " ns of estimated device time saved, "
+                          << addedBytes << " bytes of constants added, "
+                          << removedBytes << " bytes removed";
+    }
+
+    rewriter.eraseOp(callOp);
+    for (Operation *op : callerConstants) {
+      if (op->use_empty()) {
+        rewriter.eraseOp(op);
+      }
+    }
+    rewriter.eraseOp(funcOp);
+  }
+
+  // Creates the folded value of a load_cached result. Splats become full ops
+  // which carry no data. Other results become host constants, converted to
+  // the result layout.
+  //
+  Value materializeResult(IRRewriter &rewriter, tt::LoadCachedOp callOp,
+                          const HostTensor &tensor, Value result,
+                          uint64_t &addedBytes,
+                          const AnalyticalOpCostModel &costModel,
+                          double &savedRuntime) {
+    auto resultType = mlir::cast<RankedTensorType>(result.getType());
+    auto resultLayout =
+        mlir::dyn_cast_if_present<TTNNLayoutAttr>(resultType.getEncoding());
+    Location loc = callOp.getLoc();
+
+    Type elementType = getStorageElementType(result);
+    if (isFullResult(tensor, result)) {
+      assert(isExactFillValue(tensor.values.front(), elementType) &&
+             "integer splats must be exact in f32");
+      return rewriter.create<FullOp>(
+          loc, resultType, utils::getOrInsertDevice(rewriter, callOp),
+          rewriter.getF32FloatAttr(tensor.values.front()));
+    }
+
+    DenseElementsAttr value = materialize(tensor, elementType);
+    addedBytes += value.getRawData().size();
+    if (!resultLayout) {
+      return rewriter.create<ConstantOp>(loc, resultType, value);
+    }
+
+    TTNNLayoutAttr hostLayout =
+        resultLayout.withBufferType(BufferType::SystemMemory)
+            .withElementType(elementType, resultType.getShape());
+    Value constant = rewriter.create<ConstantOp>(
+        loc,
+        RankedTensorType::get(resultType.getShape(), elementType, hostLayout),
+        value);
+    if (hostLayout == resultLayout) {
+      return constant;
+    }
+
+    savedRuntime -=
+        costModel.getLayoutConversionCost(resultType, hostLayout, resultLayout);
+
+    MemoryConfigAttr memoryConfig = nullptr;
+    Value device = nullptr;
+    if (resultLayout.isDeviceBufferType()) {
+      memoryConfig = MemoryConfigAttr::get(
+          &getContext(),
+          BufferTypeAttr::get(&getContext(), resultLayout.getBufferType()),
+          ShardSpecAttr::get(
+              &getContext(),
+              ShapeAttr::get(&getContext(), resultLayout.getShardShape())),
+          resultLayout.getMemLayout());
+      device = utils::getOrInsertDevice(rewriter, callOp);
+    }
+    return rewriter.create<ToLayoutOp>(
+        loc, resultType, constant,
+        LayoutAttr::get(&getContext(), resultLayout.getLayout()),
+        DataTypeAttr::get(&getContext(), resultLayout.getDataType()),
+        memoryConfig, device);
+  }
+
+  static double getOpRuntime(const AnalyticalOpCostModel &costModel,
+                             Operation *op) {
+    if (op->getNumResults() != 1) {
+      return 0.0;
+    }
+    auto outputLayout = mlir::dyn_cast_if_present<TTNNLayoutAttr>(
+        mlir::cast<RankedTensorType>(op->getResult(0).getType())
+            .getEncoding());
+    if (!outputLayout || outputLayout.isSystemBufferType()) {
+      return 0.0;
+    }
+
+    std::vector<TTNNLayoutAttr> inputLayouts;
+    for (Value operand : getOpModelInputOperands(op)) {
+      auto operandType = mlir::dyn_cast<RankedTensorType>(operand.getType());
+      inputLayouts.push_back(
+          operandType ? mlir::dyn_cast_if_present<TTNNLayoutAttr>(
+                            operandType.getEncoding())
+                      : nullptr);
+    }
+    return costModel.getOpCost(op, inputLayouts, OpConfig(outputLayout))
+        .runtime;
+  }
+};
+
+} // namespace mlir::tt::ttnn
@@ -24,21 +24,19 @@ public:
       TTNNDecomposeLayouts>::TTNNDecomposeLayoutsBase;
 
   void runOnOperation() final {
-    ModuleOp module = getOperation();
+    func::FuncOp func = getOperation();
     IRRewriter rewriter(&getContext());
     llvm::SmallVector<Operation *> opsToReplace;
-    module->walk([&](func::FuncOp func) {
-      if (func.isDeclaration()) {
+    if (func.isDeclaration()) {
+      return;
+    }
+    assert(func.getBody().hasOneBlock() &&
+           "found func that didn't have one block!");
+    func->walk([&](Operation *op) {
+      if (!isa<ttnn::ToLayoutOp>(op)) {
         return;
       }
-      assert(func.getBody().hasOneBlock() &&
-             "found func that didn't have one block!");
-      func->walk([&](Operation *op) {
-        if (!isa<ttnn::ToLayoutOp>(op)) {
-          return;
-        }
-        opsToReplace.push_back(op);
-      });
+      opsToReplace.push_back(op);
     });
     for (Operation *op : opsToReplace) {
       if (failed(createLayoutConversionOps(mlir::cast<ttnn::ToLayoutOp>(op),
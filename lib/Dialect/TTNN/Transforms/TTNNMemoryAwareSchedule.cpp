@@ -0,0 +1,426 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/Dialect/TTNN/Analysis/OpCostModel.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNN.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+#include "ttmlir/Dialect/TTNN/Transforms/Passes.h"
+#include "ttmlir/Support/Logger.h"
+#include "ttmlir/Utils.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Interfaces/DestinationStyleOpInterface.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <set>
+
+namespace mlir::tt::ttnn {
+#define GEN_PASS_DEF_TTNNMEMORYAWARESCHEDULE
+#include "ttmlir/Dialect/TTNN/Transforms/Passes.h.inc"
+
+// Ops which don't split the block into separately scheduled segments.
+//
+static bool isReorderable(Operation *op) {
+  return isa<TTNNDialect>(op->getDialect()) && op->getNumResults() > 0 &&
+         op->getNumRegions() == 0;
+}
+
+// Ops which are not scheduled on their own, but right before their first
+// user, since they don't do any work.
+//
+static bool isDeferred(Operation *op) {
+  return isa<EmptyOp, GetDeviceOp>(op);
+}
+
+namespace {
+// Predicted peaks of live device tensor bytes. DRAM and L1 peaks may happen
+// at different points, the total is the peak of their sum.
+//
+struct PeakMemory {
+  uint64_t dram = 0;
+  uint64_t l1 = 0;
+  uint64_t total = 0;
+};
+
+// Device buffers of a function body. A buffer is allocated by the op defining
+// its tensor and released after the last op using the tensor or any DPS
+// result tied to it, which is where the deallocate pass releases it.
+//
+class BufferModel {
+public:
+  struct Buffer {
+    uint64_t size;
+    bool isL1;
+    // Number of ops using the buffer, plus one if it is never released.
+    unsigned numUses;
+  };
+
+  explicit BufferModel(func::FuncOp func) {
+    Block &block = func.getBody().front();
+
+    // Const eval funcs don't own their arguments, so those stay live.
+    //
+    bool ownsArguments = !ttmlir::utils::isConstEvalFunc(func);
+    for (BlockArgument arg : block.getArguments()) {
+      std::optional<unsigned> buffer = addBuffer(arg);
+      if (buffer) {
+        argumentBuffers.push_back(*buffer);
+        buffers[*buffer].numUses += ownsArguments ? 0 : 1;
+      }
+    }
+
+    for (Operation &op : block) {
+      for (OpResult result : op.getResults()) {
+        if (auto dpsOp = mlir::dyn_cast<DestinationStyleOpInterface>(&op)) {
+          auto initBuffer =
+              bufferIds.find(dpsOp.getTiedOpOperand(result)->get());
+          if (initBuffer != bufferIds.end()) {
+            bufferIds[result] = initBuffer->second;
+            continue;
+          }
+        }
+        std::optional<unsigned> buffer = addBuffer(result);
+        if (buffer) {
+          allocatedBuffers[&op].push_back(*buffer);
+        }
+      }
+
+      llvm::SmallSetVector<unsigned, 4> usedBuffers;
+      op.walk([&](Operation *nestedOp) {
+        for (Value operand : nestedOp->getOperands()) {
+          auto buffer = bufferIds.find(operand);
+          if (buffer != bufferIds.end()) {
+            usedBuffers.insert(buffer->second);
+          }
+        }
+      });
+      for (unsigned buffer : usedBuffers) {
+        buffers[buffer].numUses++;
+      }
+      if (!usedBuffers.empty()) {
+        this->usedBuffers[&op] = usedBuffers.takeVector();
+      }
+    }
+  }
+
+  const Buffer &getBuffer(unsigned buffer) const { return buffers[buffer]; }
+
+  size_t getNumBuffers() const { return buffers.size(); }
+
+  llvm::ArrayRef<unsigned> getArgumentBuffers() const {
+    return argumentBuffers;
+  }
+
+  llvm::ArrayRef<unsigned> getAllocatedBuffers(Operation *op) const {
+    auto opBuffers = allocatedBuffers.find(op);
+    return opBuffers == allocatedBuffers.end()
+               ? llvm::ArrayRef<unsigned>()
+               : llvm::ArrayRef<unsigned>(opBuffers->second);
+  }
+
+  llvm::ArrayRef<unsigned> getUsedBuffers(Operation *op) const {
+    auto opBuffers = usedBuffers.find(op);
+    return opBuffers == usedBuffers.end()
+               ? llvm::ArrayRef<unsigned>()
+               : llvm::ArrayRef<unsigned>(opBuffers->second);
+  }
+
+private:
+  std::optional<unsigned> addBuffer(Value value) {
+    auto tensorType = mlir::dyn_cast<RankedTensorType>(value.getType());
+    if (!tensorType) {
+      return std::nullopt;
+    }
+    auto layout =
+        mlir::dyn_cast_if_present<TTNNLayoutAttr>(tensorType.getEncoding());
+    if (!layout || !layout.isDeviceBufferType()) {
+      return std::nullopt;
+    }
+
+    unsigned buffer = buffers.size();
+    buffers.push_back(Buffer{
+        AnalyticalOpCostModel::getTensorSizeInBytes(tensorType, layout),
+        !layout.hasDRAMBufferType(), /*numUses=*/0});
+    bufferIds[value] = buffer;
+    return buffer;
+  }
+
+  llvm::SmallVector<Buffer> buffers;
+  llvm::DenseMap<Value, unsigned> bufferIds;
+  llvm::SmallVector<unsigned> argumentBuffers;
+  llvm::DenseMap<Operation *, llvm::SmallVector<unsigned, 1>> allocatedBuffers;
+  llvm::DenseMap<Operation *, llvm::SmallVector<unsigned, 4>> usedBuffers;
+};
+
+// Tracks live device tensor bytes while ops are executed in some order.
+//
+class MemoryTracker {
+public:
+  explicit MemoryTracker(const BufferModel &model) : model(model) {
+    remainingUses.reserve(model.getNumBuffers());
+    for (size_t buffer = 0; buffer < model.getNumBuffers(); buffer++) {
+      remainingUses.push_back(model.getBuffer(buffer).numUses);
+    }
+    for (unsigned buffer : model.getArgumentBuffers()) {
+      allocate(buffer);
+    }
+    updatePeak();
+    for (unsigned buffer : model.getArgumentBuffers()) {
+      if (remainingUses[buffer] == 0) {
+        release(buffer);
+      }
+    }
+  }
+
+  // Bytes by which the live memory grows once op is executed and the buffers
+  // it used for the last time are released.
+  //
+  int64_t getGrowth(Operation *op) const {
+    int64_t growth = 0;
+    for (unsigned buffer : model.getAllocatedBuffers(op)) {
+      growth += model.getBuffer(buffer).numUses > 0
+                    ? model.getBuffer(buffer).size
+                    : 0;
+    }
+    for (unsigned buffer : model.getUsedBuffers(op)) {
+      if (remainingUses[buffer] == 1) {
+        growth -= model.getBuffer(buffer).size;
+      }
+    }
+    return growth;
+  }
+
+  void execute(Operation *op) {
+    for (unsigned buffer : model.getAllocatedBuffers(op)) {
+      allocate(buffer);
+    }
+    updatePeak();
+    for (unsigned buffer : model.getUsedBuffers(op)) {
+      assert(remainingUses[buffer] > 0 && "Buffer used after its last use");
+      if (--remainingUses[buffer] == 0) {
+        release(buffer);
+      }
+    }
+    for (unsigned buffer : model.getAllocatedBuffers(op)) {
+      if (model.getBuffer(buffer).numUses == 0) {
+        release(buffer);
+      }
+    }
+  }
+
+  const PeakMemory &getPeak() const { return peak; }
+
+private:
+  void allocate(unsigned buffer) {
+    const BufferModel::Buffer &info = model.getBuffer(buffer);
+    (info.isL1 ? liveL1 : liveDRAM) += info.size;
+  }
+
+  void release(unsigned buffer) {
+    const BufferModel::Buffer &info = model.getBuffer(buffer);
+    (info.isL1 ? liveL1 : liveDRAM) -= info.size;
+  }
+
+  void updatePeak() {
+    peak.dram = std::max(peak.dram, liveDRAM);
+    peak.l1 = std::max(peak.l1, liveL1);
+    peak.total = std::max(peak.total, liveDRAM + liveL1);
+  }
+
+  const BufferModel &model;
+  llvm::SmallVector<unsigned> remainingUses;
+  uint64_t liveDRAM = 0;
+  uint64_t liveL1 = 0;
+  PeakMemory peak;
+};
+
+// Greedy list scheduler of a single block function body.
+//
+class MemoryAwareScheduler {
+public:
+  explicit MemoryAwareScheduler(const BufferModel &model) : tracker(model) {}
+
+  // Returns the ops of the block in the new order, barriers included.
+  //
+  llvm::SmallVector<Operation *> schedule(Block &block) {
+    llvm::SmallVector<Operation *> segment;
+    for (Operation &op : block) {
+      if (isReorderable(&op)) {
+        segment.push_back(&op);
+        continue;
+      }
+      scheduleSegment(segment);
+      segment.clear();
+      emit(&op);
+    }
+    scheduleSegment(segment);
+    return order;
+  }
+
+  const PeakMemory &getPeak() const { return tracker.getPeak(); }
+
+private:
+  // Emits op right after the deferred ops it depends on.
+  //
+  void emit(Operation *op) {
+    for (Value operand : op->getOperands()) {
+      Operation *producer = operand.getDefiningOp();
+      if (producer && isDeferred(producer) && !emitted.contains(producer)) {
+        emit(producer);
+      }
+    }
+    tracker.execute(op);
+    order.push_back(op);
+    emitted.insert(op);
+  }
+
+  // Growth of the live memory when op is emitted, including the deferred ops
+  // emitted along with it.
+  //
+  int64_t getGrowth(Operation *op, llvm::SmallPtrSetImpl<Operation *> &seen) {
+    int64_t growth = tracker.getGrowth(op);
+    for (Value operand : op->getOperands()) {
+      Operation *producer = operand.getDefiningOp();
+      if (producer && isDeferred(producer) && !emitted.contains(producer) &&
+          seen.insert(producer).second) {
+        growth += getGrowth(producer, seen);
+      }
+    }
+    return growth;
+  }
+
+  void scheduleSegment(llvm::ArrayRef<Operation *> segment) {
+    llvm::DenseMap<Operation *, unsigned> indices;
+    for (auto [index, op] : llvm::enumerate(segment)) {
+      if (!isDeferred(op)) {
+        indices[op] = index;
+      }
+    }
+
+    // Dependencies between the scheduled ops of the segment. Deferred ops
+    // are emitted together with their users, so they are skipped.
+    //
+    llvm::SmallVector<unsigned> pendingDependencies(segment.size(), 0);
+    llvm::SmallVector<llvm::SmallVector<unsigned, 4>> users(segment.size());
+    std::set<unsigned> ready;
+    for (auto [index, op] : llvm::enumerate(segment)) {
+      if (isDeferred(op)) {
+        continue;
+      }
+      llvm::SmallSetVector<unsigned, 4> producers;
+      for (Value operand : op->getOperands()) {
+        auto producer = indices.find(operand.getDefiningOp());
+        if (producer != indices.end()) {
+          producers.insert(producer->second);
+        }
+      }
+      for (unsigned producer : producers) {
+        users[producer].push_back(index);
+      }
+      pendingDependencies[index] = producers.size();
+      if (producers.empty()) {
+        ready.insert(index);
+      }
+    }
+
+    while (!ready.empty()) {
+      // Ties are broken by program order, as ready ops are visited in it.
+      //
+      unsigned best = *ready.begin();
+      int64_t bestGrowth = std::numeric_limits<int64_t>::max();
+      for (unsigned index : ready) {
+        llvm::SmallPtrSet<Operation *, 4> seen;
+        int64_t growth = getGrowth(segment[index], seen);
+        if (growth < bestGrowth) {
+          bestGrowth = growth;
+          best = index;
+        }
+      }
+
+      ready.erase(best);
+      emit(segment[best]);
+      for (unsigned user : users[best]) {
+        if (--pendingDependencies[user] == 0) {
+          ready.insert(user);
+        }
+      }
+    }
+
+    // Deferred ops used by later segments or not used at all stay in this
+    // segment.
+    //
+    for (Operation *op : segment) {
+      if (!emitted.contains(op)) {
+        assert(isDeferred(op) && "Op left unscheduled");
+        emit(op);
+      }
+    }
+  }
+
+  MemoryTracker tracker;
+  llvm::DenseSet<Operation *> emitted;
+  llvm::SmallVector<Operation *> order;
+};
+} // namespace
+
+class TTNNMemoryAwareSchedule
+    : public impl::TTNNMemoryAwareScheduleBase<TTNNMemoryAwareSchedule> {
+
+public:
+  using impl::TTNNMemoryAwareScheduleBase<
+      TTNNMemoryAwareSchedule>::TTNNMemoryAwareScheduleBase;
+
+  void runOnOperation() final {
+    func::FuncOp func = getOperation();
+
+    if (func.isDeclaration() || !func.getBody().hasOneBlock()) {
+      return;
+    }
+    Block &block = func.getBody().front();
+    BufferModel model(func);
+
+    MemoryTracker originalTracker(model);
+    for (Operation &op : block) {
+      originalTracker.execute(&op);
+    }
+    PeakMemory originalPeak = originalTracker.getPeak();
+
+    MemoryAwareScheduler scheduler(model);
+    llvm::SmallVector<Operation *> order = scheduler.schedule(block);
+    assert(order.size() == block.getOperations().size() &&
+           "Schedule doesn't cover all ops");
+
+    // Greedy scheduling is not guaranteed to improve on the original order.
+    //
+    PeakMemory peak = originalPeak;
+    if (scheduler.getPeak().total < originalPeak.total) {
+      peak = scheduler.getPeak();
+      for (Operation *op : order) {
+        op->moveBefore(&block, block.end());
+      }
+    }
+
+    TTMLIR_DEBUG(ttmlir::LogComponent::General,
+                 "Memory aware schedule of {0}: peak {1} -> {2} bytes",
+                 func.getName(), originalPeak.total, peak.total);
+
+    if (reportPeakMemory) {
+      func.emitRemark() << "Peak tensor memory: " << originalPeak.total
+                        << " -> " << peak.total << " bytes, DRAM "
+                        << originalPeak.dram << " -> " << peak.dram
+                        << " bytes, L1 " << originalPeak.l1 << " -> "
+                        << peak.l1 << " bytes";
+    }
+  }
+};
+
+} // namespace mlir::tt::ttnn
@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ttmlir/OpModel/TTNN/OpModelCache.h"
+
+#include "mlir/AsmParser/AsmParser.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/xxhash.h"
+
+#ifndef TT_METAL_VERSION
+#define TT_METAL_VERSION "unknown"
+#endif
+
+namespace mlir::tt::op_model::ttnn {
+
+namespace {
+constexpr llvm::StringLiteral kCacheFileMagic = "ttmlir-opmodel-cache-v1";
+constexpr char kConstraintsRecord = 'C';
+constexpr char kRuntimeRecord = 'R';
+
+// Reads "<value> " from the front of the buffer.
+bool consumeField(llvm::StringRef &buffer, size_t &value) {
+  if (buffer.consumeInteger(10, value)) {
+    return false;
+  }
+  return buffer.consume_front(" ") || buffer.consume_front("\n");
+}
+
+// Reads a string of known length from the front of the buffer.
+bool consumeString(llvm::StringRef &buffer, size_t length,
+                   llvm::StringRef &value) {
+  if (buffer.size() < length) {
+    return false;
+  }
+  value = buffer.take_front(length);
+  buffer = buffer.drop_front(length);
+  return true;
+}
+} // namespace
+
+OpModelCache &OpModelCache::getInstance() {
+  static OpModelCache instance;
+  return instance;
+}
+
+std::string OpModelCache::getFingerprint(SystemDescAttr systemDesc) {
+  std::string systemDescStr;
+  llvm::raw_string_ostream os(systemDescStr);
+  if (systemDesc) {
+    systemDesc.print(os);
+  }
+  std::string fingerprint;
+  llvm::raw_string_ostream fingerprintOs(fingerprint);
+  fingerprintOs << "tt-metal:" << TT_METAL_VERSION << ";system-desc:"
+                << llvm::format_hex(llvm::xxh3_64bits(os.str()), 18);
+  return fingerprintOs.str();
+}
+
+std::optional<llvm::Expected<OpConstraints>>
+OpModelCache::lookupConstraints(llvm::StringRef key, MLIRContext *context) {
+  ConstraintsEntry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = constraintsCache.find(key);
+    if (it == constraintsCache.end()) {
+      ++stats.constraintsMisses;
+      return std::nullopt;
+    }
+    ++stats.constraintsHits;
+    entry = it->second;
+  }
+
+  if (!entry.success) {
+    return llvm::Expected<OpConstraints>(
+        llvm::createStringError(entry.payload));
+  }
+
+  ::mlir::tt::ttnn::TTNNLayoutAttr layout;
+  if (!entry.payload.empty()) {
+    layout = mlir::dyn_cast_if_present<::mlir::tt::ttnn::TTNNLayoutAttr>(
+        mlir::parseAttribute(entry.payload, context));
+    if (!layout) {
+      // Entry can't be materialized in this context, treat it as a miss.
+      std::lock_guard<std::mutex> lock(mutex);
+      --stats.constraintsHits;
+      ++stats.constraintsMisses;
+      return std::nullopt;
+    }
+  }
+  return llvm::Expected<OpConstraints>(
+      std::make_tuple(entry.cbPeakSize, entry.l1BuffersPeakSize,
+                      entry.l1OutputBufferSize, layout));
+}
+
+llvm::Expected<OpConstraints>
+OpModelCache::insertConstraints(llvm::StringRef key,
+                                llvm::Expected<OpConstraints> result) {
+  ConstraintsEntry entry;
+  if (!result) {
+    std::string message = llvm::toString(result.takeError());
+    entry.payload = message;
+    std::lock_guard<std::mutex> lock(mutex);
+    constraintsCache.insert_or_assign(key, std::move(entry));
+    return llvm::createStringError(message);
+  }
+
+  entry.success = true;
+  std::tie(entry.cbPeakSize, entry.l1BuffersPeakSize, entry.l1OutputBufferSize,
+           std::ignore) = *result;
+  if (::mlir::tt::ttnn::TTNNLayoutAttr layout = std::get<3>(*result)) {
+    llvm::raw_string_ostream os(entry.payload);
+    layout.print(os);
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  constraintsCache.insert_or_assign(key, std::move(entry));
+  return result;
+}
+
+std::optional<llvm::Expected<size_t>>
+OpModelCache::lookupRuntime(llvm::StringRef key) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = runtimeCache.find(key);
+  if (it == runtimeCache.end()) {
+    ++stats.runtimeMisses;
+    return std::nullopt;
+  }
+  ++stats.runtimeHits;
+  if (!it->second.success) {
+    return llvm::Expected<size_t>(
+        llvm::createStringError(it->second.errorMessage));
+  }
+  return llvm::Expected<size_t>(it->second.runtime);
+}
+
+llvm::Expected<size_t>
+OpModelCache::insertRuntime(llvm::StringRef key,
+                            llvm::Expected<size_t> result) {
+  RuntimeEntry entry;
+  if (!result) {
+    entry.errorMessage = llvm::toString(result.takeError());
+    std::string message = entry.errorMessage;
+    std::lock_guard<std::mutex> lock(mutex);
+    runtimeCache.insert_or_assign(key, std::move(entry));
+    return llvm::createStringError(message);
+  }
+
+  entry.success = true;
+  entry.runtime = *result;
+  std::lock_guard<std::mutex> lock(mutex);
+  runtimeCache.insert_or_assign(key, std::move(entry));
+  return result;
+}
+
+llvm::Error OpModelCache::loadFromFile(llvm::StringRef path,
+                                       llvm::StringRef fingerprint) {
+  if (!llvm::sys::fs::exists(path)) {
+    return llvm::Error::success();
+  }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> fileOrErr =
+      llvm::MemoryBuffer::getFile(path);
+  if (!fileOrErr) {
+    return llvm::createStringError(fileOrErr.getError(),
+                                   "Failed to open op model cache file " +
+                                       path);
+  }
+
+  llvm::StringRef buffer = (*fileOrErr)->getBuffer();
+  auto [magic, rest] = buffer.split('\n');
+  auto [fileFingerprint, records] = rest.split('\n');
+  if (magic != kCacheFileMagic) {
+    return llvm::createStringError("Unrecognized op model cache file " + path);
+  }
+  if (fileFingerprint != fingerprint) {
+    // Results were produced for a different tt-metal build or system, they
+    // can't be reused.
+    return llvm::Error::success();
+  }
+
+  llvm::StringMap<ConstraintsEntry> loadedConstraints;
+  llvm::StringMap<RuntimeEntry> loadedRuntimes;
+  auto malformed = [&]() {
+    return llvm::createStringError("Malformed op model cache file " + path);
+  };
+
+  while (!records.empty()) {
+    char kind = records.front();
+    records = records.drop_front();
+    if (!records.consume_front(" ")) {
+      return malformed();
+    }
+
+    size_t success = 0;
+    llvm::StringRef key;
+    llvm::StringRef payload;
+    if (kind == kConstraintsRecord) {
+      ConstraintsEntry entry;
+      size_t keyLength = 0;
+      size_t payloadLength = 0;
+      if (!consumeField(records, success) ||
+          !consumeField(records, entry.cbPeakSize) ||
+          !consumeField(records, entry.l1BuffersPeakSize) ||
+          !consumeField(records, entry.l1OutputBufferSize) ||
+          !consumeField(records, keyLength) ||
+          !consumeField(records, payloadLength) ||
+          !consumeString(records, keyLength, key) ||
+          !consumeString(records, payloadLength, payload) ||
+          !records.consume_front("\n")) {
+        return malformed();
+      }
+      entry.success = success != 0;
+      entry.payload = payload.str();
+      loadedConstraints.insert_or_assign(key, std::move(entry));
+    } else if (kind == kRuntimeRecord) {
+      RuntimeEntry entry;
+      size_t keyLength = 0;
+      size_t payloadLength = 0;
+      if (!consumeField(records, success) ||
+          !consumeField(records, entry.runtime) ||
+          !consumeField(records, keyLength) ||
+          !consumeField(records, payloadLength) ||
+          !consumeString(records, keyLength, key) ||
+          !consumeString(records, payloadLength, payload) ||
+          !records.consume_front("\n")) {
+        return malformed();
+      }
+      entry.success = success != 0;
+      entry.errorMessage = payload.str();
+      loadedRuntimes.insert_or_assign(key, std::move(entry));
+    } else {
+      return malformed();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto &entry : loadedConstraints) {
+    constraintsCache.try_emplace(entry.getKey(), std::move(entry.getValue()));
+  }
+  for (auto &entry : loadedRuntimes) {
+    runtimeCache.try_emplace(entry.getKey(), std::move(entry.getValue()));
+  }
+  return llvm::Error::success();
+}
+
+llvm::Error OpModelCache::saveToFile(llvm::StringRef path,
+                                     llvm::StringRef fingerprint) const {
+  // Write to a temporary file first so that concurrent compiles never observe
+  // a partially written cache.
+  std::string tempPath = (path + ".tmp").str();
+  {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(tempPath, ec);
+    if (ec) {
+      return llvm::createStringError(
+          ec, "Failed to write op model cache file " + path);
+    }
+
+    os << kCacheFileMagic << '\n' << fingerprint << '\n';
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &entry : constraintsCache) {
+      const ConstraintsEntry &value = entry.getValue();
+      os << kConstraintsRecord << ' ' << (value.success ? 1 : 0) << ' '
+         << value.cbPeakSize << ' ' << value.l1BuffersPeakSize << ' '
+         << value.l1OutputBufferSize << ' ' << entry.getKey().size() << ' '
+         << value.payload.size() << '\n'
+         << entry.getKey() << value.payload << '\n';
+    }
+    for (const auto &entry : runtimeCache) {
+      const RuntimeEntry &value = entry.getValue();
+      os << kRuntimeRecord << ' ' << (value.success ? 1 : 0) << ' '
+         << value.runtime << ' ' << entry.getKey().size() << ' '
+         << value.errorMessage.size() << '\n'
+         << entry.getKey() << value.errorMessage << '\n';
+    }
+  }
+
+  if (std::error_code ec = llvm::sys::fs::rename(tempPath, path)) {
+    return llvm::createStringError(ec, "Failed to write op model cache file " +
+                                           path);
+  }
+  return llvm::Error::success();
+}
+
+void OpModelCache::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(mutex);
+  this->enabled = enabled;
+}
+
+bool OpModelCache::isEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return enabled;
+}
+
+void OpModelCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  constraintsCache.clear();
+  runtimeCache.clear();
+}
+
+size_t OpModelCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return constraintsCache.size() + runtimeCache.size();
+}
+
+OpModelCache::Stats OpModelCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return stats;
+}
+
+void OpModelCache::resetStats() {
+  std::lock_guard<std::mutex> lock(mutex);
+  stats = Stats();
+}
+
+} // namespace mlir::tt::op_model::ttnn
@@ -12,6 +12,7 @@
 #include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
 #include "ttmlir/OpModel/TTNN/Conversion.h"
 #include "ttmlir/OpModel/TTNN/MetalHeaders.h"
+#include "ttmlir/OpModel/TTNN/OpModelCache.h"
 #include "ttmlir/OpModel/TTNN/SingletonDeviceContext.h"
 #include "ttmlir/Support/Logger.h"
 
@@ -76,15 +77,19 @@ executeConstraintQuery(Callable &callable) {
 }
 
 /**
- * @brief Retrieves operation constraints based on the provided operation name
- * and callable.
+ * @brief Retrieves operation constraints based on the provided cache key and
+ * callable.
  *
  * This function attempts to query operation constraints using the provided
  * callable and arguments. If successful, it returns a tuple with resource usage
  * details and the actual layout of the output tensor of the op. Otherwise, an
  * error message.
  *
- * @param name The name of the operation to query constraints for.
+ * Results are memoized in the OpModelCache, so the query is only executed the
+ * first time a given key is seen.
+ *
+ * @param cacheKey Key uniquely identifying the query, built with
+ * OpModelCache::makeKey from the op name and all of the query arguments.
  * @param context The MLIRContext to use for creating the TTNNLayoutAttr for the
  * output tensor
  * @param deviceGrid The worker grid of the device the op is targetted for.
@@ -95,42 +100,56 @@ executeConstraintQuery(Callable &callable) {
 template <class Callable>
 llvm::Expected<
     std::tuple<size_t, size_t, size_t, ::mlir::tt::ttnn::TTNNLayoutAttr>>
-getOpConstraints(std::string_view name, MLIRContext *context,
+getOpConstraints(llvm::StringRef cacheKey, MLIRContext *context,
                  GridAttr deviceGrid, Callable &callable) {
+  auto computeConstraints = [&]() -> llvm::Expected<OpConstraints> {
+    llvm::Expected<::ttnn::graph::ConstraintQueryResponse> query =
+        executeConstraintQuery<Callable>(callable);
+    if (auto error = query.takeError()) {
+      return error;
+    }
 
-  llvm::Expected<::ttnn::graph::ConstraintQueryResponse> query =
-      executeConstraintQuery<Callable>(callable);
-  if (auto error = query.takeError()) {
-    return error;
-  }
+    ::ttnn::graph::ConstraintQueryResponse response = query.get();
 
-  ::ttnn::graph::ConstraintQueryResponse response = query.get();
+    return std::make_tuple(response.resource_usage.cb_peak_size_per_core,
+                           response.resource_usage.l1_buffers_peak_per_core,
+                           response.resource_usage.l1_output_buffer_per_core,
+                           conversion::getLayoutAttrFromTensorSpec(
+                               context, response.output_tensor_spec.value(),
+                               deviceGrid.getShape()));
+  };
 
-  return std::make_tuple(
-      response.resource_usage.cb_peak_size_per_core,
-      response.resource_usage.l1_buffers_peak_per_core,
-      response.resource_usage.l1_output_buffer_per_core,
-      conversion::getLayoutAttrFromTensorSpec(
-          context, response.output_tensor_spec.value(), deviceGrid.getShape()));
+  return OpModelCache::getInstance().getOrComputeConstraints(
+      cacheKey, context, computeConstraints);
 }
 
+/**
+ * @brief Retrieves operation runtime using the provided callable. Results are
+ * memoized in the OpModelCache under the given key.
+ */
 template <class Callable>
-llvm::Expected<size_t> getOpRuntime(std::string_view name, Callable &callable) {
-  ::ttnn::graph::RuntimeQueryResponse query;
-  try {
-    query = callable();
-  } catch (const std::exception &e) {
-    query.status = ::ttnn::graph::ExecutionStatus::Error;
-    query.error_message = e.what();
-  }
+llvm::Expected<size_t> getOpRuntime(llvm::StringRef cacheKey,
+                                    Callable &callable) {
+  auto computeRuntime = [&]() -> llvm::Expected<size_t> {
+    ::ttnn::graph::RuntimeQueryResponse query;
+    try {
+      query = callable();
+    } catch (const std::exception &e) {
+      query.status = ::ttnn::graph::ExecutionStatus::Error;
+      query.error_message = e.what();
+    }
 
-  // Check if query was successful
-  if (query.status != ::ttnn::graph::ExecutionStatus::Success) {
-    return llvm::createStringError(
-        query.error_message.value_or("<error message not set>"));
-  }
+    // Check if query was successful
+    if (query.status != ::ttnn::graph::ExecutionStatus::Success) {
+      return llvm::createStringError(
+          query.error_message.value_or("<error message not set>"));
+    }
+
+    return query.runtime;
+  };
 
-  return query.runtime;
+  return OpModelCache::getInstance().getOrComputeRuntime(cacheKey,
+                                                         computeRuntime);
 }
 
 } // namespace operation
@@ -425,8 +444,10 @@ getEltwiseUnaryOpConstraints(std::string_view opName, OpSymbol opSymbol,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpConstraints(opName, inputLayout.getContext(),
-                                     deviceGrid, query);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey(opName, deviceGrid, inputShape, inputLayout,
+                            outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, query);
 }
 
 template <typename OpSymbol>
@@ -453,7 +474,10 @@ getEltwiseUnaryOpRuntime(std::string_view opName, OpSymbol opSymbol,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime(opName, query);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey(opName, inputShape, inputLayout, outputShape,
+                            outputLayout),
+      query);
 }
 #endif
 
@@ -510,8 +534,11 @@ getEltwiseBinaryOpConstraints(std::string_view opName, OpSymbol opSymbol,
                                                outputMemoryConfig);
   };
 
-  return operation::getOpConstraints(opName, inputLayoutA.getContext(),
-                                     deviceGrid, query);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey(opName, deviceGrid, inputShapeA, inputLayoutA,
+                            inputShapeB, inputLayoutB, outputShape,
+                            outputLayout),
+      inputLayoutA.getContext(), deviceGrid, query);
 }
 
 template <typename OpSymbol>
@@ -559,7 +586,10 @@ getEltwiseBinaryOpRuntime(std::string_view opName, OpSymbol opSymbol,
                                            outputMemoryConfig);
   };
 
-  return operation::getOpRuntime(opName, query);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey(opName, inputShapeA, inputLayoutA, inputShapeB,
+                            inputLayoutB, outputShape, outputLayout),
+      query);
 }
 #endif
 
@@ -661,7 +691,9 @@ SigmoidOpInterface::getOpConstraints(
   };
 
   return operation::getOpConstraints(
-      "SigmoidOpInterface", inputLayout.getContext(), deviceGrid, query);
+      OpModelCache::makeKey("SigmoidOpInterface", deviceGrid, inputShape,
+                            inputLayout, outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, query);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -695,7 +727,10 @@ SigmoidOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShape,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("SigmoidOpInterface", query);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("SigmoidOpInterface", inputShape, inputLayout,
+                            outputShape, outputLayout),
+      query);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -766,9 +801,10 @@ SoftmaxOpInterface::getOpConstraints(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpConstraints("SoftmaxOpInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     softmaxOpQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("SoftmaxOpInterface", deviceGrid, inputShape,
+                            inputLayout, dimArg, outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, softmaxOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -798,7 +834,10 @@ SoftmaxOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShape,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("SoftmaxOpInterface", softmaxOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("SoftmaxOpInterface", inputShape, inputLayout,
+                            dimArg, outputShape, outputLayout),
+      softmaxOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -842,7 +881,9 @@ MeanOpInterface::getOpConstraints(GridAttr deviceGrid,
   };
 
   return operation::getOpConstraints(
-      "MeanOpInterface", inputLayout.getContext(), deviceGrid, meanOpQuery);
+      OpModelCache::makeKey("MeanOpInterface", deviceGrid, inputShape,
+                            inputLayout, dimArg, keepDim, outputLayout),
+      inputLayout.getContext(), deviceGrid, meanOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -880,7 +921,10 @@ MeanOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShape,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("MeanOpInterface", meanOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("MeanOpInterface", inputShape, inputLayout, dimArg,
+                            keepDim, outputLayout),
+      meanOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -914,9 +958,10 @@ ReshapeOpInterface::getOpConstraints(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpConstraints("ReshapeOpInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     reshapeOpQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("ReshapeOpInterface", deviceGrid, inputShape,
+                            inputLayout, outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, reshapeOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -945,7 +990,10 @@ ReshapeOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShape,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("ReshapeOpInterface", reshapeOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("ReshapeOpInterface", inputShape, inputLayout,
+                            outputShape, outputLayout),
+      reshapeOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -980,9 +1028,10 @@ TypecastOpInterface::getOpConstraints(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpConstraints("typecastOpInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     typecastOpQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("TypecastOpInterface", deviceGrid, inputShape,
+                            inputLayout, dtype, outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, typecastOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1013,7 +1062,10 @@ TypecastOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShape,
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("TypecastOpInterface", typecastOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("TypecastOpInterface", inputShape, inputLayout,
+                            dtype, outputShape, outputLayout),
+      typecastOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1055,9 +1107,11 @@ ToLayoutOpInterface::getOpConstraints(
         detail::getNullableMemoryConfig(outputLayout),
         passDevicePtr ? device : nullptr);
   };
-  return operation::getOpConstraints("ToLayoutOpInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     toLayoutOpQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("ToLayoutOpInterface", deviceGrid, inputShape,
+                            inputLayout, outputDtype, outputLayout,
+                            passDevicePtr),
+      inputLayout.getContext(), deviceGrid, toLayoutOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1096,7 +1150,10 @@ ToLayoutOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShape,
         passDevicePtr ? device : nullptr);
   };
 
-  return operation::getOpRuntime("ToLayoutOpInterface", toLayoutOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("ToLayoutOpInterface", inputShape, inputLayout,
+                            outputDtype, outputLayout, passDevicePtr),
+      toLayoutOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1129,9 +1186,10 @@ TransposeOpInterface::getOpConstraints(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpConstraints("TransposeOpInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     transposeOpQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("TransposeOpInterface", deviceGrid, inputShape,
+                            inputLayout, dim0, dim1, outputLayout),
+      inputLayout.getContext(), deviceGrid, transposeOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1159,7 +1217,10 @@ llvm::Expected<size_t> TransposeOpInterface::getOpRuntime(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("TransposeOpInterface", transposeOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("TransposeOpInterface", inputShape, inputLayout,
+                            dim0, dim1, outputLayout),
+      transposeOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1216,9 +1277,11 @@ MatmulOpInterface::getOpConstraints(GridAttr deviceGrid,
         outputMemoryConfig, outputDType);
   };
 
-  return operation::getOpConstraints("MatmulOpInterface",
-                                     inputLayoutA.getContext(), deviceGrid,
-                                     matmulOpQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("MatmulOpInterface", deviceGrid, inputShapeA,
+                            inputLayoutA, inputShapeB, inputLayoutB,
+                            outputShape, outputLayout, transposeA, transposeB),
+      inputLayoutA.getContext(), deviceGrid, matmulOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1270,7 +1333,11 @@ MatmulOpInterface::getOpRuntime(llvm::ArrayRef<int64_t> inputShapeA,
                                            outputMemoryConfig, outputDType);
   };
 
-  return operation::getOpRuntime("MatmulOpInterface", matmulOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("MatmulOpInterface", inputShapeA, inputLayoutA,
+                            inputShapeB, inputLayoutB, outputShape,
+                            outputLayout, transposeA, transposeB),
+      matmulOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1390,7 +1457,13 @@ Conv2dOpInterface::getOpConstraints(
   };
 
   return operation::getOpConstraints(
-      "Conv2dOpInterface", inputLayout.getContext(), deviceGrid, conv2dOpQuery);
+      OpModelCache::makeKey("Conv2dOpInterface", deviceGrid, inputShape,
+                            inputLayout, weightShape, weightLayout, biasShape,
+                            biasLayout, in_channels, out_channels, batch_size,
+                            input_height, input_width, kernel_size, stride,
+                            padding, dilation, groups, conv2dConfig,
+                            outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, conv2dOpQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1469,7 +1542,14 @@ llvm::Expected<size_t> Conv2dOpInterface::getOpRuntime(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("Conv2dOpInterface", conv2dOpQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("Conv2dOpInterface", inputShape, inputLayout,
+                            weightShape, weightLayout, biasShape, biasLayout,
+                            in_channels, out_channels, batch_size,
+                            input_height, input_width, kernel_size, stride,
+                            padding, dilation, groups, conv2dConfig,
+                            outputShape, outputLayout),
+      conv2dOpQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1521,9 +1601,12 @@ MaxPool2DInterface::getOpConstraints(
         std::nullopt /* applied_shard_scheme */, ceilMode);
   };
 
-  return operation::getOpConstraints("MaxPool2DInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     maxPool2DQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("MaxPool2DInterface", deviceGrid, inputShape,
+                            inputLayout, batchSize, inputHeight, inputWidth,
+                            inputChannels, kernelSize, stride, padding,
+                            dilation, ceilMode, outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, maxPool2DQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1569,7 +1652,12 @@ llvm::Expected<size_t> MaxPool2DInterface::getOpRuntime(
         std::nullopt /* applied_shard_scheme */, ceilMode);
   };
 
-  return operation::getOpRuntime("MaxPool2DInterface", maxPool2DQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("MaxPool2DInterface", inputShape, inputLayout,
+                            batchSize, inputHeight, inputWidth, inputChannels,
+                            kernelSize, stride, padding, dilation, ceilMode,
+                            outputShape, outputLayout),
+      maxPool2DQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1608,9 +1696,10 @@ ClampScalarInterface::getOpConstraints(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpConstraints("ClampScalarInterface",
-                                     inputLayout.getContext(), deviceGrid,
-                                     clampScalarQuery);
+  return operation::getOpConstraints(
+      OpModelCache::makeKey("ClampScalarInterface", deviceGrid, inputShape,
+                            inputLayout, min, max, outputShape, outputLayout),
+      inputLayout.getContext(), deviceGrid, clampScalarQuery);
 #else
   return std::make_tuple(0, 0, 0, nullptr);
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -1644,7 +1733,10 @@ llvm::Expected<size_t> ClampScalarInterface::getOpRuntime(
         detail::getNullableMemoryConfig(outputLayout));
   };
 
-  return operation::getOpRuntime("ClampScalarInterface", clampScalarQuery);
+  return operation::getOpRuntime(
+      OpModelCache::makeKey("ClampScalarInterface", inputShape, inputLayout,
+                            min, max, outputShape, outputLayout),
+      clampScalarQuery);
 #else
   return llvm::createStringError("Not Implemented");
 #endif // TTMLIR_ENABLE_OPMODEL
@@ -11,6 +11,14 @@
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Operation.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
 
 namespace mlir::tt::scheduler {
 
@@ -25,68 +33,216 @@ static bool isTTIRSchedulableOp(mlir::Operation *op) {
          !llvm::isa<ttir::EmptyOp>(op);
 }
 
-bool Scheduler::isTTSchedulableOp(mlir::Operation *op) {
+static bool isSchedulableOp(mlir::Operation *op) {
   return isTTNNScheduleableOp(op) || isTTIRSchedulableOp(op);
 }
 
-// Init the dependencies map of all ops which are TTIR ops
-Scheduler::Scheduler(func::FuncOp *func) {
-  for (auto &op : func->getOps()) {
-    if (isTTSchedulableOp(&op)) {
-      dependencies[&op] = {};
-      unscheduledOps.insert(&op);
+// Size of a statically shaped tensor, zero for other types.
+static int64_t getTensorSizeInBytes(mlir::Type type) {
+  auto tensorType = mlir::dyn_cast<RankedTensorType>(type);
+  if (!tensorType || !tensorType.hasStaticShape() ||
+      !tensorType.getElementType().isIntOrFloat()) {
+    return 0;
+  }
+  return tensorType.getNumElements() *
+         llvm::divideCeil(tensorType.getElementType().getIntOrFloatBitWidth(),
+                          8);
+}
+
+struct Scheduler::Graph {
+  // Schedulable ops in program order.
+  llvm::SmallVector<mlir::Operation *> ops;
+  llvm::DenseMap<mlir::Operation *, unsigned> opIndices;
+  // Schedulable users of each op, without duplicates.
+  llvm::SmallVector<llvm::SmallVector<unsigned, 4>> users;
+  // Number of schedulable ops each op depends on.
+  llvm::SmallVector<unsigned> numDependencies;
+  // Position of each op when ordered by priority, and its inverse.
+  llvm::SmallVector<unsigned> ranks;
+  llvm::SmallVector<unsigned> opsByRank;
+
+  explicit Graph(func::FuncOp func) {
+    for (auto &op : func.getOps()) {
+      if (isSchedulableOp(&op)) {
+        opIndices[&op] = ops.size();
+        ops.push_back(&op);
+      }
+    }
+
+    users.resize(ops.size());
+    numDependencies.assign(ops.size(), 0);
+    for (auto [index, op] : llvm::enumerate(ops)) {
+      if (op->getNumResults() == 0) {
+        continue;
+      }
+
+      llvm::SmallSetVector<unsigned, 4> uniqueUsers;
+      for (mlir::Operation *user : op->getResult(0).getUsers()) {
+        auto userIndex = opIndices.find(user);
+        if (user != op && userIndex != opIndices.end()) {
+          uniqueUsers.insert(userIndex->second);
+        }
+      }
+      for (unsigned user : uniqueUsers) {
+        users[index].push_back(user);
+        numDependencies[user]++;
+      }
+    }
+  }
+
+  void setPriorities(llvm::ArrayRef<int64_t> priorities) {
+    assert(priorities.size() == ops.size());
+    opsByRank.resize(ops.size());
+    std::iota(opsByRank.begin(), opsByRank.end(), 0);
+    std::stable_sort(opsByRank.begin(), opsByRank.end(),
+                     [&](unsigned a, unsigned b) {
+                       return priorities[a] > priorities[b];
+                     });
+    ranks.resize(ops.size());
+    for (auto [rank, index] : llvm::enumerate(opsByRank)) {
+      ranks[index] = rank;
     }
   }
 
-  for (auto &op : func->getOps()) {
-    // Skip non TTIR operations
-    // Skip operations which do not implement DestinationStyleOpInterface
-    if (!isTTSchedulableOp(&op)) {
-      continue;
+  // Number of ops on the longest dependency chain starting at each op. Ops
+  // in a function body are in topological order, so users are visited first
+  // when walking the ops backwards.
+  llvm::SmallVector<int64_t> getCriticalPathPriorities() const {
+    llvm::SmallVector<int64_t> priorities(ops.size(), 1);
+    for (size_t index = ops.size(); index-- > 0;) {
+      for (unsigned user : users[index]) {
+        priorities[index] = std::max(priorities[index], priorities[user] + 1);
+      }
     }
+    return priorities;
+  }
+
+  // Bytes of operands minus bytes of results, so that ops which can release
+  // the most memory come first.
+  llvm::SmallVector<int64_t> getMemoryPressurePriorities() const {
+    llvm::SmallVector<int64_t> priorities(ops.size(), 0);
+    for (auto [index, op] : llvm::enumerate(ops)) {
+      for (mlir::Value operand : op->getOperands()) {
+        priorities[index] += getTensorSizeInBytes(operand.getType());
+      }
+      for (mlir::Value result : op->getResults()) {
+        priorities[index] -= getTensorSizeInBytes(result.getType());
+      }
+    }
+    return priorities;
+  }
+};
 
-    OpResult result = op.getResult(0);
+struct Scheduler::State {
+  // Number of unscheduled ops each op depends on.
+  llvm::SmallVector<unsigned> pendingDependencies;
+  llvm::BitVector scheduled;
+  size_t numUnscheduled;
+  // Ranks of the ops which can be scheduled.
+  std::set<unsigned> readyRanks;
+  // Operation schedule in order of execution
+  llvm::SmallVector<mlir::Operation *> schedule;
 
-    for (mlir::Operation *use : result.getUsers()) {
-      // Skip non TTIR operations
-      // Skip operations which set the result
-      if (isTTSchedulableOp(use) && use->getResult(0) != result) {
-        dependencies[use].push_back(&op);
+  explicit State(const Graph &graph)
+      : pendingDependencies(graph.numDependencies),
+        scheduled(graph.ops.size()), numUnscheduled(graph.ops.size()) {
+    for (auto [index, numDependencies] :
+         llvm::enumerate(graph.numDependencies)) {
+      if (numDependencies == 0) {
+        readyRanks.insert(graph.ranks[index]);
       }
     }
   }
+};
+
+bool Scheduler::isTTSchedulableOp(mlir::Operation *op) {
+  return isSchedulableOp(op);
+}
+
+Scheduler::Scheduler(func::FuncOp *func, SchedulePriority priority) {
+  auto newGraph = std::make_shared<Graph>(*func);
+  switch (priority) {
+  case SchedulePriority::ProgramOrder:
+    newGraph->setPriorities(
+        llvm::SmallVector<int64_t>(newGraph->ops.size(), 0));
+    break;
+  case SchedulePriority::CriticalPath:
+    newGraph->setPriorities(newGraph->getCriticalPathPriorities());
+    break;
+  case SchedulePriority::MemoryPressure:
+    newGraph->setPriorities(newGraph->getMemoryPressurePriorities());
+    break;
+  }
+  state = std::make_shared<State>(*newGraph);
+  graph = std::move(newGraph);
+}
+
+Scheduler::Scheduler(func::FuncOp *func, PriorityFn priority) {
+  auto newGraph = std::make_shared<Graph>(*func);
+  newGraph->setPriorities(
+      llvm::to_vector(llvm::map_range(newGraph->ops, priority)));
+  state = std::make_shared<State>(*newGraph);
+  graph = std::move(newGraph);
 }
 
 Scheduler::Scheduler(const Scheduler &scheduler)
-    : scheduledOpsMap(scheduler.scheduledOpsMap), schedule(scheduler.schedule),
-      unscheduledOps(scheduler.unscheduledOps),
-      dependencies(scheduler.dependencies) {}
+    : graph(scheduler.graph), state(scheduler.state) {}
+
+Scheduler::State &Scheduler::getMutableState() {
+  if (state.use_count() > 1) {
+    state = std::make_shared<State>(*state);
+  }
+  return *state;
+}
 
 llvm::SmallVector<mlir::Operation *> Scheduler::getScheduleableOps() {
   llvm::SmallVector<mlir::Operation *> scheduleableOps;
-  for (auto &op : unscheduledOps) {
-    if (canSchedule(op)) {
-      scheduleableOps.push_back(op);
-    }
+  scheduleableOps.reserve(state->readyRanks.size());
+  for (unsigned rank : state->readyRanks) {
+    scheduleableOps.push_back(graph->ops[graph->opsByRank[rank]]);
   }
 
   return scheduleableOps;
 }
 
 bool Scheduler::canSchedule(mlir::Operation *op) {
-  for (mlir::Operation *dep : dependencies[op]) {
-    if (!scheduledOpsMap.count(dep)) {
-      return false;
-    }
+  auto index = graph->opIndices.find(op);
+  if (index == graph->opIndices.end()) {
+    return true;
   }
 
-  return true;
+  return state->pendingDependencies[index->second] == 0;
+}
+
+bool Scheduler::isScheduled(mlir::Operation *op) const {
+  auto index = graph->opIndices.find(op);
+  if (index == graph->opIndices.end()) {
+    return llvm::is_contained(state->schedule, op);
+  }
+
+  return state->scheduled.test(index->second);
 }
 
 void Scheduler::scheduleOp(mlir::Operation *op) {
-  scheduledOpsMap.insert(op);
-  unscheduledOps.erase(op);
-  schedule.push_back(op);
+  State &current = getMutableState();
+  current.schedule.push_back(op);
+
+  auto index = graph->opIndices.find(op);
+  if (index == graph->opIndices.end()) {
+    return;
+  }
+
+  assert(!current.scheduled.test(index->second) && "Op is already scheduled");
+  current.scheduled.set(index->second);
+  current.numUnscheduled--;
+  current.readyRanks.erase(graph->ranks[index->second]);
+
+  for (unsigned user : graph->users[index->second]) {
+    if (--current.pendingDependencies[user] == 0 &&
+        !current.scheduled.test(user)) {
+      current.readyRanks.insert(graph->ranks[user]);
+    }
+  }
 }
 
 std::unique_ptr<Scheduler> Scheduler::snapshot() {
@@ -94,8 +250,10 @@ std::unique_ptr<Scheduler> Scheduler::snapshot() {
 }
 
 llvm::SmallVector<mlir::Operation *> Scheduler::getSchedule() const {
-  return schedule;
+  return state->schedule;
 }
 
-bool Scheduler::hasUnscheduledOps() const { return !unscheduledOps.empty(); }
+bool Scheduler::hasUnscheduledOps() const {
+  return state->numUnscheduled > 0;
+}
 } // namespace mlir::tt::scheduler
@@ -4,6 +4,7 @@
 
 #include "ttmlir/Target/LLVM/LLVMToDynamicLib.h"
 #include "ttmlir/Dialect/TT/IR/TTOps.h"
+#include "ttmlir/Version.h"
 
 #include "mlir/Conversion/LLVMCommon/ConversionTarget.h"
 #include "mlir/Conversion/LLVMCommon/Pattern.h"
@@ -14,16 +15,22 @@
 #include "mlir/Target/LLVMIR/ModuleTranslation.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
@@ -31,6 +38,14 @@
 
 #include "mlir/IR/BuiltinOps.h"
 #include <fstream>
+#include <mutex>
+#include <optional>
+
+#ifdef TTMLIR_ENABLE_LLD
+#include "lld/Common/Driver.h"
+
+LLD_HAS_DRIVER(elf)
+#endif
 
 namespace mlir::tt::llvm_to_cpu {
 
@@ -41,6 +56,37 @@ static llvm::cl::opt<bool>
                      llvm::cl::desc("Delete temporary files after translation"),
                      llvm::cl::init(true));
 
+// Optimization level of the LLVM pipeline run before code generation.
+static llvm::cl::opt<unsigned>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    dylibOptLevel("dylib-opt-level",
+                  llvm::cl::desc("Optimization level (0-3) of dylib code"),
+                  llvm::cl::init(2));
+
+// Target CPU of the dylib. "host" also enables all features of the host CPU,
+// so the dylib may not run on older machines.
+static llvm::cl::opt<std::string>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    dylibCPU("dylib-mcpu",
+             llvm::cl::desc("Target CPU of dylib code, e.g. x86-64-v3 or host"),
+             llvm::cl::init("generic"));
+
+static llvm::cl::opt<std::string>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    dylibFeatures("dylib-mattr",
+                  llvm::cl::desc("Target features of dylib code, e.g. "
+                                 "+avx2,+fma"),
+                  llvm::cl::init(""));
+
+// Compiled objects are cached in memory for the lifetime of the process, and
+// also on disk when a directory is given.
+static llvm::cl::opt<std::string>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    dylibObjectCacheDir(
+        "dylib-object-cache-dir",
+        llvm::cl::desc("Directory used to cache compiled dylib objects"),
+        llvm::cl::init(""));
+
 // Create randomized tempDir to store our temp files.
 llvm::SmallString<128> createTempDir() {
   llvm::SmallString<128> tempDir;
@@ -78,6 +124,24 @@ convertToLLVMModule(mlir::ModuleOp cpuModule, llvm::LLVMContext &llvmContext) {
   return llvmModule;
 }
 
+// Resolve the target CPU and comma separated feature string from the dylib
+// options. Explicit features are appended last so they override host ones.
+std::pair<std::string, std::string> getTargetCPUAndFeatures() {
+  std::string cpu = dylibCPU;
+  llvm::SmallVector<std::string> features;
+  if (cpu == "host") {
+    cpu = llvm::sys::getHostCPUName().str();
+    for (const auto &feature : llvm::sys::getHostCPUFeatures()) {
+      features.push_back((feature.getValue() ? "+" : "-") +
+                         feature.getKey().str());
+    }
+  }
+  if (!dylibFeatures.empty()) {
+    features.push_back(dylibFeatures);
+  }
+  return {cpu, llvm::join(features, ",")};
+}
+
 // Get an llvm::TargetMachine with proper default options.
 std::unique_ptr<llvm::TargetMachine>
 createTargetMachine(llvm::StringRef targetTriple) {
@@ -90,14 +154,50 @@ createTargetMachine(llvm::StringRef targetTriple) {
     return nullptr;
   }
 
+  if (dylibOptLevel > 3) {
+    llvm::errs() << "Invalid dylib optimization level " << dylibOptLevel
+                 << "\n";
+    return nullptr;
+  }
+
+  auto [cpu, features] = getTargetCPUAndFeatures();
   llvm::TargetOptions options;
+  auto codeGenOptLevel = llvm::CodeGenOpt::getLevel(dylibOptLevel);
 
   std::unique_ptr<llvm::TargetMachine> machine(llvmTarget->createTargetMachine(
-      targetTriple, "generic" /* cpu e.g k8 */,
-      "" /* cpu features e.g avx512f */, options, llvm::Reloc::Model::PIC_));
+      targetTriple, cpu, features, options, llvm::Reloc::Model::PIC_,
+      std::nullopt, codeGenOptLevel.value_or(llvm::CodeGenOptLevel::Default)));
   return machine;
 }
 
+// Run the default LLVM optimization pipeline, which includes loop and SLP
+// vectorization for the features of the target machine.
+void optimizeModule(llvm::Module &module, llvm::TargetMachine &targetMachine) {
+  if (dylibOptLevel == 0) {
+    return;
+  }
+
+  llvm::LoopAnalysisManager loopAnalysisManager;
+  llvm::FunctionAnalysisManager functionAnalysisManager;
+  llvm::CGSCCAnalysisManager cgsccAnalysisManager;
+  llvm::ModuleAnalysisManager moduleAnalysisManager;
+
+  llvm::PassBuilder passBuilder(&targetMachine);
+  passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+  passBuilder.registerCGSCCAnalyses(cgsccAnalysisManager);
+  passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+  passBuilder.registerLoopAnalyses(loopAnalysisManager);
+  passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager,
+                                   cgsccAnalysisManager, moduleAnalysisManager);
+
+  const llvm::OptimizationLevel levels[] = {
+      llvm::OptimizationLevel::O0, llvm::OptimizationLevel::O1,
+      llvm::OptimizationLevel::O2, llvm::OptimizationLevel::O3};
+  llvm::ModulePassManager modulePassManager =
+      passBuilder.buildPerModuleDefaultPipeline(levels[dylibOptLevel]);
+  modulePassManager.run(module, moduleAnalysisManager);
+}
+
 // Generate .o file from LLVM Module.
 llvm::LogicalResult compileToObject(llvm::Module &module,
                                     llvm::LLVMContext &context,
@@ -126,6 +226,7 @@ llvm::LogicalResult compileToObject(llvm::Module &module,
   }
 
   module.setDataLayout(targetMachine->createDataLayout());
+  optimizeModule(module, *targetMachine);
 
   // Create an output file stream to write the object file.
   std::error_code EC;
@@ -164,13 +265,42 @@ llvm::LogicalResult runLinkCommand(llvm::StringRef commandLine) {
   return llvm::failure();
 }
 
+#ifdef TTMLIR_ENABLE_LLD
+// Link with the lld library in this process. lld keeps global state, so links
+// are serialized. Returns std::nullopt once lld reports that it can't safely
+// run again, so that callers fall back to the external linker.
+std::optional<llvm::LogicalResult>
+runInProcessLinker(ArrayRef<std::string> flags) {
+  static std::mutex linkMutex;
+  static bool canRunAgain = true;
+  std::lock_guard<std::mutex> lock(linkMutex);
+  if (!canRunAgain) {
+    return std::nullopt;
+  }
+
+  SmallVector<const char *> args = {"ld.lld"};
+  for (const auto &flag : flags) {
+    args.push_back(flag.c_str());
+  }
+  // The dylib may be written to stdout by the caller, so lld's own output
+  // goes to stderr.
+  lld::Result result = lld::lldMain(args, llvm::errs(), llvm::errs(),
+                                    {{lld::Gnu, &lld::elf::link}});
+  canRunAgain = result.canRunAgain;
+  if (result.retCode != 0) {
+    llvm::errs() << "Linking failed; lld returned exit code "
+                 << result.retCode << "\n";
+    return llvm::failure();
+  }
+  return llvm::success();
+}
+#endif
+
 // Invoke linker with correct options on set of .o files.
 llvm::LogicalResult
 linkDynamicLibrary(llvm::StringRef libraryName,
                    ArrayRef<llvm::StringRef> objectFileNames) {
-  SmallVector<llvm::SmallString<13>, 8> flags = {
-      llvm::SmallString<13>("ld.lld-17"), llvm::SmallString<13>("-o"),
-      libraryName};
+  SmallVector<std::string, 8> flags = {"-o", libraryName.str()};
 
   // No stdlib dependency makes things easier for us
   flags.emplace_back("-nostdlib");
@@ -189,13 +319,109 @@ linkDynamicLibrary(llvm::StringRef libraryName,
     flags.emplace_back(objectFile);
   }
 
-  auto commandLine = llvm::join(flags, " ");
+#ifdef TTMLIR_ENABLE_LLD
+  if (auto result = runInProcessLinker(flags)) {
+    return *result;
+  }
+#endif
+
+  auto commandLine = "ld.lld-17 " + llvm::join(flags, " ");
   if (llvm::failed(runLinkCommand(commandLine))) {
     return llvm::failure();
   }
   return llvm::success();
 }
 
+// Key of the compiled object of a module: a hash of its IR and everything
+// that affects code generation, including the LLVM and compiler versions so
+// that objects built by another toolchain are not reused.
+std::string getObjectCacheKey(llvm::Module &module) {
+  auto [cpu, features] = getTargetCPUAndFeatures();
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  module.print(os, nullptr);
+  os << '\0' << llvm::sys::getDefaultTargetTriple() << '\0' << cpu << '\0'
+     << features << '\0' << dylibOptLevel << '\0' << LLVM_VERSION_STRING
+     << '\0' << ::ttmlir::getGitHash();
+  os.flush();
+  return llvm::utohexstr(llvm::xxh3_64bits(key), /*LowerCase=*/true,
+                         /*Width=*/16);
+}
+
+// Compiled objects of this process, by cache key.
+struct ObjectCache {
+  std::mutex mutex;
+  llvm::StringMap<std::string> objects;
+};
+
+ObjectCache &getObjectCache() {
+  static ObjectCache objectCache;
+  return objectCache;
+}
+
+// Write the cached object with the given key to objectFileName, looking in
+// memory first and then in the cache directory.
+bool loadCachedObject(llvm::StringRef key, llvm::StringRef objectFileName) {
+  ObjectCache &objectCache = getObjectCache();
+  {
+    std::lock_guard<std::mutex> lock(objectCache.mutex);
+    auto it = objectCache.objects.find(key);
+    if (it != objectCache.objects.end()) {
+      std::error_code EC;
+      llvm::raw_fd_ostream out(objectFileName, EC, llvm::sys::fs::OF_None);
+      if (EC) {
+        return false;
+      }
+      out << it->second;
+      return true;
+    }
+  }
+
+  if (dylibObjectCacheDir.empty()) {
+    return false;
+  }
+  llvm::SmallString<128> cachedFileName;
+  llvm::sys::path::append(cachedFileName, dylibObjectCacheDir, key + ".o");
+  auto buffer = llvm::MemoryBuffer::getFile(cachedFileName);
+  if (!buffer || llvm::sys::fs::copy_file(cachedFileName, objectFileName)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(objectCache.mutex);
+  objectCache.objects[key] = (*buffer)->getBuffer().str();
+  return true;
+}
+
+// Add a freshly compiled object to the caches. The cache directory is written
+// through a temporary file, so concurrent compilers never see partial
+// objects.
+void storeCachedObject(llvm::StringRef key, llvm::StringRef objectFileName) {
+  auto buffer = llvm::MemoryBuffer::getFile(objectFileName);
+  if (!buffer) {
+    return;
+  }
+  ObjectCache &objectCache = getObjectCache();
+  {
+    std::lock_guard<std::mutex> lock(objectCache.mutex);
+    objectCache.objects[key] = (*buffer)->getBuffer().str();
+  }
+
+  if (dylibObjectCacheDir.empty() ||
+      llvm::sys::fs::create_directories(dylibObjectCacheDir)) {
+    return;
+  }
+  llvm::SmallString<128> cachedFileName;
+  llvm::sys::path::append(cachedFileName, dylibObjectCacheDir, key + ".o");
+  llvm::SmallString<128> tempFileName;
+  if (llvm::sys::fs::createUniqueFile(
+          llvm::Twine(cachedFileName) + ".tmp-%%%%%%", tempFileName) ||
+      llvm::sys::fs::copy_file(objectFileName, tempFileName)) {
+    return;
+  }
+  if (llvm::sys::fs::rename(tempFileName, cachedFileName)) {
+    llvm::sys::fs::remove(tempFileName);
+  }
+}
+
 // Verify that all operations in given module are in LLVM Dialect.
 llvm::LogicalResult verifyAllLLVM(mlir::ModuleOp module) {
   auto *llvmDialect =
@@ -227,10 +453,14 @@ compileAndLinkToSharedLibrary(llvm::Module &module,
   const auto tmpDirName = createTempDir();
   const auto tmpObjFileName =
       createTempFile(tmpDirName, module.getName(), ".o");
-  // Compile to object code
-  if (llvm::failed(compileToObject(module, context, tmpObjFileName))) {
-    llvm::errs() << "Failed to compile to object code\n";
-    return std::nullopt;
+  // Compile to object code, unless the same module was compiled before.
+  const auto objectCacheKey = getObjectCacheKey(module);
+  if (!loadCachedObject(objectCacheKey, tmpObjFileName)) {
+    if (llvm::failed(compileToObject(module, context, tmpObjFileName))) {
+      llvm::errs() << "Failed to compile to object code\n";
+      return std::nullopt;
+    }
+    storeCachedObject(objectCacheKey, tmpObjFileName);
   }
 
   auto dylibName = createTempFile(tmpDirName, module.getName(), ".so");
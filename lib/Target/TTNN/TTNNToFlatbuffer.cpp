@@ -37,7 +37,9 @@
 #include "mlir/Dialect/Quant/IR/QuantTypes.h"
 #include "mlir/Support/LogicalResult.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace mlir::tt {
@@ -56,8 +58,57 @@ static OpType findOpAtTopLevel(mlir::ModuleOp module) {
 
 namespace mlir::tt::ttnn {
 
+// Generating the C++ dump runs the whole EmitC conversion, which dominates
+// translation time for large models.
+static llvm::cl::opt<bool>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    embedCpp("ttnn-flatbuffer-emit-cpp",
+             llvm::cl::desc("Generate the C++ equivalent of the program for "
+                            "the flatbuffer debug info"),
+             llvm::cl::init(true));
+
+static llvm::cl::opt<std::string>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    debugArtifactsPath(
+        "ttnn-flatbuffer-debug-artifacts",
+        llvm::cl::desc("Write the C++ dump and intermediate MLIR stages to "
+                       "this JSON file instead of embedding them in the "
+                       "flatbuffer"),
+        llvm::cl::init(""));
+
+// Writes debug payloads that were left out of the binary to a sidecar file,
+// in the layout of the DebugInfo table so that tools can read either.
+static LogicalResult writeDebugArtifacts(
+    Operation *op, llvm::StringRef path, llvm::StringRef cpp,
+    const std::vector<std::pair<std::string, std::string>> &moduleCache) {
+  std::error_code ec;
+  llvm::raw_fd_ostream os(path, ec);
+  if (ec) {
+    return op->emitError() << "could not open debug artifacts file " << path
+                           << ": " << ec.message();
+  }
+
+  llvm::json::OStream json(os);
+  json.object([&]() {
+    json.attribute("cpp", cpp);
+    json.attributeArray("mlir_stages", [&]() {
+      for (const auto &[name, source] : moduleCache) {
+        json.object([&]() {
+          json.attribute("name", name);
+          json.attribute("source", source);
+        });
+      }
+    });
+  });
+  return success();
+}
+
 constexpr uint64_t kHostAllocatedSize = 0;
 
+// Alignment of constant tensor data within the binary. Matches the alignment
+// of the heap buffers binaries are loaded into.
+constexpr size_t kConstantDataAlignment = 16;
+
 #define GEN_PASS_DEF_TTNNSERIALIZETOBINARY
 #include "ttmlir/Dialect/TTNN/Transforms/Passes.h.inc"
 
@@ -990,21 +1041,25 @@ createOp(FlatbufferObjectCache &cache, FillCacheOp op) {
 createOp(FlatbufferObjectCache &cache, ttnn::ConstantOp op) {
   auto output = cache.getOrCreate(op.getResult(), tensorValueToFlatbuffer,
                                   kHostAllocatedSize);
-  std::vector<uint8_t> rawVector;
+  ArrayRef<char> rawData;
   if (auto data =
           mlir::dyn_cast<mlir::DenseResourceElementsAttr>(op.getValue())) {
-    ArrayRef<char> rawData = data.getData();
-    rawVector = std::vector<uint8_t>(rawData.begin(), rawData.end());
+    rawData = data.getData();
   } else if (auto data =
                  mlir::dyn_cast<mlir::DenseElementsAttr>(op.getValue())) {
-    ArrayRef<char> rawData = data.getRawData();
-    rawVector = std::vector<uint8_t>(rawData.begin(), rawData.end());
+    rawData = data.getRawData();
   } else {
     llvm_unreachable("Unknown constant value attribute type");
   }
 
-  return ::tt::target::ttnn::CreateConstantOpDirect(*cache.fbb, output,
-                                                    &rawVector);
+  // Copy straight from the attribute storage into the builder, aligned so
+  // that the runtime can view the data in place.
+  cache.fbb->ForceVectorAlignment(rawData.size(), sizeof(uint8_t),
+                                  kConstantDataAlignment);
+  auto rawVector = cache.fbb->CreateVector(
+      reinterpret_cast<const uint8_t *>(rawData.data()), rawData.size());
+
+  return ::tt::target::ttnn::CreateConstantOp(*cache.fbb, output, rawVector);
 }
 
 template <typename EltwiseBinaryOp>
@@ -2106,13 +2161,28 @@ std::shared_ptr<void> ttnnToFlatbuffer(
                               module->getAttr(tt::SystemDescAttr::name)));
 
   std::string cpp;
-  llvm::raw_string_ostream os(cpp);
-  auto result = mlir::tt::ttnn::emitTTNNAsCpp(module, os);
-  (void)result;
-
-  flatbuffers::Offset<::tt::target::DebugInfo> debugInfo =
-      debugInfoToFlatbuffer(fbb, "ttnn", rootModule, goldenMap, moduleCache,
-                            cpp.c_str());
+  if (embedCpp) {
+    llvm::raw_string_ostream os(cpp);
+    auto result = mlir::tt::ttnn::emitTTNNAsCpp(module, os);
+    (void)result;
+  }
+
+  // Debug payloads are shared by all programs, so they are only serialized
+  // once; with a sidecar file they are left out of the binary entirely.
+  flatbuffers::Offset<::tt::target::DebugInfo> debugInfo;
+  if (!debugArtifactsPath.empty()) {
+    if (failed(writeDebugArtifacts(rootModule, debugArtifactsPath, cpp,
+                                   moduleCache))) {
+      return nullptr;
+    }
+    debugInfo = debugInfoToFlatbuffer(fbb, "ttnn", rootModule, goldenMap,
+                                      /*moduleCache=*/{}, /*cpp=*/nullptr,
+                                      debugArtifactsPath.c_str());
+  } else {
+    debugInfo = debugInfoToFlatbuffer(fbb, "ttnn", rootModule, goldenMap,
+                                      moduleCache,
+                                      embedCpp ? cpp.c_str() : nullptr);
+  }
 
   // Handle dylib creation and packaging, if needed.
   // Currently, we only have 1 CPUModuleOp and 1 top-level ModuleOp; we use a
@@ -2165,7 +2235,7 @@ std::shared_ptr<void> ttnnToFlatbuffer(
             programIdxMap);
     programs.push_back(::tt::target::ttnn::CreateProgramDirect(
         fbb, program.name, &program.inputs, &program.outputs, &program.ops,
-        &dylibs, debugInfo));
+        &dylibs, debugInfo, program.tensorIdBegin, program.numTensors));
   });
   // Then process const-eval funcs in 2nd pass.
   module->walk([&](func::FuncOp func) {
@@ -2178,7 +2248,7 @@ std::shared_ptr<void> ttnnToFlatbuffer(
             programIdxMap);
     programs.push_back(::tt::target::ttnn::CreateProgramDirect(
         fbb, program.name, &program.inputs, &program.outputs, &program.ops,
-        &dylibs, debugInfo));
+        &dylibs, debugInfo, program.tensorIdBegin, program.numTensors));
   });
 
   auto binary = ::tt::target::ttnn::CreateTTNNBinaryDirect(
@@ -2188,13 +2258,9 @@ std::shared_ptr<void> ttnnToFlatbuffer(
   ::flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
   ::tt::target::ttnn::VerifySizePrefixedTTNNBinaryBuffer(verifier);
 
-  uint8_t *buf = fbb.GetBufferPointer();
-  std::size_t size = fbb.GetSize();
-
-  std::shared_ptr<void> bufferPtr =
-      std::shared_ptr<void>(std::malloc(size), std::free);
-  std::memcpy(bufferPtr.get(), buf, size);
-  return bufferPtr;
+  // Hand out the builder's buffer itself rather than a copy of it.
+  auto buffer = std::make_shared<::flatbuffers::DetachedBuffer>(fbb.Release());
+  return std::shared_ptr<void>(buffer, buffer->data());
 }
 
 LogicalResult translateTTNNToFlatbuffer(
@@ -2202,6 +2268,9 @@ LogicalResult translateTTNNToFlatbuffer(
     const std::unordered_map<std::string, GoldenTensor> &goldenMap,
     const std::vector<std::pair<std::string, std::string>> &moduleCache) {
   std::shared_ptr<void> data = ttnnToFlatbuffer(op, goldenMap, moduleCache);
+  if (!data) {
+    return failure();
+  }
   std::size_t size = ::flatbuffers::GetSizePrefixedBufferLength(
       static_cast<const uint8_t *>(data.get()));
   os.write(reinterpret_cast<const char *>(data.get()), size);
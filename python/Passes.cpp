@@ -283,22 +283,42 @@ void populatePassesModule(nb::module_ &m) {
   });
 
   nb::class_<mlir::tt::GoldenTensor>(m, "GoldenTensor")
-      .def("__init__",
-           [](mlir::tt::GoldenTensor *self, std::string name,
-              std::vector<int64_t> shape, std::vector<int64_t> strides,
-              ::tt::target::DataType dtype, std::uintptr_t ptr,
-              std::size_t dataSize) {
-             new (self) mlir::tt::GoldenTensor(
-                 name, shape, strides, dtype,
-                 std::vector<std::uint8_t>(
-                     reinterpret_cast<std::uint8_t *>(ptr),
-                     reinterpret_cast<std::uint8_t *>(ptr) + dataSize));
-           })
+      .def(
+          "__init__",
+          [](mlir::tt::GoldenTensor *self, std::string name,
+             std::vector<int64_t> shape, std::vector<int64_t> strides,
+             ::tt::target::DataType dtype, std::uintptr_t ptr,
+             std::size_t dataSize, nb::object owner) {
+            auto *begin = reinterpret_cast<std::uint8_t *>(ptr);
+            if (owner.is_none()) {
+              new (self) mlir::tt::GoldenTensor(
+                  name, shape, strides, dtype,
+                  std::vector<std::uint8_t>(begin, begin + dataSize));
+              return;
+            }
+            // Borrow the buffer and hold a reference to the Python object
+            // that owns it for as long as any copy of the golden exists.
+            const void *handle = owner.ptr();
+            std::shared_ptr<const void> dataOwner(
+                handle, [ref = std::move(owner)](const void *) mutable {
+                  nb::gil_scoped_acquire gil;
+                  ref = nb::object();
+                });
+            new (self) mlir::tt::GoldenTensor(
+                name, shape, strides, dtype,
+                llvm::ArrayRef<std::uint8_t>(begin, dataSize),
+                std::move(dataOwner));
+          },
+          nb::arg("name"), nb::arg("shape"), nb::arg("strides"),
+          nb::arg("dtype"), nb::arg("ptr"), nb::arg("dataSize"),
+          nb::arg("owner").none() = nb::none())
       .def_rw("name", &mlir::tt::GoldenTensor::name)
       .def_rw("shape", &mlir::tt::GoldenTensor::shape)
       .def_rw("strides", &mlir::tt::GoldenTensor::strides)
       .def_rw("dtype", &mlir::tt::GoldenTensor::dtype)
-      .def_rw("data", &mlir::tt::GoldenTensor::data);
+      .def_prop_ro("data", [](const mlir::tt::GoldenTensor &self) {
+        return self.getData().vec();
+      });
 
   // Supposedly no need for shared_ptr holder types anymore, have python take
   // ownership of ModuleLog
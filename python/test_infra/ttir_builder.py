@@ -230,6 +230,7 @@ class TTIRBuilder:
                 data_type if data_type is not None else DataType.Float32,
                 golden_tensor.tensor.data_ptr(),
                 golden_tensor.tensor.numel() * golden_tensor.tensor.dtype.itemsize,
+                golden_tensor.tensor,
             )
         return golden_info
 
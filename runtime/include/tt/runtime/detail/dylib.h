@@ -10,10 +10,14 @@
 #include <cstring>
 #include <dlfcn.h>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sys/mman.h>
 #include <sys/syscall.h>
 #include <unistd.h>
+#include <vector>
 // Linux memfd_create syscall number, if not available in <sys/mman.h>
 #ifndef MFD_CLOEXEC
 #define MFD_CLOEXEC 0x0001U
@@ -51,8 +55,53 @@ public:
     return (it == handles.end()) ? nullptr : it->second;
   }
 
+  // Resolve a symbol in the dylib with the given id. Resolved symbols are
+  // cached, so repeated lookups of the same function don't go through dlsym.
+  // Returns nullptr if either the dylib or the symbol is missing.
+  void *getSymbol(const uint32_t key, const std::string &name);
+
 private:
   DylibHandleMap handles;
+
+  std::mutex symbolsMutex;
+  std::unordered_map<uint32_t, std::unordered_map<std::string, void *>>
+      symbols;
+};
+
+// Dylibs loaded for the programs of a binary. Shared between all copies of
+// the binary, so that each set of dylibs is loaded once rather than on every
+// execution. Programs of a binary usually reference the same dylib tables
+// through vectors of their own, so managers are keyed by the tables rather
+// than by the program.
+class DylibCache {
+public:
+  DylibCache() = default;
+
+  DylibCache(const DylibCache &) = delete;
+  DylibCache &operator=(const DylibCache &) = delete;
+
+  // Get the manager of the given dylibs, loading them on first use
+  std::shared_ptr<DylibManager>
+  getOrLoad(const ::flatbuffers::Vector<
+            ::flatbuffers::Offset<tt::target::DynamicLib>> *dylibs) {
+    std::vector<const tt::target::DynamicLib *> key;
+    if (dylibs) {
+      key.assign(dylibs->begin(), dylibs->end());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = managers.try_emplace(std::move(key));
+    if (inserted) {
+      it->second = std::make_shared<DylibManager>(dylibs);
+    }
+    return it->second;
+  }
+
+private:
+  std::mutex mutex;
+  std::map<std::vector<const tt::target::DynamicLib *>,
+           std::shared_ptr<DylibManager>>
+      managers;
 };
 } // namespace tt::runtime::common
 
@@ -13,6 +13,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -22,9 +23,7 @@
 namespace tt::runtime::ttnn {
 using OptionalMeshDeviceRef =
     std::optional<std::reference_wrapper<::ttnn::MeshDevice>>;
-using TensorMap = std::unordered_map<uint32_t, ::tt::runtime::Tensor>;
 using TensorPtrMap = std::unordered_map<uint32_t, ::tt::runtime::Tensor *>;
-using TensorPtrMapIterator = typename TensorPtrMap::iterator;
 
 // Wrapper for ttnn::Tensor that contains
 // additional metadata specific to our ttnn runtime
@@ -86,11 +85,14 @@ struct LayoutDesc {
 
 class ProgramTensorPool {
 public:
+  // Tensors are addressed by global id. The compiler assigns the global ids
+  // of a program densely in [tensorIdBegin, tensorIdBegin + numTensors), so
+  // they are kept in slots indexed by the id offset. Slots grow on demand for
+  // binaries that don't record the id range.
   ProgramTensorPool(const std::vector<uint32_t> &programInputIds,
                     const std::vector<uint32_t> &programOutputIds,
-                    TensorPtrMap &&liveTensors)
-      : programInputIds(programInputIds), programOutputIds(programOutputIds),
-        liveTensors(std::move(liveTensors)) {}
+                    TensorPtrMap &&liveTensors, uint32_t tensorIdBegin = 0,
+                    uint32_t numTensors = 0);
   ProgramTensorPool(const ProgramTensorPool &) = delete;
   ProgramTensorPool &operator=(const ProgramTensorPool &) = delete;
   ProgramTensorPool(ProgramTensorPool &&) = default;
@@ -111,17 +113,18 @@ public:
   ::ttnn::Tensor &
   getTTNNTensorAndValidate(const ::tt::target::ttnn::TensorRef *tensorRef);
 
-  std::pair<TensorPtrMapIterator, bool>
+  ::tt::runtime::Tensor &
   insertTTNNTensorAndValidate(const ::tt::target::ttnn::TensorRef *tensorRef,
                               const ::ttnn::Tensor &ttnnTensor,
                               bool retain = false);
 
   std::vector<::tt::runtime::Tensor> gatherOutputTensors();
 
-  TensorPtrMapIterator erase(const ::tt::target::ttnn::TensorRef *tensorRef);
+  void erase(const ::tt::target::ttnn::TensorRef *tensorRef);
 
   bool contains(const ::tt::target::ttnn::TensorRef *tensorRef) const {
-    return liveTensors.contains(tensorRef->global_id());
+    const TensorSlot *slot = findSlot(tensorRef->global_id());
+    return slot && slot->isLive();
   }
 
   const std::vector<std::uint32_t> &getProgramInputIds() const {
@@ -133,10 +136,33 @@ public:
   }
 
 private:
+  // A live tensor is either owned by the pool (produced by an op of the
+  // program) or borrowed from the caller (program inputs).
+  struct TensorSlot {
+    ::tt::runtime::Tensor *borrowed = nullptr;
+    std::optional<::tt::runtime::Tensor> owned;
+
+    bool isLive() const { return borrowed || owned; }
+    ::tt::runtime::Tensor &get() { return owned ? *owned : *borrowed; }
+    const ::tt::runtime::Tensor &get() const {
+      return owned ? *owned : *borrowed;
+    }
+  };
+
   std::vector<std::uint32_t> programInputIds;
   std::vector<std::uint32_t> programOutputIds;
-  TensorMap intermedTensors;
-  TensorPtrMap liveTensors;
+  std::uint32_t tensorIdBegin;
+  // Deque rather than vector, so that growing the pool doesn't invalidate
+  // references to tensors handed out earlier.
+  std::deque<TensorSlot> slots;
+
+  const TensorSlot *findSlot(std::uint32_t globalId) const {
+    if (globalId < tensorIdBegin || globalId - tensorIdBegin >= slots.size()) {
+      return nullptr;
+    }
+    return &slots[globalId - tensorIdBegin];
+  }
+  TensorSlot &getOrCreateSlot(std::uint32_t globalId);
 
   const ::tt::runtime::Tensor &getRuntimeTensor(std::uint32_t globalId) const;
   ::tt::runtime::Tensor &getRuntimeTensor(std::uint32_t globalId);
@@ -146,12 +172,14 @@ class ProgramContext {
 public:
   ProgramContext(const std::vector<uint32_t> &programInputIds,
                  const std::vector<uint32_t> &programOutputIds,
-                 TensorPtrMap &&liveTensors,
-                 common::DylibManager &&programDylibManager,
+                 TensorPtrMap &&liveTensors, uint32_t tensorIdBegin,
+                 uint32_t numTensors,
+                 std::shared_ptr<common::DylibManager> programDylibManager,
                  std::shared_ptr<::ttnn::MeshDevice> meshDevice,
                  const Binary &executableHandle, size_t programIndex = 0)
       : tensorPool(ProgramTensorPool(programInputIds, programOutputIds,
-                                     std::move(liveTensors))),
+                                     std::move(liveTensors), tensorIdBegin,
+                                     numTensors)),
         dylibManager(std::move(programDylibManager)), meshDevice(meshDevice),
         executableHandle(executableHandle), programIndex(programIndex) {
     LOG_ASSERT(meshDevice, "Submesh cannot be null");
@@ -179,7 +207,11 @@ public:
   // Dylib Manager Operation
   //
   void *tryGetDylibHandle(const uint32_t dylibId) {
-    return dylibManager.getHandle(dylibId);
+    return dylibManager->getHandle(dylibId);
+  }
+
+  void *tryGetDylibSymbol(const uint32_t dylibId, const std::string &name) {
+    return dylibManager->getSymbol(dylibId, name);
   }
 
   //
@@ -206,7 +238,7 @@ public:
 private:
   ProgramTensorPool tensorPool;
 
-  common::DylibManager dylibManager;
+  std::shared_ptr<common::DylibManager> dylibManager;
 
   std::shared_ptr<::ttnn::MeshDevice> meshDevice;
 
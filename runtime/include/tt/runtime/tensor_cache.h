@@ -7,9 +7,12 @@
 
 #include "tt/runtime/types.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tt::runtime {
@@ -33,6 +36,34 @@ struct CacheValue {
   std::vector<uint64_t> inputVersions;
   // The cached output tensors
   std::vector<Tensor> tensors;
+  // Total size of the cached output tensors in bytes
+  size_t sizeBytes = 0;
+  // Access tick of the last store or hit, used for LRU eviction
+  mutable uint64_t lastUse = 0;
+};
+
+/**
+ * Tensor cache statistics.
+ */
+struct TensorCacheStats {
+  // Lookups that returned cached tensors
+  size_t hits = 0;
+  // Lookups that found no entry or an entry with stale input versions
+  size_t misses = 0;
+  // Entries evicted to stay within the byte budget
+  size_t evictions = 0;
+  // Misses served from the persistent directory instead of recomputing
+  size_t persistentLoads = 0;
+  // Results written to the persistent directory
+  size_t persistentStores = 0;
+  // Number of cached const-eval results
+  size_t numEntries = 0;
+  // Bytes currently held by the cache
+  size_t bytes = 0;
+  // Highest number of bytes held by the cache at once
+  size_t peakBytes = 0;
+  // Byte budget, 0 if unlimited
+  size_t budgetBytes = 0;
 };
 
 /**
@@ -40,6 +71,15 @@ struct CacheValue {
  * The cache stores tensors indexed by function name. When querying the cache,
  * both the function name and current input tensor versions are checked to
  * determine if the cached value is still valid.
+ *
+ * The cache can be given a byte budget. When storing a result would exceed
+ * it, the least recently used results are evicted first. Results of pinned
+ * programs are never evicted, so the cache may exceed its budget if only
+ * pinned results are left.
+ *
+ * With a persistent directory set, computed results are also written to disk,
+ * keyed by content hashes of the binary and the inputs, so that later
+ * processes can load them instead of running the const-eval function again.
  */
 class TensorCache {
 public:
@@ -60,26 +100,29 @@ public:
          const std::vector<uint64_t> &inputVersions) const {
     auto it = cache.find(parentFuncName);
     if (it == cache.end()) {
-      ++stats["misses"];
+      ++stats.misses;
       return nullptr;
     }
 
     auto internalIt = it->second.find(constEvalFuncName);
     if (internalIt == it->second.end()) {
-      ++stats["misses"];
+      ++stats.misses;
       return nullptr;
     }
 
     const CacheValue &value = internalIt->second;
     if (value.inputVersions != inputVersions) {
-      ++stats["misses"];
+      ++stats.misses;
       return nullptr;
     }
-    ++stats["hits"];
+    ++stats.hits;
+    value.lastUse = ++tick;
     return &value.tensors;
   }
 
-  // Store tensors with explicit input versions
+  // Store tensors with explicit input versions, sizeBytes being their total
+  // size. Least recently used entries of unpinned programs are evicted to make
+  // room for the new entry if the cache has a budget.
   // Note: if ttrt used C++20 we could replace this code with proper
   // concept/constraint.
   template <typename VersionVec,
@@ -87,24 +130,97 @@ public:
                 std::decay_t<VersionVec>, std::vector<uint64_t>>>>
   void store(const std::string &parentFuncName,
              const std::string &constEvalFuncName, VersionVec &&inputVersions,
-             const std::vector<tt::runtime::Tensor> &tensors) {
+             const std::vector<tt::runtime::Tensor> &tensors,
+             size_t sizeBytes = 0) {
+    // The stale entry, if any, is replaced rather than kept alongside.
+    erase(parentFuncName, constEvalFuncName);
+    if (budgetBytes > 0) {
+      evict(budgetBytes > sizeBytes ? budgetBytes - sizeBytes : 0);
+    }
+
     cache[parentFuncName][constEvalFuncName] =
-        CacheValue{std::forward<VersionVec>(inputVersions), tensors};
+        CacheValue{std::forward<VersionVec>(inputVersions), tensors, sizeBytes,
+                   ++tick};
+    bytes += sizeBytes;
+    peakBytes = std::max(peakBytes, bytes);
   }
 
-  // Clear the entire cache
-  void clear() { cache.clear(); }
+  // Clear the entire cache, pins included
+  void clear() {
+    cache.clear();
+    pinned.clear();
+    bytes = 0;
+  }
 
   // Get the size of the cache (number of entries)
   size_t size() const { return cache.size(); }
 
+  // Get the number of bytes held by the cache
+  size_t getSizeBytes() const { return bytes; }
+
+  // Set the byte budget of the cache, 0 meaning unlimited. Entries over the
+  // new budget are evicted right away.
+  void setBudget(size_t budget) {
+    budgetBytes = budget;
+    if (budgetBytes > 0) {
+      evict(budgetBytes);
+    }
+  }
+
+  size_t getBudget() const { return budgetBytes; }
+
+  // Set the directory const-eval results are persisted to, empty to disable.
+  void setPersistentDir(const std::string &dir) { persistentDir = dir; }
+
+  const std::string &getPersistentDir() const { return persistentDir; }
+
+  // Record a miss that was served from, or a result written to, the
+  // persistent directory.
+  void recordPersistentLoad() { ++stats.persistentLoads; }
+  void recordPersistentStore() { ++stats.persistentStores; }
+
   // Get cache statistics
-  std::unordered_map<std::string, size_t> getStats() const { return stats; }
+  TensorCacheStats getStats() const {
+    TensorCacheStats result = stats;
+    for (const auto &[outerKey, entries] : cache) {
+      result.numEntries += entries.size();
+    }
+    result.bytes = bytes;
+    result.peakBytes = peakBytes;
+    result.budgetBytes = budgetBytes;
+    return result;
+  }
+
+  // Pin all const-eval funcs associated with a given outer key, so that they
+  // are never evicted. The key does not need to be cached yet.
+  void pin(const std::string &outerKey) { pinned.insert(outerKey); }
+
+  void pin(const int deviceId, const size_t programIdx) {
+    pin(generateCacheOuterKey(deviceId, programIdx));
+  }
 
-  // Remove all const-eval funcs associated with a given outer key.
+  void unpin(const std::string &outerKey) { pinned.erase(outerKey); }
+
+  void unpin(const int deviceId, const size_t programIdx) {
+    unpin(generateCacheOuterKey(deviceId, programIdx));
+  }
+
+  bool isPinned(const std::string &outerKey) const {
+    return pinned.count(outerKey) > 0;
+  }
+
+  // Remove all const-eval funcs associated with a given outer key, and unpin
+  // the key.
   void remove(const std::string &outerKey) {
+    pinned.erase(outerKey);
     auto it = cache.find(outerKey);
-    assert(it == cache.end() && "Outer key not found in remove() call!");
+    assert(it != cache.end() && "Outer key not found in remove() call!");
+    if (it == cache.end()) {
+      return;
+    }
+    for (const auto &[constEvalFuncName, value] : it->second) {
+      bytes -= value.sizeBytes;
+    }
     cache.erase(it);
   }
 
@@ -115,12 +231,69 @@ public:
   }
 
 private:
+  // Erase a single const-eval func entry, if present.
+  void erase(const std::string &outerKey, const std::string &innerKey) {
+    auto it = cache.find(outerKey);
+    if (it == cache.end()) {
+      return;
+    }
+    auto internalIt = it->second.find(innerKey);
+    if (internalIt == it->second.end()) {
+      return;
+    }
+    bytes -= internalIt->second.sizeBytes;
+    it->second.erase(internalIt);
+    if (it->second.empty()) {
+      cache.erase(it);
+    }
+  }
+
+  // Evict least recently used entries of unpinned programs until the cache
+  // holds at most targetBytes.
+  void evict(size_t targetBytes) {
+    while (bytes > targetBytes) {
+      const std::string *victimOuterKey = nullptr;
+      const std::string *victimInnerKey = nullptr;
+      uint64_t victimLastUse = 0;
+      for (const auto &[outerKey, entries] : cache) {
+        if (isPinned(outerKey)) {
+          continue;
+        }
+        for (const auto &[innerKey, value] : entries) {
+          if (!victimOuterKey || value.lastUse < victimLastUse) {
+            victimOuterKey = &outerKey;
+            victimInnerKey = &innerKey;
+            victimLastUse = value.lastUse;
+          }
+        }
+      }
+      if (!victimOuterKey) {
+        // Only pinned entries are left.
+        return;
+      }
+      // Copy the keys, erasing the entry invalidates them.
+      erase(std::string(*victimOuterKey), std::string(*victimInnerKey));
+      ++stats.evictions;
+    }
+  }
+
   // Outer key should be combination of device id and program index, created via
   // generateCacheOuterKey. Inner key will be const-eval func name.
   std::unordered_map<std::string, std::unordered_map<std::string, CacheValue>>
       cache;
+  // Outer keys whose entries are never evicted.
+  std::unordered_set<std::string> pinned;
+  // Directory results are persisted to, empty if disabled.
+  std::string persistentDir;
+  // Byte budget, 0 if unlimited.
+  size_t budgetBytes = 0;
+  // Bytes currently held, and the highest value seen.
+  size_t bytes = 0;
+  size_t peakBytes = 0;
+  // Monotonic counter stamping entries on store and hit.
+  mutable uint64_t tick = 0;
   // TODO(#2986): collect stats only if appropriate macros are set.
-  mutable std::unordered_map<std::string, size_t> stats;
+  mutable TensorCacheStats stats;
 };
 
 } // namespace tt::runtime
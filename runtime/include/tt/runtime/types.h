@@ -141,7 +141,13 @@ struct MeshDeviceOptions {
 struct Flatbuffer : public detail::ObjectImpl {
   using detail::ObjectImpl::ObjectImpl;
 
-  static Flatbuffer loadFromPath(const char *path);
+  // Load a flatbuffer from a file. With memoryMap the file is mapped rather
+  // than read, so loading is cheap and processes serving the same file share
+  // its pages.
+  static Flatbuffer loadFromPath(const char *path, bool memoryMap = false);
+
+  // Run the flatbuffer verifier over the whole buffer
+  bool verify() const;
 
   void store(const char *path) const;
   std::string_view getFileIdentifier() const;
@@ -163,6 +169,14 @@ struct SystemDesc : public Flatbuffer {
 };
 
 class TensorCache;
+namespace common {
+class DylibCache;
+} // namespace common
+namespace detail {
+class GoldenIndex;
+class ContentHash;
+} // namespace detail
+
 struct Binary : public Flatbuffer {
   Binary(Flatbuffer fb);
   Binary(std::shared_ptr<void> handle);
@@ -176,18 +190,37 @@ struct Binary : public Flatbuffer {
 
   using Flatbuffer::Flatbuffer;
 
-  static Binary loadFromPath(const char *path);
+  static Binary loadFromPath(const char *path, bool memoryMap = false);
+
+  // Verify only the parts of the binary needed to run the given program
+  bool verifyProgram(std::uint32_t programIndex) const;
 
   std::vector<TensorDesc> getProgramInputs(std::uint32_t programIndex) const;
   std::vector<TensorDesc> getProgramOutputs(std::uint32_t programIndex) const;
   const ::tt::target::GoldenTensor *getDebugInfoGolden(std::string &loc) const;
 
+  // Hash of the whole flatbuffer, computed on the first call. Identifies the
+  // binary in data persisted across processes, e.g. const-eval results.
+  std::uint64_t getContentHash() const;
+
   // Get the tensor cache associated with this binary
   std::shared_ptr<TensorCache> getCache() { return cache; }
 
+  // Get the dylibs loaded for programs of this binary
+  std::shared_ptr<common::DylibCache> getDylibCache() { return dylibCache; }
+
 private:
   // The tensor cache associated with this binary
   std::shared_ptr<TensorCache> cache;
+
+  // CPU-fallback dylibs loaded by programs of this binary
+  std::shared_ptr<common::DylibCache> dylibCache;
+
+  // Location to golden tensor index, built on the first golden lookup
+  std::shared_ptr<detail::GoldenIndex> goldenIndex;
+
+  // Hash of the flatbuffer, computed on the first getContentHash() call
+  std::shared_ptr<detail::ContentHash> contentHash;
 };
 
 struct Device : public detail::RuntimeCheckedObjectImpl {
@@ -5,6 +5,8 @@
 #ifndef TT_RUNTIME_UTILS_H
 #define TT_RUNTIME_UTILS_H
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
@@ -55,6 +57,90 @@ inline std::vector<uint32_t> calculateStride(const std::vector<T> &shape) {
   return stride;
 }
 
+namespace detail {
+constexpr std::uint64_t xxhPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t xxhPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t xxhPrime3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t xxhPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t xxhPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotl64(std::uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+template <typename T>
+inline T readUnaligned(const unsigned char *p) {
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+inline std::uint64_t xxhRound(std::uint64_t acc, std::uint64_t input) {
+  acc += input * xxhPrime2;
+  return rotl64(acc, 31) * xxhPrime1;
+}
+
+inline std::uint64_t xxhMergeRound(std::uint64_t acc, std::uint64_t value) {
+  acc ^= xxhRound(0, value);
+  return acc * xxhPrime1 + xxhPrime4;
+}
+} // namespace detail
+
+// 64-bit xxHash (XXH64) of a byte range. Consumes 32 bytes per iteration, so
+// it keeps up with hashing whole binaries and weights. Stable across
+// processes and builds, so it can be used to key data persisted to disk. Pass
+// a previous result as the seed to chain several ranges.
+inline std::uint64_t hashBytes(const void *data, size_t size,
+                               std::uint64_t seed = 0) {
+  using namespace detail;
+  const auto *p = static_cast<const unsigned char *>(data);
+  const unsigned char *end = p + size;
+  std::uint64_t hash;
+
+  if (size >= 32) {
+    std::uint64_t v1 = seed + xxhPrime1 + xxhPrime2;
+    std::uint64_t v2 = seed + xxhPrime2;
+    std::uint64_t v3 = seed;
+    std::uint64_t v4 = seed - xxhPrime1;
+    for (; end - p >= 32; p += 32) {
+      v1 = xxhRound(v1, readUnaligned<std::uint64_t>(p));
+      v2 = xxhRound(v2, readUnaligned<std::uint64_t>(p + 8));
+      v3 = xxhRound(v3, readUnaligned<std::uint64_t>(p + 16));
+      v4 = xxhRound(v4, readUnaligned<std::uint64_t>(p + 24));
+    }
+    hash = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    hash = xxhMergeRound(hash, v1);
+    hash = xxhMergeRound(hash, v2);
+    hash = xxhMergeRound(hash, v3);
+    hash = xxhMergeRound(hash, v4);
+  } else {
+    hash = seed + xxhPrime5;
+  }
+
+  hash += static_cast<std::uint64_t>(size);
+  for (; end - p >= 8; p += 8) {
+    hash ^= xxhRound(0, readUnaligned<std::uint64_t>(p));
+    hash = rotl64(hash, 27) * xxhPrime1 + xxhPrime4;
+  }
+  if (end - p >= 4) {
+    hash ^= static_cast<std::uint64_t>(readUnaligned<std::uint32_t>(p)) *
+            xxhPrime1;
+    hash = rotl64(hash, 23) * xxhPrime2 + xxhPrime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    hash ^= static_cast<std::uint64_t>(*p) * xxhPrime5;
+    hash = rotl64(hash, 11) * xxhPrime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= xxhPrime2;
+  hash ^= hash >> 29;
+  hash *= xxhPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
 template <class... Ts>
 struct overloaded : Ts... {
   using Ts::operator()...;
@@ -2,10 +2,17 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <fcntl.h>
 #include <fstream>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
 
 #include "flatbuffers/idl.h"
 
+#include "tt/runtime/detail/dylib.h"
 #include "tt/runtime/detail/logger.h"
 #include "tt/runtime/tensor_cache.h"
 #include "tt/runtime/types.h"
@@ -19,17 +26,84 @@
 
 namespace tt::runtime {
 
+namespace detail {
+// Maps op locations to golden tensors across all programs of a binary. Keys
+// point into the flatbuffer, which outlives the index since the index is
+// replaced whenever the binary handle changes.
+class GoldenIndex {
+public:
+  template <typename ProgramsT>
+  const ::tt::target::GoldenTensor *lookup(const ProgramsT *programs,
+                                           std::string_view loc) {
+    std::call_once(built, [&]() { build(programs); });
+    auto it = goldens.find(loc);
+    return it == goldens.end() ? nullptr : it->second;
+  }
+
+private:
+  template <typename ProgramsT>
+  void build(const ProgramsT *programs) {
+    for (const auto *program : *programs) {
+      const ::tt::target::DebugInfo *debugInfo = program->debug_info();
+      if (!debugInfo || !debugInfo->golden_info() ||
+          !debugInfo->golden_info()->golden_map()) {
+        continue;
+      }
+      const auto *goldenMap = debugInfo->golden_info()->golden_map();
+      goldens.reserve(goldens.size() + goldenMap->size());
+      // Earlier programs take precedence on duplicate locations
+      for (const ::tt::target::GoldenKV *goldenKV : *goldenMap) {
+        const flatbuffers::String *key = goldenKV->key();
+        goldens.try_emplace(std::string_view(key->c_str(), key->size()),
+                            goldenKV->value());
+      }
+    }
+  }
+
+  std::once_flag built;
+  std::unordered_map<std::string_view, const ::tt::target::GoldenTensor *>
+      goldens;
+};
+
+// Lazily computed hash of a flatbuffer, replaced along with the handle.
+class ContentHash {
+public:
+  std::uint64_t get(const void *data) {
+    std::call_once(computed, [&]() {
+      hash = utils::hashBytes(data, ::flatbuffers::GetSizePrefixedBufferLength(
+                                        static_cast<const uint8_t *>(data)));
+    });
+    return hash;
+  }
+
+private:
+  std::once_flag computed;
+  std::uint64_t hash = 0;
+};
+} // namespace detail
+
 Binary::Binary(Flatbuffer fb)
-    : Flatbuffer(fb), cache(std::make_shared<TensorCache>()) {}
+    : Flatbuffer(fb), cache(std::make_shared<TensorCache>()),
+      dylibCache(std::make_shared<common::DylibCache>()),
+      goldenIndex(std::make_shared<detail::GoldenIndex>()),
+      contentHash(std::make_shared<detail::ContentHash>()) {}
 
 Binary::Binary(std::shared_ptr<void> handle)
-    : Flatbuffer(handle), cache(std::make_shared<TensorCache>()) {}
+    : Flatbuffer(handle), cache(std::make_shared<TensorCache>()),
+      dylibCache(std::make_shared<common::DylibCache>()),
+      goldenIndex(std::make_shared<detail::GoldenIndex>()),
+      contentHash(std::make_shared<detail::ContentHash>()) {}
 
 Binary &Binary::operator=(Flatbuffer fb) {
   this->handle = fb.handle;
   if (!cache) {
     cache = std::make_shared<TensorCache>();
   }
+  // Loaded dylibs, indexed goldens and the hash belong to the previous
+  // flatbuffer
+  dylibCache = std::make_shared<common::DylibCache>();
+  goldenIndex = std::make_shared<detail::GoldenIndex>();
+  contentHash = std::make_shared<detail::ContentHash>();
   return *this;
 }
 
@@ -38,6 +112,11 @@ Binary &Binary::operator=(std::shared_ptr<void> handle) {
   if (!cache) {
     cache = std::make_shared<TensorCache>();
   }
+  // Loaded dylibs, indexed goldens and the hash belong to the previous
+  // flatbuffer
+  dylibCache = std::make_shared<common::DylibCache>();
+  goldenIndex = std::make_shared<detail::GoldenIndex>();
+  contentHash = std::make_shared<detail::ContentHash>();
   return *this;
 }
 
@@ -85,6 +164,32 @@ std::string asJson(Flatbuffer binary) {
       ::tt::target::ttnn::TTNNBinaryBinarySchema::size());
 }
 
+bool verify(Flatbuffer binary) {
+  const auto *data = static_cast<const uint8_t *>(binary.handle.get());
+  ::flatbuffers::Verifier verifier(
+      data, ::flatbuffers::GetSizePrefixedBufferLength(data));
+  return ::tt::target::ttnn::VerifySizePrefixedTTNNBinaryBuffer(verifier);
+}
+
+bool verifyProgram(Flatbuffer binary, std::uint32_t programIndex) {
+  // Only verify the root table, the program list and the requested program,
+  // skipping all other programs.
+  const auto *data = static_cast<const uint8_t *>(binary.handle.get());
+  ::flatbuffers::Verifier verifier(
+      data, ::flatbuffers::GetSizePrefixedBufferLength(data));
+  const auto *root = getBinary(binary);
+  if (!verifier.VerifyTableStart(reinterpret_cast<const uint8_t *>(root))) {
+    return false;
+  }
+  const auto *programs = root->programs();
+  if (!programs || !verifier.VerifyVector(programs) ||
+      programIndex >= programs->size()) {
+    return false;
+  }
+  const auto *program = programs->Get(programIndex);
+  return program && verifier.VerifyTable(program);
+}
+
 std::vector<TensorDesc> getProgramInputs(Flatbuffer binary,
                                          std::uint32_t programIndex) {
   std::vector<TensorDesc> inputs;
@@ -119,20 +224,15 @@ std::vector<TensorDesc> getProgramOutputs(Flatbuffer binary,
   return outputs;
 }
 
-const ::tt::target::GoldenTensor *getDebugInfoGolden(Flatbuffer binary,
-                                                     std::string &loc) {
-  const auto *programs = getBinary(binary)->programs();
-  for (const auto *program : *programs) {
-    for (const ::tt::target::GoldenKV *goldenKV :
-         *program->debug_info()->golden_info()->golden_map()) {
-      if (loc == goldenKV->key()->c_str()) {
-        return goldenKV->value();
-      }
-    }
+const ::tt::target::GoldenTensor *
+getDebugInfoGolden(Flatbuffer binary, detail::GoldenIndex &goldenIndex,
+                   std::string &loc) {
+  const ::tt::target::GoldenTensor *golden =
+      goldenIndex.lookup(getBinary(binary)->programs(), loc);
+  if (!golden) {
+    LOG_WARNING("Golden information not found");
   }
-
-  LOG_WARNING("Golden information not found");
-  return nullptr;
+  return golden;
 }
 
 } // namespace ttnn
@@ -165,6 +265,13 @@ std::string asJson(Flatbuffer binary) {
       ::tt::target::metal::TTMetalBinaryBinarySchema::size());
 }
 
+bool verify(Flatbuffer binary) {
+  const auto *data = static_cast<const uint8_t *>(binary.handle.get());
+  ::flatbuffers::Verifier verifier(
+      data, ::flatbuffers::GetSizePrefixedBufferLength(data));
+  return ::tt::target::metal::VerifySizePrefixedTTMetalBinaryBuffer(verifier);
+}
+
 static std::vector<TensorDesc>
 getTensorDescs(const ::flatbuffers::Vector<
                ::flatbuffers::Offset<tt::target::metal::TensorRef>> *tensors) {
@@ -200,20 +307,15 @@ std::vector<TensorDesc> getProgramOutputs(Flatbuffer binary,
   return getTensorDescs(program->outputs());
 }
 
-const ::tt::target::GoldenTensor *getDebugInfoGolden(Flatbuffer binary,
-                                                     std::string &loc) {
-  const auto *programs = getBinary(binary)->programs();
-  for (const auto *program : *programs) {
-    for (const ::tt::target::GoldenKV *goldenKV :
-         *program->debug_info()->golden_info()->golden_map()) {
-      if (loc == goldenKV->key()->c_str()) {
-        return goldenKV->value();
-      }
-    }
+const ::tt::target::GoldenTensor *
+getDebugInfoGolden(Flatbuffer binary, detail::GoldenIndex &goldenIndex,
+                   std::string &loc) {
+  const ::tt::target::GoldenTensor *golden =
+      goldenIndex.lookup(getBinary(binary)->programs(), loc);
+  if (!golden) {
+    LOG_WARNING("Golden information not found");
   }
-
-  LOG_WARNING("Golden information not found");
-  return nullptr;
+  return golden;
 }
 
 } // namespace metal
@@ -245,9 +347,40 @@ std::string asJson(Flatbuffer binary) {
       ::tt::target::SystemDescRootBinarySchema::size());
 }
 
+bool verify(Flatbuffer binary) {
+  const auto *data = static_cast<const uint8_t *>(binary.handle.get());
+  ::flatbuffers::Verifier verifier(
+      data, ::flatbuffers::GetSizePrefixedBufferLength(data));
+  return ::tt::target::VerifySizePrefixedSystemDescRootBuffer(verifier);
+}
+
 } // namespace system_desc
 
-Flatbuffer Flatbuffer::loadFromPath(const char *path) {
+static std::shared_ptr<void> mapFile(const char *path) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  LOG_ASSERT(fd != -1, "Failed to open file: ", path);
+  struct stat st;
+  int statResult = fstat(fd, &st);
+  LOG_ASSERT(statResult == 0, "Failed to stat file: ", path);
+  size_t size = st.st_size;
+
+  // Private writable mapping: pages are shared with the page cache and other
+  // processes mapping the same file until something writes to them.
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  LOG_ASSERT(addr != MAP_FAILED, "Failed to map file: ", path);
+
+  // Start paging in the file in the background, loading returns right away.
+  madvise(addr, size, MADV_WILLNEED);
+
+  return std::shared_ptr<void>(addr, [size](void *ptr) { munmap(ptr, size); });
+}
+
+Flatbuffer Flatbuffer::loadFromPath(const char *path, bool memoryMap) {
+  if (memoryMap) {
+    return Flatbuffer(mapFile(path));
+  }
+
   // load a flatbuffer from path
   std::ifstream fbb(path, std::ios::binary | std::ios::ate);
   LOG_ASSERT(fbb.is_open(), "Failed to open file: ", path);
@@ -258,6 +391,25 @@ Flatbuffer Flatbuffer::loadFromPath(const char *path) {
   return Flatbuffer(buffer);
 }
 
+bool Flatbuffer::verify() const {
+  if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
+          handle.get())) {
+    return ttnn::verify(*this);
+  }
+
+  if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
+          handle.get())) {
+    return metal::verify(*this);
+  }
+
+  if (::tt::target::SizePrefixedSystemDescRootBufferHasIdentifier(
+          handle.get())) {
+    return system_desc::verify(*this);
+  }
+
+  LOG_FATAL("Unsupported binary format");
+}
+
 void Flatbuffer::store(const char *path) const {
   // store a flatbuffer to path
   std::ofstream fbb(path, std::ios::binary);
@@ -346,8 +498,17 @@ SystemDesc SystemDesc::loadFromPath(const char *path) {
   return SystemDesc(Flatbuffer::loadFromPath(path).handle);
 }
 
-Binary Binary::loadFromPath(const char *path) {
-  return Binary(Flatbuffer::loadFromPath(path).handle);
+Binary Binary::loadFromPath(const char *path, bool memoryMap) {
+  return Binary(Flatbuffer::loadFromPath(path, memoryMap).handle);
+}
+
+bool Binary::verifyProgram(std::uint32_t programIndex) const {
+  if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
+          handle.get())) {
+    return ttnn::verifyProgram(*this, programIndex);
+  }
+
+  return verify();
 }
 
 std::vector<TensorDesc>
@@ -384,15 +545,19 @@ const ::tt::target::GoldenTensor *
 Binary::getDebugInfoGolden(std::string &loc) const {
   if (::tt::target::ttnn::SizePrefixedTTNNBinaryBufferHasIdentifier(
           handle.get())) {
-    return ttnn::getDebugInfoGolden(*this, loc);
+    return ttnn::getDebugInfoGolden(*this, *goldenIndex, loc);
   }
 
   if (::tt::target::metal::SizePrefixedTTMetalBinaryBufferHasIdentifier(
           handle.get())) {
-    return metal::getDebugInfoGolden(*this, loc);
+    return metal::getDebugInfoGolden(*this, *goldenIndex, loc);
   }
 
   LOG_FATAL("Unsupported binary format for obtaining golden information");
 }
 
+std::uint64_t Binary::getContentHash() const {
+  return contentHash->get(handle.get());
+}
+
 } // namespace tt::runtime
@@ -57,9 +57,10 @@ DylibManager::~DylibManager() {
 }
 
 DylibManager::DylibManager(DylibManager &&other) noexcept
-    : handles(std::move(other.handles)) {
+    : handles(std::move(other.handles)), symbols(std::move(other.symbols)) {
   // Clear the moved-from object's handles to prevent double-free
   other.handles.clear();
+  other.symbols.clear();
 }
 
 DylibManager &DylibManager::operator=(DylibManager &&other) noexcept {
@@ -71,11 +72,27 @@ DylibManager &DylibManager::operator=(DylibManager &&other) noexcept {
 
     // Then take ownership of the other's handles
     handles = std::move(other.handles);
+    symbols = std::move(other.symbols);
 
     // Clear the moved-from object's handles
     other.handles.clear();
+    other.symbols.clear();
   }
   return *this;
 }
 
+void *DylibManager::getSymbol(const uint32_t key, const std::string &name) {
+  void *handle = getHandle(key);
+  if (!handle) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(symbolsMutex);
+  auto [it, inserted] = symbols[key].try_emplace(name, nullptr);
+  if (inserted) {
+    it->second = dlsym(handle, name.c_str());
+  }
+  return it->second;
+}
+
 } // namespace tt::runtime::common
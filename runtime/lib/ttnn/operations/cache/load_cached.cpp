@@ -10,13 +10,142 @@
 #include "tt/runtime/detail/ttnn/utils.h"
 #include "tt/runtime/tensor_cache.h"
 #include "tt/runtime/types.h"
+#include "tt/runtime/utils.h"
+#include "ttnn/tensor/serialization.hpp"
+
+#include <cstdio>
+#include <filesystem>
 #include <string_view>
+#include <unistd.h>
 #include <vector>
 
 namespace tt::runtime::ttnn::operations::cache {
 
 using LogType = ::tt::runtime::logger::LogType;
 
+namespace {
+template <typename T>
+uint64_t hashValue(const T &value, uint64_t seed) {
+  return ::tt::runtime::utils::hashBytes(&value, sizeof(value), seed);
+}
+
+// Hash of the tensor's data type, layout, shape and contents. Device tensors
+// are read back to host to be hashed. The whole host buffer is hashed, which
+// for tiled, padded or block float tensors is not the logical volume times the
+// element size.
+uint64_t hashTensorContent(const ::ttnn::Tensor &tensor, uint64_t seed) {
+  ::ttnn::Tensor hostTensor = utils::isOnDevice(tensor.storage_type())
+                                  ? ::ttnn::from_device(tensor)
+                                  : tensor;
+  uint64_t hash = hashValue(hostTensor.get_dtype(), seed);
+  hash = hashValue(hostTensor.get_layout(), hash);
+  for (size_t i = 0; i < hostTensor.logical_shape().size(); ++i) {
+    hash = hashValue(hostTensor.logical_shape()[i], hash);
+  }
+  return ::tt::runtime::utils::hashBytes(
+      utils::getRawHostDataPtr(hostTensor),
+      hostTensor.get_tensor_spec().compute_packed_buffer_size_bytes(), hash);
+}
+
+// Runs the const-eval function on the op inputs.
+std::vector<Tensor> execute(const ::tt::target::ttnn::LoadCachedOp *op,
+                            ProgramContext &context) {
+  // Collect the ::ttnn::Tensor objects for execution
+  std::vector<::tt::runtime::Tensor> inputs;
+  inputs.reserve(op->inputs()->size());
+  for (const auto *input : *op->inputs()) {
+    inputs.emplace_back(
+        context.getTensorPool().getRuntimeTensorAndValidate(input));
+  }
+
+  // Execute the function
+  const size_t programIndex = op->program_idx();
+  ProgramExecutor exec(context.getExecutableHandle(), inputs,
+                       context.getMeshDevicePtr(), programIndex);
+  exec.execute();
+  return exec.gatherOutputTensors();
+}
+
+// Paths of the persisted outputs of a const-eval function. The key covers the
+// binary, the program the function is hoisted from, the function itself and
+// the contents of its inputs, so stale files are never matched.
+std::vector<std::filesystem::path>
+getPersistentPaths(const ::tt::target::ttnn::LoadCachedOp *op,
+                   ProgramContext &context, const std::string &persistentDir) {
+  uint64_t hash = context.getExecutableHandle().getContentHash();
+  hash = hashValue(context.getProgramIndex(), hash);
+  const std::string &constEvalFuncname = op->callee_name()->str();
+  hash = ::tt::runtime::utils::hashBytes(constEvalFuncname.data(),
+                                         constEvalFuncname.size(), hash);
+  for (const auto *input : *op->inputs()) {
+    hash = hashTensorContent(
+        context.getTensorPool().getTTNNTensorAndValidate(input), hash);
+  }
+
+  char key[17];
+  std::snprintf(key, sizeof(key), "%016llx",
+                static_cast<unsigned long long>(hash));
+  std::vector<std::filesystem::path> paths;
+  paths.reserve(op->outputs()->size());
+  for (size_t i = 0; i < op->outputs()->size(); ++i) {
+    paths.push_back(std::filesystem::path(persistentDir) /
+                    (std::string(key) + "_" + std::to_string(i) + ".bin"));
+  }
+  return paths;
+}
+
+// Loads persisted outputs onto the device, or returns an empty vector if any
+// of them is missing.
+std::vector<Tensor>
+loadPersistentOutputs(const std::vector<std::filesystem::path> &paths,
+                      ProgramContext &context) {
+  for (const std::filesystem::path &path : paths) {
+    if (!std::filesystem::exists(path)) {
+      return {};
+    }
+  }
+
+  std::vector<Tensor> outputs;
+  outputs.reserve(paths.size());
+  for (const std::filesystem::path &path : paths) {
+    ::ttnn::Tensor output =
+        ::tt::tt_metal::load_tensor(path.string(), &context.getMeshDevice());
+    outputs.push_back(utils::createRuntimeTensorFromTTNN(output));
+  }
+  return outputs;
+}
+
+// Writes outputs next to their final paths and renames them into place, so
+// that concurrent processes never load partially written files. Returns
+// whether all outputs were persisted.
+bool storePersistentOutputs(const std::vector<std::filesystem::path> &paths,
+                            const std::vector<Tensor> &outputs) {
+  std::error_code ec;
+  std::filesystem::create_directories(paths.front().parent_path(), ec);
+  if (ec) {
+    LOG_WARNING("Failed to create const-eval cache directory: ", ec.message());
+    return false;
+  }
+
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    const ::ttnn::Tensor &output =
+        outputs[i]
+            .as<::tt::runtime::ttnn::TTNNTensorWrapper>(DeviceRuntime::TTNN)
+            .getTensor();
+    std::filesystem::path tmpPath = paths[i];
+    tmpPath += ".tmp" + std::to_string(::getpid());
+    ::tt::tt_metal::dump_tensor(tmpPath.string(), output);
+    std::filesystem::rename(tmpPath, paths[i], ec);
+    if (ec) {
+      LOG_WARNING("Failed to persist const-eval result: ", ec.message());
+      std::filesystem::remove(tmpPath, ec);
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 void run(const ::tt::target::ttnn::LoadCachedOp *op, ProgramContext &context) {
   std::shared_ptr<TensorCache> cache = context.getCache();
   LOG_ASSERT(cache, "Cache must be enabled to support const-eval ops.");
@@ -45,8 +174,10 @@ void run(const ::tt::target::ttnn::LoadCachedOp *op, ProgramContext &context) {
 
     assert(cachedOutputs->size() == op->outputs()->size());
     for (size_t i = 0; i < cachedOutputs->size(); ++i) {
-      auto &output =
-          (*cachedOutputs)[i].as<::ttnn::Tensor>(DeviceRuntime::TTNN);
+      const ::ttnn::Tensor &output =
+          (*cachedOutputs)[i]
+              .as<::tt::runtime::ttnn::TTNNTensorWrapper>(DeviceRuntime::TTNN)
+              .getTensor();
       context.getTensorPool().insertTTNNTensorAndValidate(op->outputs()->Get(i),
                                                           output);
     }
@@ -56,27 +187,45 @@ void run(const ::tt::target::ttnn::LoadCachedOp *op, ProgramContext &context) {
 
   LOG_DEBUG("Cache miss or invalid cache for function: ", constEvalFuncname);
 
-  // Collect the ::ttnn::Tensor objects for execution
-  std::vector<::tt::runtime::Tensor> inputs;
-  inputs.reserve(op->inputs()->size());
-  for (const auto *input : *op->inputs()) {
-    inputs.emplace_back(
-        context.getTensorPool().getRuntimeTensorAndValidate(input));
+  std::vector<std::filesystem::path> persistentPaths;
+  std::vector<Tensor> outputs;
+  if (!cache->getPersistentDir().empty()) {
+    persistentPaths =
+        getPersistentPaths(op, context, cache->getPersistentDir());
+    outputs = loadPersistentOutputs(persistentPaths, context);
+    if (!outputs.empty()) {
+      LOG_DEBUG("Loaded persisted results for function: ", constEvalFuncname);
+      cache->recordPersistentLoad();
+    }
   }
 
-  // Execute the function
-  const size_t programIndex = op->program_idx();
-  ProgramExecutor exec(context.getExecutableHandle(), inputs,
-                       context.getMeshDevicePtr(), programIndex);
-  exec.execute();
-  LOG_DEBUG("executed sub-func: ", constEvalFuncname);
-  std::vector<Tensor> outputs = exec.gatherOutputTensors();
+  if (outputs.empty()) {
+    outputs = execute(op, context);
+    LOG_DEBUG("executed sub-func: ", constEvalFuncname);
+    if (!persistentPaths.empty() &&
+        storePersistentOutputs(persistentPaths, outputs)) {
+      cache->recordPersistentStore();
+    }
+  }
+
+  size_t sizeBytes = 0;
+  for (const Tensor &runtimeOutput : outputs) {
+    const ::ttnn::Tensor &output =
+        runtimeOutput
+            .as<::tt::runtime::ttnn::TTNNTensorWrapper>(DeviceRuntime::TTNN)
+            .getTensor();
+    // Physical size, including tile and shard padding.
+    sizeBytes += output.get_tensor_spec().compute_packed_buffer_size_bytes();
+  }
 
-  cache->store(cacheKey, constEvalFuncname, std::move(inputVersions), outputs);
+  cache->store(cacheKey, constEvalFuncname, std::move(inputVersions), outputs,
+               sizeBytes);
 
   for (size_t i = 0; i < outputs.size(); ++i) {
-    Tensor &runtimeOutput = outputs[i];
-    auto &output = runtimeOutput.as<::ttnn::Tensor>(DeviceRuntime::TTNN);
+    const ::ttnn::Tensor &output =
+        outputs[i]
+            .as<::tt::runtime::ttnn::TTNNTensorWrapper>(DeviceRuntime::TTNN)
+            .getTensor();
     context.getTensorPool().insertTTNNTensorAndValidate(op->outputs()->Get(i),
                                                         output);
   }
@@ -68,7 +68,7 @@ void run(const ::tt::target::ttnn::CpuOp *op, ProgramContext &context) {
   }
 
   WrappedFunc fn = reinterpret_cast<WrappedFunc>(
-      dlsym(dylibHandle, op->func_name()->str().c_str()));
+      context.tryGetDylibSymbol(op->dylib_id(), op->func_name()->str()));
   if (!fn) {
     LOG_FATAL("could not find requested op: \"" + op->func_name()->str() +
               "\" in dylib with id: " + std::to_string(op->dylib_id()));
@@ -107,8 +107,9 @@ ProgramExecutor::ProgramExecutor(
 
   context = std::make_unique<ProgramContext>(
       programInputIds, programOutputIds, std::move(liveTensors),
-      common::DylibManager(program->dylibs()), std::move(meshDevice),
-      executableHandle, programIndex);
+      program->tensor_id_begin(), program->num_tensors(),
+      this->executableHandle.getDylibCache()->getOrLoad(program->dylibs()),
+      std::move(meshDevice), executableHandle, programIndex);
 }
 
 void ProgramExecutor::runCallback(
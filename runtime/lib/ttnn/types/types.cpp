@@ -54,11 +54,35 @@ bool LayoutDesc::operator==(const LayoutDesc &other) const {
 // ProgramTensorPool APIs
 //
 
+ProgramTensorPool::ProgramTensorPool(
+    const std::vector<uint32_t> &programInputIds,
+    const std::vector<uint32_t> &programOutputIds, TensorPtrMap &&liveTensors,
+    uint32_t tensorIdBegin, uint32_t numTensors)
+    : programInputIds(programInputIds), programOutputIds(programOutputIds),
+      tensorIdBegin(numTensors ? tensorIdBegin : 0), slots(numTensors) {
+  for (auto &[globalId, tensor] : liveTensors) {
+    getOrCreateSlot(globalId).borrowed = tensor;
+  }
+}
+
+ProgramTensorPool::TensorSlot &
+ProgramTensorPool::getOrCreateSlot(std::uint32_t globalId) {
+  if (globalId < tensorIdBegin) {
+    slots.insert(slots.begin(), tensorIdBegin - globalId, TensorSlot());
+    tensorIdBegin = globalId;
+  }
+  std::uint32_t index = globalId - tensorIdBegin;
+  if (index >= slots.size()) {
+    slots.resize(index + 1);
+  }
+  return slots[index];
+}
+
 const ::tt::runtime::Tensor &
 ProgramTensorPool::getRuntimeTensor(std::uint32_t globalId) const {
-  auto it = liveTensors.find(globalId);
-  LOG_ASSERT(it != liveTensors.end(), "Tensor not found in tensor pool");
-  return *(it->second);
+  const TensorSlot *slot = findSlot(globalId);
+  LOG_ASSERT(slot && slot->isLive(), "Tensor not found in tensor pool");
+  return slot->get();
 }
 
 ::tt::runtime::Tensor &
@@ -119,8 +143,7 @@ const ::ttnn::Tensor &ProgramTensorPool::getTTNNTensorAndValidate(
           tensorRef));
 }
 
-std::pair<TensorPtrMapIterator, bool>
-ProgramTensorPool::insertTTNNTensorAndValidate(
+::tt::runtime::Tensor &ProgramTensorPool::insertTTNNTensorAndValidate(
     const ::tt::target::ttnn::TensorRef *tensorRef,
     const ::ttnn::Tensor &ttnnTensor, bool retain) {
   LOG_ASSERT(tensorRef != nullptr, "tensorRef should not be null");
@@ -128,12 +151,10 @@ ProgramTensorPool::insertTTNNTensorAndValidate(
   DEBUG_ASSERT(ttnnTensor.is_allocated());
   debug::checkTensorRefMatchesTTNNTensor(tensorRef, ttnnTensor);
 
-  ::tt::runtime::Tensor runtimeTensor =
-      utils::createRuntimeTensorFromTTNN(ttnnTensor, retain);
-  auto [iter, inserted] =
-      intermedTensors.insert_or_assign(globalId, runtimeTensor);
-
-  return liveTensors.insert_or_assign(globalId, &(iter->second));
+  TensorSlot &slot = getOrCreateSlot(globalId);
+  slot.borrowed = nullptr;
+  slot.owned = utils::createRuntimeTensorFromTTNN(ttnnTensor, retain);
+  return *slot.owned;
 }
 
 std::vector<::tt::runtime::Tensor> ProgramTensorPool::gatherOutputTensors() {
@@ -151,15 +172,12 @@ std::vector<::tt::runtime::Tensor> ProgramTensorPool::gatherOutputTensors() {
   return outputs;
 }
 
-TensorPtrMapIterator
-ProgramTensorPool::erase(const ::tt::target::ttnn::TensorRef *tensorRef) {
+void ProgramTensorPool::erase(const ::tt::target::ttnn::TensorRef *tensorRef) {
   LOG_ASSERT(tensorRef != nullptr, "tensorRef should not be null");
-  std::uint32_t globalId = tensorRef->global_id();
-  intermedTensors.erase(globalId);
-  auto it = liveTensors.find(globalId);
-  LOG_ASSERT(it != liveTensors.end(),
-             "Tensor to erase not found in tensor pool");
-  return liveTensors.erase(it);
+  LOG_ASSERT(contains(tensorRef), "Tensor to erase not found in tensor pool");
+  TensorSlot &slot = getOrCreateSlot(tensorRef->global_id());
+  slot.borrowed = nullptr;
+  slot.owned.reset();
 }
 
 } // namespace tt::runtime::ttnn
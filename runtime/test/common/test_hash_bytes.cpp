@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/utils.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+
+using ::tt::runtime::utils::hashBytes;
+
+namespace {
+std::uint64_t hashString(std::string_view str, std::uint64_t seed = 0) {
+  return hashBytes(str.data(), str.size(), seed);
+}
+} // namespace
+
+// Reference values of the published XXH64 implementation.
+TEST(HashBytes, EmptyInput) {
+  EXPECT_EQ(hashString(""), 0xEF46DB3751D8E999ULL);
+}
+
+TEST(HashBytes, ShortInput) {
+  EXPECT_EQ(hashString("a"), 0xD24EC4F1A98C6E5BULL);
+  EXPECT_EQ(hashString("abc"), 0x44BC2CF5AD770999ULL);
+}
+
+TEST(HashBytes, LongInput) {
+  // Both are consumed in 32 byte stripes followed by tails of 7 and 11 bytes.
+  EXPECT_EQ(hashString("Nobody inspects the spammish repetition"),
+            0xFBCEA83C8A378BF1ULL);
+  EXPECT_EQ(hashString("The quick brown fox jumps over the lazy dog"),
+            0x0B242D361FDA71BCULL);
+}
+
+TEST(HashBytes, NonZeroSeed) {
+  EXPECT_EQ(hashString("", 1), 0xD5AFBA1336A3BE4BULL);
+  EXPECT_EQ(hashString("abc", 1), 0xBEA9CA8199328908ULL);
+  EXPECT_EQ(hashString("The quick brown fox jumps over the lazy dog",
+                       0x9E3779B185EBCA87ULL),
+            0xB8A8089ADD7E03D9ULL);
+}
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "tt/runtime/tensor_cache.h"
+#include <gtest/gtest.h>
+
+using ::tt::runtime::DeviceRuntime;
+using ::tt::runtime::Tensor;
+using ::tt::runtime::TensorCache;
+
+namespace {
+std::vector<Tensor> makeTensors() {
+  return {Tensor(nullptr, nullptr, DeviceRuntime::TTNN)};
+}
+
+bool isCached(const TensorCache &cache, const std::string &outerKey) {
+  return cache.getAll(outerKey, "const_eval_0", {1}) != nullptr;
+}
+
+void store(TensorCache &cache, const std::string &outerKey, size_t sizeBytes) {
+  cache.store(outerKey, "const_eval_0", std::vector<uint64_t>{1},
+              makeTensors(), sizeBytes);
+}
+} // namespace
+
+TEST(TensorCache, EvictsLeastRecentlyUsed) {
+  TensorCache cache;
+  cache.setBudget(100);
+  store(cache, "0:0", 40);
+  store(cache, "0:1", 40);
+
+  // Touch the older entry so that the newer one becomes the LRU entry.
+  EXPECT_TRUE(isCached(cache, "0:0"));
+  store(cache, "0:2", 40);
+
+  EXPECT_TRUE(isCached(cache, "0:0"));
+  EXPECT_FALSE(isCached(cache, "0:1"));
+  EXPECT_TRUE(isCached(cache, "0:2"));
+  EXPECT_EQ(cache.getStats().evictions, 1u);
+  EXPECT_EQ(cache.getSizeBytes(), 80u);
+}
+
+TEST(TensorCache, PinnedEntriesSurviveEviction) {
+  TensorCache cache;
+  cache.setBudget(100);
+  cache.pin(0, 0);
+  store(cache, "0:0", 60);
+  store(cache, "0:1", 60);
+
+  // Only the pinned entry is left to evict, so the budget is exceeded.
+  EXPECT_TRUE(isCached(cache, "0:0"));
+  EXPECT_TRUE(isCached(cache, "0:1"));
+  EXPECT_EQ(cache.getSizeBytes(), 120u);
+
+  // The unpinned entry goes first even though the pinned one is older.
+  store(cache, "0:2", 30);
+  EXPECT_TRUE(isCached(cache, "0:0"));
+  EXPECT_FALSE(isCached(cache, "0:1"));
+  EXPECT_TRUE(isCached(cache, "0:2"));
+  EXPECT_EQ(cache.getSizeBytes(), 90u);
+
+  // Lowering the budget evicts everything but the pinned entry.
+  cache.setBudget(10);
+  EXPECT_TRUE(isCached(cache, "0:0"));
+  EXPECT_FALSE(isCached(cache, "0:2"));
+  EXPECT_EQ(cache.getSizeBytes(), 60u);
+}
+
+TEST(TensorCache, BudgetAccounting) {
+  TensorCache cache;
+  store(cache, "0:0", 40);
+  store(cache, "0:1", 30);
+  EXPECT_EQ(cache.getSizeBytes(), 70u);
+
+  // Replacing an entry releases the bytes of the old one.
+  store(cache, "0:0", 10);
+  EXPECT_EQ(cache.getSizeBytes(), 40u);
+
+  cache.remove(0, 1);
+  EXPECT_EQ(cache.getSizeBytes(), 10u);
+
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.numEntries, 1u);
+  EXPECT_EQ(stats.bytes, 10u);
+  EXPECT_EQ(stats.peakBytes, 70u);
+  EXPECT_EQ(stats.budgetBytes, 0u);
+  EXPECT_EQ(stats.evictions, 0u);
+
+  cache.clear();
+  EXPECT_EQ(cache.getSizeBytes(), 0u);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(TensorCache, RemoveAndClearUnpin) {
+  TensorCache cache;
+  cache.pin(0, 0);
+  store(cache, "0:0", 10);
+  cache.remove(0, 0);
+  EXPECT_FALSE(cache.isPinned("0:0"));
+
+  cache.pin(0, 1);
+  cache.clear();
+  EXPECT_FALSE(cache.isPinned("0:1"));
+}
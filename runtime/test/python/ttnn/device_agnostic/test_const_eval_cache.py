@@ -0,0 +1,74 @@
+# SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import os
+import ttrt
+import ttrt.runtime
+from ttrt.common.util import *
+from ..utils import (
+    TT_MLIR_HOME,
+    Helper,
+    DeviceContext,
+    assert_tensors_match,
+    get_torch_inputs,
+    get_runtime_tensor_from_torch,
+    get_torch_output_container,
+    get_to_layout_inputs,
+)
+
+FLATBUFFER_BASE_PATH = (
+    f"{TT_MLIR_HOME}/build/test/ttmlir/Silicon/TTNN/n150/const_eval/Output"
+)
+
+
+def run_program(binary, device, inputs_torch):
+    inputs_runtime = [get_runtime_tensor_from_torch(input) for input in inputs_torch]
+    inputs_runtime = get_to_layout_inputs(device, inputs_runtime, binary, 0)
+    output = ttrt.runtime.submit(device, binary.fbb, 0, inputs_runtime)[0]
+    output_host = ttrt.runtime.to_host(output, untilize=True)[0]
+    result = get_torch_output_container(binary.get_program(0))
+    ttrt.runtime.memcpy(result.data_ptr(), output_host)
+    ttrt.runtime.deallocate_tensor(output, force=True)
+    ttrt.runtime.deallocate_tensor(output_host, force=True)
+    for input in inputs_runtime:
+        ttrt.runtime.deallocate_tensor(input, force=True)
+    return result
+
+
+def test_const_eval_persistent_cache_round_trip(helper: Helper, request, tmp_path):
+    binary_path = os.path.join(
+        FLATBUFFER_BASE_PATH, "const_eval_persistent_cache.mlir.tmp.ttnn"
+    )
+    assert os.path.exists(binary_path), f"Binary file not found: {binary_path}"
+    helper.initialize(request.node.name, binary_path)
+    helper.check_constraints()
+
+    cache_dir = str(tmp_path / "const_eval_cache")
+    inputs_torch = get_torch_inputs(helper.binary.get_program(0))
+    with DeviceContext(mesh_shape=[1, 1]) as device:
+        # The first run computes the const-eval function and persists its
+        # result.
+        first_cache = helper.binary.fbb.get_tensor_cache()
+        first_cache.set_persistent_dir(cache_dir)
+        first_result = run_program(helper.binary, device, inputs_torch)
+        first_stats = first_cache.get_stats()
+        assert first_stats.persistent_stores == 1
+        assert first_stats.persistent_loads == 0
+        persisted_files = os.listdir(cache_dir)
+        assert len(persisted_files) == 1
+        assert persisted_files[0].endswith("_0.bin")
+
+        # A freshly loaded binary starts with an empty in-memory cache, so its
+        # miss is served from the directory instead of recomputing.
+        second_binary = Binary(helper.logger, helper.file_manager, binary_path)
+        second_cache = second_binary.fbb.get_tensor_cache()
+        second_cache.set_persistent_dir(cache_dir)
+        second_result = run_program(second_binary, device, inputs_torch)
+        second_stats = second_cache.get_stats()
+        assert second_stats.persistent_loads == 1
+        assert second_stats.persistent_stores == 0
+        assert os.listdir(cache_dir) == persisted_files
+
+    assert_tensors_match(first_result, second_result)
+    helper.teardown()
@@ -24,6 +24,7 @@ PYBIND11_MODULE(_C, m) {
       .def_property_readonly("file_identifier",
                              &tt::runtime::Flatbuffer::getFileIdentifier)
       .def("as_json", &tt::runtime::Flatbuffer::asJson)
+      .def("verify", &tt::runtime::Flatbuffer::verify)
       .def("store", &tt::runtime::Flatbuffer::store);
   py::class_<tt::runtime::Binary>(m, "Binary")
       .def_property_readonly("version", &tt::runtime::Binary::getVersion)
@@ -32,6 +33,8 @@ PYBIND11_MODULE(_C, m) {
       .def_property_readonly("file_identifier",
                              &tt::runtime::Binary::getFileIdentifier)
       .def("as_json", &tt::runtime::Binary::asJson)
+      .def("verify", &tt::runtime::Binary::verify)
+      .def("verify_program", &tt::runtime::Binary::verifyProgram)
       .def("store", &tt::runtime::Binary::store)
       .def("get_debug_info_golden", &::tt::runtime::Binary::getDebugInfoGolden,
            py::return_value_policy::reference)
@@ -47,8 +50,10 @@ PYBIND11_MODULE(_C, m) {
                              &tt::runtime::SystemDesc::getFileIdentifier)
       .def("as_json", &tt::runtime::SystemDesc::asJson)
       .def("store", &tt::runtime::SystemDesc::store);
-  m.def("load_from_path", &tt::runtime::Flatbuffer::loadFromPath);
-  m.def("load_binary_from_path", &tt::runtime::Binary::loadFromPath);
+  m.def("load_from_path", &tt::runtime::Flatbuffer::loadFromPath,
+        py::arg("path"), py::arg("memory_map") = false);
+  m.def("load_binary_from_path", &tt::runtime::Binary::loadFromPath,
+        py::arg("path"), py::arg("memory_map") = false);
   m.def("load_binary_from_capsule", [](py::capsule capsule) {
     std::shared_ptr<void> *binary =
         static_cast<std::shared_ptr<void> *>(capsule.get_pointer());
@@ -136,12 +141,46 @@ PYBIND11_MODULE(_C, m) {
         );
       });
 
+  py::class_<tt::runtime::TensorCacheStats>(m, "TensorCacheStats")
+      .def_readonly("hits", &tt::runtime::TensorCacheStats::hits)
+      .def_readonly("misses", &tt::runtime::TensorCacheStats::misses)
+      .def_readonly("evictions", &tt::runtime::TensorCacheStats::evictions)
+      .def_readonly("persistent_loads",
+                    &tt::runtime::TensorCacheStats::persistentLoads)
+      .def_readonly("persistent_stores",
+                    &tt::runtime::TensorCacheStats::persistentStores)
+      .def_readonly("num_entries", &tt::runtime::TensorCacheStats::numEntries)
+      .def_readonly("bytes", &tt::runtime::TensorCacheStats::bytes)
+      .def_readonly("peak_bytes", &tt::runtime::TensorCacheStats::peakBytes)
+      .def_readonly("budget_bytes",
+                    &tt::runtime::TensorCacheStats::budgetBytes);
+
   py::class_<tt::runtime::TensorCache,
              std::shared_ptr<tt::runtime::TensorCache>>(m, "TensorCache")
       .def(py::init<>())
       .def("clear", &tt::runtime::TensorCache::clear)
       .def("size", &tt::runtime::TensorCache::size)
+      .def("size_bytes", &tt::runtime::TensorCache::getSizeBytes)
       .def("get_stats", &tt::runtime::TensorCache::getStats)
+      .def("set_budget", &tt::runtime::TensorCache::setBudget,
+           "Set the byte budget of the cache, 0 meaning unlimited")
+      .def("get_budget", &tt::runtime::TensorCache::getBudget)
+      .def("set_persistent_dir", &tt::runtime::TensorCache::setPersistentDir,
+           "Set the directory const-eval results are persisted to across "
+           "processes, empty to disable")
+      .def("get_persistent_dir", &tt::runtime::TensorCache::getPersistentDir)
+      .def(
+          "pin_program",
+          [](tt::runtime::TensorCache &cache, const int meshId,
+             size_t programIndex) { cache.pin(meshId, programIndex); },
+          "Keep cache entries for a specific device id and program index from "
+          "being evicted")
+      .def(
+          "unpin_program",
+          [](tt::runtime::TensorCache &cache, const int meshId,
+             size_t programIndex) { cache.unpin(meshId, programIndex); },
+          "Allow cache entries for a specific device id and program index to "
+          "be evicted")
       .def(
           "remove_program",
           [](tt::runtime::TensorCache &cache, const int meshId,
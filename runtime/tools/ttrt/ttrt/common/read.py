@@ -445,17 +445,38 @@ class Read:
 
         return self._operate_on_binary(binaries, _get_mlir)
 
+    def _load_debug_artifacts(self, binary, debug_info):
+        # Debug payloads may live in a sidecar file next to the binary, they
+        # are only loaded when a section asks for them.
+        path = debug_info.get("artifacts_path")
+        if not path:
+            return {}
+        if not os.path.isabs(path) and not os.path.exists(path):
+            path = os.path.join(os.path.dirname(binary.file_path), path)
+        if not os.path.exists(path):
+            self.logging.warning(f"debug artifacts file not found: {path}")
+            return {}
+        with open(path, "r") as f:
+            return json.load(f)
+
     def cpp(self, *binaries):
         def _get_cpp(binary):
             bin_dict = ttrt.binary.as_dict(binary.fbb)
             results = []
+            artifacts = None
             for program in bin_dict["programs"]:
                 if "debug_info" not in program:
                     self.logging.info(
                         f"no debug_info found for program:{program['name']}"
                     )
                     continue
-                results.append({program["name"]: program["debug_info"]["cpp"]})
+                debug_info = program["debug_info"]
+                cpp = debug_info.get("cpp")
+                if not cpp and "artifacts_path" in debug_info:
+                    if artifacts is None:
+                        artifacts = self._load_debug_artifacts(binary, debug_info)
+                    cpp = artifacts.get("cpp", "")
+                results.append({program["name"]: cpp})
             return results
 
         return self._operate_on_binary(binaries, _get_cpp)
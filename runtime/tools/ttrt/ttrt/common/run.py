@@ -242,6 +242,13 @@ class Run:
             choices=None,
             help="Verify tensor cache statistics. Format: 'hits:N,misses:M'",
         )
+        Run.register_arg(
+            name="--const-eval-cache-dir",
+            type=str,
+            default="",
+            choices=None,
+            help="directory to persist const-eval results to, so that later runs load them instead of recomputing",
+        )
         Run.register_arg(
             name="--enable-program-cache",
             type=bool,
@@ -531,6 +538,11 @@ class Run:
                     if self["--save-artifacts"]:
                         self.artifacts.create_binary_artifacts_folder(bin)
 
+                    if self["--const-eval-cache-dir"]:
+                        bin.fbb.get_tensor_cache().set_persistent_dir(
+                            self["--const-eval-cache-dir"]
+                        )
+
                     if self["--emitc"]:
                         # .so are compiled such that they have the same name as flatbuffers, so we rename here
                         emitc_dylib_path = bin.file_path.replace(".ttnn", ".so")
@@ -715,10 +727,11 @@ class Run:
                             if self["--check-cache-stats"]:
                                 # Log cache stats after execution
                                 cache_stats = bin.fbb.get_tensor_cache().get_stats()
-                                hits = cache_stats.get("hits", 0)
-                                misses = cache_stats.get("misses", 0)
                                 self.logging.debug(
-                                    f"Tensor cache stats: hits={hits}, misses={misses}"
+                                    f"Tensor cache stats: hits={cache_stats.hits}, "
+                                    f"misses={cache_stats.misses}, "
+                                    f"evictions={cache_stats.evictions}, "
+                                    f"bytes={cache_stats.bytes}"
                                 )
 
                             ttrt.runtime.wait(runtime_outputs)
@@ -894,7 +907,7 @@ class Run:
                                             key,
                                             expected_value,
                                         ) in requested_stats.items():
-                                            actual_value = cache_stats.get(key, 0)
+                                            actual_value = getattr(cache_stats, key, 0)
                                             self.logging.debug(
                                                 f"Checking cache stat {key}: expected={expected_value}, actual={actual_value}"
                                             )
@@ -0,0 +1,10 @@
+// RUN: ttmlir-opt --linalg-to-llvm-pipeline="vector-width=8" %s | FileCheck %s
+module {
+  func.func @add(%arg0: tensor<32x32xf32>, %arg1: tensor<32x32xf32>, %arg2: tensor<32x32xf32>) -> tensor<32x32xf32> {
+    %1 = linalg.add ins(%arg0, %arg1 : tensor<32x32xf32>, tensor<32x32xf32>) outs(%arg2 : tensor<32x32xf32>) -> tensor<32x32xf32>
+    return %1 : tensor<32x32xf32>
+  }
+  // CHECK-LABEL: llvm.func @add
+  // CHECK: llvm.fadd %{{.*}}, %{{.*}} : vector<8xf32>
+  // CHECK-NOT: vector.
+}
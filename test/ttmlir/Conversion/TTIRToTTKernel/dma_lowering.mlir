@@ -40,10 +40,11 @@ func.func @test_local_to_remote_multicast_regular(%arg0: memref<2x2x!tt.tile<32x
   %c2 = arith.constant 2 : index
   %c3 = arith.constant 3 : index
   %c4 = arith.constant 4 : index
-  // CHECK: ttkernel.get_read_ptr
-  // CHECK: ttkernel.get_write_ptr
+  // CHECK-NOT: ttkernel.get_read_ptr
+  // CHECK: %[[PTR:[0-9]+]] = "ttkernel.get_write_ptr"
+  // CHECK-NOT: ttkernel.get_read_ptr
   // CHECK: ttkernel.get_noc_multicast_addr
-  // CHECK: ttkernel.noc_async_write_multicast
+  // CHECK: "ttkernel.noc_async_write_multicast"(%[[PTR]],
   %0 = ttir.dma %arg0[%c0, %c0], %arg0[%c0, %c0] core[%c1, %c2] mcast[%c3, %c4] : (memref<2x2x!tt.tile<32x32, f32>, #l1_>, memref<2x2x!tt.tile<32x32, f32>, #l1_>) -> !ttir.mem_tx
   ttir.dma_wait %0
   return
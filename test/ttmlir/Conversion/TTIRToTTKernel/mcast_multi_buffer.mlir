@@ -0,0 +1,46 @@
+// RUN: ttmlir-opt --tt-register-device --convert-ttir-to-ttkernel %s | FileCheck %s
+
+// Gather-multicast of a stream over several blocks, as generated for the lhs
+// of a multi core matmul. With more than one buffer backing the stream the cb
+// write pointer moves to the next buffer on every block, while this thread
+// never pops the cb, so the multicast must send from the write pointer the
+// gather just filled rather than from the read pointer.
+
+#l1_ = #tt.memory_space<l1>
+module {
+  // CHECK-LABEL: func.func private @datamovement_kernel0
+  // CHECK-NOT: ttkernel.get_read_ptr
+  func.func private @datamovement_kernel0(%arg0: memref<1x3x!tt.tile<32x32, f32>, #l1_>, %arg1: !ttir.semaphore, %arg2: !ttir.semaphore) attributes {ttir.thread = #ttir.thread<datamovement>} {
+    %c8 = arith.constant 8 : index
+    %c1 = arith.constant 1 : index
+    %c0 = arith.constant 0 : index
+    %c7 = arith.constant 7 : index
+    %core1 = ttir.core_index(1) : index
+    %core0 = ttir.core_index(0) : index
+    %0 = arith.cmpi eq, %core1, %c0 : index
+    // CHECK: scf.for
+    scf.for %arg3 = %c0 to %c8 step %c1 {
+      // CHECK: "ttkernel.cb_reserve_back"
+      scf.if %0 {
+        %1 = ttir.get_global_operand(0) : memref<8x8x1x3x!tt.tile<32x32, f32>, #tt.shard<12288x4096>, #l1_>
+        // CHECK: %[[GATHER_DST:[0-9]+]] = "ttkernel.get_write_ptr"(%[[CB:[a-z0-9]+]])
+        // CHECK: "ttkernel.noc_async_read"({{.*}}, %[[GATHER_DST]],
+        %tx = ttir.dma %1 [%c0, %arg3, %c0, %c0], %arg0 [%c0, %c0] : (memref<8x8x1x3x!tt.tile<32x32, f32>, #tt.shard<12288x4096>, #l1_>, memref<1x3x!tt.tile<32x32, f32>, #l1_>) -> !ttir.mem_tx
+        ttir.semaphore_wait %arg1, %c7 reset %c0
+        ttir.dma_wait %tx
+        // CHECK: %[[MCAST_SRC:[0-9]+]] = "ttkernel.get_write_ptr"(%[[CB]])
+        // CHECK: %[[MCAST_DST:[0-9]+]] = "ttkernel.get_noc_multicast_addr"
+        // CHECK: "ttkernel.noc_async_write_multicast"(%[[MCAST_SRC]], %[[MCAST_DST]],
+        %tx_0 = ttir.dma %arg0 [%c0, %c0], %arg0 [%c0, %c0] core[%core0, %c0] mcast[%c1, %c8] : (memref<1x3x!tt.tile<32x32, f32>, #l1_>, memref<1x3x!tt.tile<32x32, f32>, #l1_>) -> !ttir.mem_tx
+        ttir.dma_wait %tx_0
+        ttir.semaphore_set %arg2, %c1, core[%core0, %c0] mcast[%c1, %c8]
+      } else {
+        ttir.semaphore_inc %arg1, %c1, core[%core0, %c0]
+        ttir.semaphore_wait %arg2, %c1 reset %c0
+      }
+      // CHECK: "ttkernel.cb_push_back"
+      ttir.yield %arg0 : (memref<1x3x!tt.tile<32x32, f32>, #l1_>)
+    }
+    return
+  }
+}
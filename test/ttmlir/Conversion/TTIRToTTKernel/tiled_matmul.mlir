@@ -28,10 +28,9 @@ module {
         // CHECK: "ttkernel.noc_semaphore_wait"
         // CHECK: "ttkernel.noc_semaphore_set"
         ttir.semaphore_wait %arg3, %c7 reset %c0
-        // CHECK: %{{[0-9]+}} = "ttkernel.get_read_ptr"
-        // CHECK: %{{[0-9]+}} = "ttkernel.get_write_ptr"
+        // CHECK: %[[MCAST_SRC:[0-9]+]] = "ttkernel.get_write_ptr"
         // CHECK: %{{[0-9]+}} = "ttkernel.get_noc_multicast_addr"
-        // CHECK: "ttkernel.noc_async_write_multicast"
+        // CHECK: "ttkernel.noc_async_write_multicast"(%[[MCAST_SRC]],
         %tx_0 = ttir.dma %arg0 [%c0, %c0], %arg0 [%c0, %c0] core[%core0, %c0] mcast[%c1, %c8] : (memref<1x3x!tt.tile<32x32, f32>, #l1_>, memref<1x3x!tt.tile<32x32, f32>, #l1_>) -> !ttir.mem_tx
         // CHECK: "ttkernel.noc_async_write_barrier"
         ttir.dma_wait %tx_0
@@ -0,0 +1,27 @@
+// RUN: ttmlir-opt --tt-register-device --ttir-allocate="spill-to-dram=false" --verify-diagnostics %s
+
+#l1_ = #tt.memory_space<l1>
+#map = affine_map<(d0, d1) -> (d0, d1)>
+#parallel = #tt.iterator_type<parallel>
+
+// Without spilling, %a, the storage of its stream and %out do not fit in L1
+// together, which is an error.
+func.func @out_of_l1() -> memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_> {
+  %a = memref.alloc() : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  %storage = memref.alloc() : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  %stream = "ttir.stream_layout"(%a, %storage) : (memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>, memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>) -> memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>
+  // expected-error @+1 {{out of L1 memory: buffer of 655360 bytes does not fit}}
+  %out = memref.alloc() : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  "ttir.generic"(%stream, %out) <{grid = #tt.grid<1x1>, indexing_maps = [#map, #map], iterator_types = [#parallel, #parallel], threads = [#ttir.thread<compute>], operandSegmentSizes = array<i32: 1, 1>}> ({
+  ^bb0(%cb0: memref<16x10x!tt.tile<32x32, f32>, #l1_>, %cb1: memref<16x10x!tt.tile<32x32, f32>, #l1_>):
+    affine.for %i = 0 to 16 {
+      affine.for %j = 0 to 10 {
+        %0 = affine.load %cb0[%i, %j] : memref<16x10x!tt.tile<32x32, f32>, #l1_>
+        %1 = "ttir.tile_exp"(%0) : (!tt.tile<32x32, f32>) -> !tt.tile<32x32, f32>
+        affine.store %1, %cb1[%i, %j] : memref<16x10x!tt.tile<32x32, f32>, #l1_>
+      }
+    }
+    ttir.yield %cb1 : (memref<16x10x!tt.tile<32x32, f32>, #l1_>)
+  }) : (memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>, memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>) -> ()
+  return %out : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+}
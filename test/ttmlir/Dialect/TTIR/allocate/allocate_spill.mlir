@@ -0,0 +1,38 @@
+// RUN: ttmlir-opt --tt-register-device --ttir-allocate %s | FileCheck %s
+// RUN: ttmlir-opt --tt-register-device --ttir-allocate="report-memory-usage=true" %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=REPORT
+
+#l1_ = #tt.memory_space<l1>
+#map = affine_map<(d0, d1) -> (d0, d1)>
+#parallel = #tt.iterator_type<parallel>
+
+// %a, the storage of its stream and %out do not fit in L1 together. %a is
+// only read through the stream, so it is moved to DRAM, and the stream then
+// reads from there. The region argument bound to the stream still refers to
+// the L1 storage of the stream.
+//
+// REPORT: remark: 1 buffers spilled from L1 to DRAM
+func.func @spill_stream_input() -> memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_> {
+  // CHECK: %[[A:.*]] = memref.alloc() {{.*}}: memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #dram>
+  %a = memref.alloc() : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  // CHECK: %[[STORAGE:.*]] = memref.alloc() {{.*}}: memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  %storage = memref.alloc() : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  // CHECK: "ttir.stream_layout"(%[[A]], %[[STORAGE]]) {{.*}} -> memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.view<map(4)>, #dram>
+  %stream = "ttir.stream_layout"(%a, %storage) : (memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>, memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>) -> memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>
+  // CHECK: memref.alloc() {{.*}}: memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  %out = memref.alloc() : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+  // CHECK: "ttir.generic"
+  // CHECK-NEXT: ^bb0(%{{.*}}: memref<16x10x!tt.tile<32x32, f32>, #l1_>, %{{.*}}: memref<16x10x!tt.tile<32x32, f32>, #l1_>):
+  // CHECK: (memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.view<map(4)>, #dram>, memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>) -> ()
+  "ttir.generic"(%stream, %out) <{grid = #tt.grid<1x1>, indexing_maps = [#map, #map], iterator_types = [#parallel, #parallel], threads = [#ttir.thread<compute>], operandSegmentSizes = array<i32: 1, 1>}> ({
+  ^bb0(%cb0: memref<16x10x!tt.tile<32x32, f32>, #l1_>, %cb1: memref<16x10x!tt.tile<32x32, f32>, #l1_>):
+    affine.for %i = 0 to 16 {
+      affine.for %j = 0 to 10 {
+        %0 = affine.load %cb0[%i, %j] : memref<16x10x!tt.tile<32x32, f32>, #l1_>
+        %1 = "ttir.tile_exp"(%0) : (!tt.tile<32x32, f32>) -> !tt.tile<32x32, f32>
+        affine.store %1, %cb1[%i, %j] : memref<16x10x!tt.tile<32x32, f32>, #l1_>
+      }
+    }
+    ttir.yield %cb1 : (memref<16x10x!tt.tile<32x32, f32>, #l1_>)
+  }) : (memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>, memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>) -> ()
+  return %out : memref<1x1x16x10x!tt.tile<32x32, f32>, #tt.shard<40960x4096>, #l1_>
+}
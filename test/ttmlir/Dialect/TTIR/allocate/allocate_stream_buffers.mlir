@@ -0,0 +1,43 @@
+// RUN: ttmlir-opt --tt-register-device --ttir-allocate --canonicalize %s | FileCheck %s
+// RUN: ttmlir-opt --tt-register-device --ttir-allocate="num-stream-buffers=3" --canonicalize %s | FileCheck %s --check-prefix=TRIPLE
+
+#l1_ = #tt.memory_space<l1>
+#parallel = #tt.iterator_type<parallel>
+#reduction = #tt.iterator_type<reduction>
+#mapL = affine_map<(d0, d1, d2) -> (d0, d2)>
+#mapR = affine_map<(d0, d1, d2) -> (d2, d1)>
+#mapO = affine_map<(d0, d1, d2) -> (d0, d1)>
+
+// The reduction runs over two blocks, so the streams are double buffered by
+// default.
+func.func @multi_block(%arg0: memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>, %arg1: memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_> {
+  // CHECK-LABEL: func.func @multi_block
+  // CHECK: "ttir.stream_layout"(%arg0, %{{.*}}) : (memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>, memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096, 2>, #l1_>)
+  // CHECK: "ttir.stream_layout"(%arg1, %{{.*}}) : (memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>, memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096, 2>, #l1_>)
+  // TRIPLE-LABEL: func.func @multi_block
+  // TRIPLE: "ttir.stream_layout"(%arg0, %{{.*}}) : ({{.*}}, memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096, 3>, #l1_>)
+  // TRIPLE: "ttir.stream_layout"(%arg1, %{{.*}}) : ({{.*}}, memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096, 3>, #l1_>)
+  %alloc = memref.alloc() {alignment = 64 : i64} : memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>
+  %0 = "ttir.view_layout"(%arg0) : (memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>
+  %1 = "ttir.view_layout"(%arg1) : (memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>
+  "ttir.generic"(%0, %1, %alloc) <{grid = #tt.grid<1x1>, indexing_maps = [#mapL, #mapR, #mapO], iterator_types = [#parallel, #parallel, #reduction], threads = [#ttir.thread<compute>], operandSegmentSizes = array<i32: 2, 1>}> ({
+  ^bb0(%cb0: memref<2x2x!tt.tile<32x32, f32>, #l1_>, %cb1: memref<2x2x!tt.tile<32x32, f32>, #l1_>, %cb2: memref<2x2x!tt.tile<32x32, f32>, #l1_>):
+    "ttir.tile_matmul_block"(%cb0, %cb1, %cb2) : (memref<2x2x!tt.tile<32x32, f32>, #l1_>, memref<2x2x!tt.tile<32x32, f32>, #l1_>, memref<2x2x!tt.tile<32x32, f32>, #l1_>) -> ()
+  }) : (memref<1x2x2x2x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>, memref<2x1x2x2x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>, memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> ()
+  return %alloc : memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>
+}
+
+// A single block has nothing to overlap with, so its streams keep one buffer.
+func.func @single_block(%arg0: memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>, %arg1: memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_> {
+  // CHECK-LABEL: func.func @single_block
+  // CHECK: "ttir.stream_layout"(%arg0, %{{.*}}) : ({{.*}}, memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>)
+  // TRIPLE-LABEL: func.func @single_block
+  // TRIPLE: "ttir.stream_layout"(%arg0, %{{.*}}) : ({{.*}}, memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>)
+  %alloc = memref.alloc() {alignment = 64 : i64} : memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>
+  %0 = "ttir.view_layout"(%arg0) : (memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>
+  "ttir.generic"(%0, %arg1, %alloc) <{grid = #tt.grid<1x1>, indexing_maps = [#mapL, #mapR, #mapO], iterator_types = [#parallel, #parallel, #reduction], threads = [#ttir.thread<compute>], operandSegmentSizes = array<i32: 2, 1>}> ({
+  ^bb0(%cb0: memref<2x2x!tt.tile<32x32, f32>, #l1_>, %cb1: memref<2x2x!tt.tile<32x32, f32>, #l1_>, %cb2: memref<2x2x!tt.tile<32x32, f32>, #l1_>):
+    "ttir.tile_matmul_block"(%cb0, %cb1, %cb2) : (memref<2x2x!tt.tile<32x32, f32>, #l1_>, memref<2x2x!tt.tile<32x32, f32>, #l1_>, memref<2x2x!tt.tile<32x32, f32>, #l1_>) -> ()
+  }) : (memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.view<map(4)>, #l1_>, memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>, memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>) -> ()
+  return %alloc : memref<1x1x2x2x!tt.tile<32x32, f32>, #tt.shard<8192x4096>, #l1_>
+}
@@ -0,0 +1,99 @@
+// RUN: ttmlir-opt --ttir-erase-inverse-ops %s | FileCheck %s
+// RUN: ttmlir-opt --ttir-erase-inverse-ops="report-removed-tms=true" %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=REPORT
+
+module {
+  // The transposes on the inputs cancel with the one on the result once they
+  // are commuted through the concat, whose dimension follows them.
+  //
+  // REPORT: remark: Erased TMs: 3 ops, 24576 bytes removed, 0 ops, 0 bytes left
+  func.func @test_cancel_through_concat(%arg0: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}, %arg1: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}) -> tensor<1x64x64xf32> {
+    // CHECK-LABEL: func.func @test_cancel_through_concat
+    // CHECK-NOT: "ttir.transpose"
+    // CHECK: %[[CONCAT:[0-9]+]] = "ttir.concat"(%arg0, %arg1, %{{[0-9]+}}) <{dim = 1 : si32}>
+    // CHECK-NOT: "ttir.transpose"
+    // CHECK: return %[[CONCAT]]
+    %0 = tensor.empty() : tensor<1x64x32xf32>
+    %1 = "ttir.transpose"(%arg0, %0) <{dim0 = 1 : si32, dim1 = 2 : si32}> : (tensor<1x32x64xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    %2 = tensor.empty() : tensor<1x64x32xf32>
+    %3 = "ttir.transpose"(%arg1, %2) <{dim0 = 1 : si32, dim1 = 2 : si32}> : (tensor<1x32x64xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    %4 = tensor.empty() : tensor<1x64x64xf32>
+    %5 = "ttir.concat"(%1, %3, %4) <{dim = 2 : si32}> : (tensor<1x64x32xf32>, tensor<1x64x32xf32>, tensor<1x64x64xf32>) -> tensor<1x64x64xf32>
+    %6 = tensor.empty() : tensor<1x64x64xf32>
+    %7 = "ttir.transpose"(%5, %6) <{dim0 = 1 : si32, dim1 = 2 : si32}> : (tensor<1x64x64xf32>, tensor<1x64x64xf32>) -> tensor<1x64x64xf32>
+    return %7 : tensor<1x64x64xf32>
+  }
+
+  // The permutes cancel through a reduction that keeps its dimensions, which
+  // then reduces the matching dimension of the input.
+  //
+  // REPORT: remark: Erased TMs: 2 ops, 8448 bytes removed, 0 ops, 0 bytes left
+  func.func @test_cancel_through_reduction(%arg0: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}) -> tensor<1x1x64xf32> {
+    // CHECK-LABEL: func.func @test_cancel_through_reduction
+    // CHECK-NOT: "ttir.permute"
+    // CHECK: %[[SUM:[0-9]+]] = "ttir.sum"(%arg0, %{{[0-9]+}}) <{dim_arg = [1 : i32], keep_dim = true}>
+    // CHECK-NOT: "ttir.permute"
+    // CHECK: return %[[SUM]]
+    %0 = tensor.empty() : tensor<1x64x32xf32>
+    %1 = "ttir.permute"(%arg0, %0) <{permutation = array<i64: 0, 2, 1>}> : (tensor<1x32x64xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    %2 = tensor.empty() : tensor<1x64x1xf32>
+    %3 = "ttir.sum"(%1, %2) <{dim_arg = [2 : i32], keep_dim = true}> : (tensor<1x64x32xf32>, tensor<1x64x1xf32>) -> tensor<1x64x1xf32>
+    %4 = tensor.empty() : tensor<1x1x64xf32>
+    %5 = "ttir.permute"(%3, %4) <{permutation = array<i64: 0, 2, 1>}> : (tensor<1x64x1xf32>, tensor<1x1x64xf32>) -> tensor<1x1x64xf32>
+    return %5 : tensor<1x1x64xf32>
+  }
+
+  // Nothing cancels, but commuting the permutes below the add leaves one
+  // permute where there were two.
+  //
+  // REPORT: remark: Erased TMs: 1 ops, 8192 bytes removed, 1 ops, 8192 bytes left
+  func.func @test_commute_below_eltwise(%arg0: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}, %arg1: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}) -> tensor<1x64x32xf32> {
+    // CHECK-LABEL: func.func @test_commute_below_eltwise
+    // CHECK: %[[ADD:[0-9]+]] = "ttir.add"(%arg0, %arg1,
+    // CHECK: %[[EXP:[0-9]+]] = "ttir.exp"(%[[ADD]],
+    // CHECK: %[[PERMUTE:[0-9]+]] = "ttir.permute"(%[[EXP]],
+    // CHECK: return %[[PERMUTE]]
+    %0 = tensor.empty() : tensor<1x64x32xf32>
+    %1 = "ttir.permute"(%arg0, %0) <{permutation = array<i64: 0, 2, 1>}> : (tensor<1x32x64xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    %2 = tensor.empty() : tensor<1x64x32xf32>
+    %3 = "ttir.permute"(%arg1, %2) <{permutation = array<i64: 0, 2, 1>}> : (tensor<1x32x64xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    %4 = tensor.empty() : tensor<1x64x32xf32>
+    %5 = "ttir.add"(%1, %3, %4) : (tensor<1x64x32xf32>, tensor<1x64x32xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    %6 = tensor.empty() : tensor<1x64x32xf32>
+    %7 = "ttir.exp"(%5, %6) : (tensor<1x64x32xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    return %7 : tensor<1x64x32xf32>
+  }
+
+  // Commuting the permute above the add would place a permute on each runtime
+  // input, so it is left where it is.
+  //
+  // REPORT: remark: Erased TMs: 0 ops, 0 bytes removed, 1 ops, 8192 bytes left
+  func.func @test_dont_commute_onto_inputs(%arg0: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}, %arg1: tensor<1x32x64xf32> {tt.argument_type = #tt.argument_type<input>}) -> tensor<1x64x32xf32> {
+    // CHECK-LABEL: func.func @test_dont_commute_onto_inputs
+    // CHECK: %[[ADD:[0-9]+]] = "ttir.add"(%arg0, %arg1,
+    // CHECK: %[[PERMUTE:[0-9]+]] = "ttir.permute"(%[[ADD]],
+    // CHECK: return %[[PERMUTE]]
+    %0 = tensor.empty() : tensor<1x32x64xf32>
+    %1 = "ttir.add"(%arg0, %arg1, %0) : (tensor<1x32x64xf32>, tensor<1x32x64xf32>, tensor<1x32x64xf32>) -> tensor<1x32x64xf32>
+    %2 = tensor.empty() : tensor<1x64x32xf32>
+    %3 = "ttir.permute"(%1, %2) <{permutation = array<i64: 0, 2, 1>}> : (tensor<1x32x64xf32>, tensor<1x64x32xf32>) -> tensor<1x64x32xf32>
+    return %3 : tensor<1x64x32xf32>
+  }
+
+  // A transpose commuted below the exp is folded into the matmul.
+  //
+  // REPORT: remark: Erased TMs: 1 ops, 8192 bytes removed, 0 ops, 0 bytes left
+  func.func @test_fold_into_matmul(%arg0: tensor<64x32xf32> {tt.argument_type = #tt.argument_type<input>}, %arg1: tensor<64x128xf32>) -> tensor<32x128xf32> {
+    // CHECK-LABEL: func.func @test_fold_into_matmul
+    // CHECK-NOT: "ttir.transpose"
+    // CHECK: %[[EXP:[0-9]+]] = "ttir.exp"(%arg0,
+    // CHECK: %[[MATMUL:[0-9]+]] = "ttir.matmul"(%[[EXP]], %arg1, %{{[0-9]+}}) <{transpose_a = true}>
+    // CHECK: return %[[MATMUL]]
+    %0 = tensor.empty() : tensor<32x64xf32>
+    %1 = "ttir.transpose"(%arg0, %0) <{dim0 = 0 : si32, dim1 = 1 : si32}> : (tensor<64x32xf32>, tensor<32x64xf32>) -> tensor<32x64xf32>
+    %2 = tensor.empty() : tensor<32x64xf32>
+    %3 = "ttir.exp"(%1, %2) : (tensor<32x64xf32>, tensor<32x64xf32>) -> tensor<32x64xf32>
+    %4 = tensor.empty() : tensor<32x128xf32>
+    %5 = "ttir.matmul"(%3, %arg1, %4) : (tensor<32x64xf32>, tensor<64x128xf32>, tensor<32x128xf32>) -> tensor<32x128xf32>
+    return %5 : tensor<32x128xf32>
+  }
+}
@@ -114,8 +114,8 @@ func.func @matmul_multi_core(%arg0: memref<2x4x4x6x!tt.tile<32x32, f32>, #tt.sha
   // Operand 0 (input)
   // CHECK: ^datamovement0
   // CHECK: ttir.dma [[lhs]]<#map1>, %cb0
-  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_wait [[reader_ready_lhs:%[a-z0-9]+]]
+  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.dma %cb0, %cb0
   // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_set [[writer_done_lhs:%[a-z0-9]+]]
@@ -125,8 +125,8 @@ func.func @matmul_multi_core(%arg0: memref<2x4x4x6x!tt.tile<32x32, f32>, #tt.sha
   // Operand 1 (input)
   // CHECK: ^datamovement1
   // CHECK: ttir.dma [[rhs]]<#map2>, %cb1
-  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_wait [[reader_ready_rhs:%[a-z0-9]+]]
+  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.dma %cb1, %cb1
   // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_set [[writer_done_rhs:%[a-z0-9]+]]
@@ -161,8 +161,8 @@ func.func @matmul_multi_core_dram_params(%arg0: memref<2x4x4x6x!tt.tile<32x32, f
   // Operand 0 (input)
   // CHECK: ^datamovement0
   // CHECK: ttir.dma [[lhs]]<#map1>, %cb0
-  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_wait [[reader_ready_lhs:%[a-z0-9]+]]
+  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.dma %cb0, %cb0
   // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_set [[writer_done_lhs:%[a-z0-9]+]]
@@ -172,8 +172,8 @@ func.func @matmul_multi_core_dram_params(%arg0: memref<2x4x4x6x!tt.tile<32x32, f
   // Operand 1 (input)
   // CHECK: ^datamovement1
   // CHECK: ttir.dma [[rhs]]<#map2>, %cb1
-  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_wait [[reader_ready_rhs:%[a-z0-9]+]]
+  // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.dma %cb1, %cb1
   // CHECK-NEXT: ttir.dma_wait
   // CHECK-NEXT: ttir.semaphore_set [[writer_done_rhs:%[a-z0-9]+]]
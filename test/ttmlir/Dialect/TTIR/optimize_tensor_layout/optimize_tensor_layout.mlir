@@ -20,8 +20,8 @@ func.func @reduce_large_grid(%arg0: tensor<256x384xf32, #layout1>, %arg1: tensor
         threads = [#ttir.thread<compute>],
         operandSegmentSizes = array<i32: 2, 1>
         }> ({
-        // CHECK: ^compute0(%cb0: memref<1x2x!tt.tile<32x32, f32>, #l1_>,
-        // CHECK-SAME: %cb1: memref<1x2x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK: ^compute0(%cb0: memref<1x12x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb1: memref<1x12x!tt.tile<32x32, f32>, #l1_>,
         // CHECK-SAME: %cb2: memref<1x1x!tt.tile<32x32, f32>, #l1_>):
         ^bb0(%arg2: memref<8x12x!tt.tile<32x32, f32>, #l1_>,
             %arg3: memref<8x12x!tt.tile<32x32, f32>, #l1_>,
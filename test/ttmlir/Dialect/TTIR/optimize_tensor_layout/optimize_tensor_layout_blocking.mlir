@@ -0,0 +1,128 @@
+// RUN: ttmlir-opt --tt-register-device --ttir-optimize-tensor-layout --split-input-file %s 2>&1 | FileCheck %s
+// RUN: ttmlir-opt --tt-register-device --ttir-optimize-tensor-layout="allow-padded-shards=true" --split-input-file %s 2>&1 | FileCheck %s --check-prefix=PADDED
+// RUN: ttmlir-opt --tt-register-device --ttir-optimize-tensor-layout="report-blocking=true" --split-input-file %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=REPORT
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+#parallel = #tt.iterator_type<parallel>
+#l1_ = #tt.memory_space<l1>
+#layout = #tt.metal_layout<(d0, d1) -> (d0, d1), undef, <1x1>, memref<1x19x!tt.tile<32x32, f32>, #l1_>>
+
+// 19 tiles have no divisor that fits the worker grid, so only padded shards
+// spread them across more than one core.
+//
+// REPORT: remark: Blocking: loop factors 1x1, 1 cores, 6592 estimated cycles, 389120 bytes of L1 per core, 0 bytes of padding
+func.func @eltwise_prime(%arg0: tensor<32x608xf32, #layout>, %arg1: tensor<32x608xf32, #layout>) -> tensor<32x608xf32, #layout> {
+  %0 = ttir.empty() : tensor<32x608xf32, #layout>
+  // CHECK-NOT: ttir.to_layout
+  // PADDED: ttir.to_layout
+  // PADDED: ttir.generic {grid = #tt.grid<1x7>
+  %1 = "ttir.generic"(%arg0, %arg1, %0) <{
+        grid = #tt.grid<1x1>,
+        indexing_maps = [#map, #map, #map],
+        iterator_types = [#parallel, #parallel],
+        threads = [#ttir.thread<compute>],
+        operandSegmentSizes = array<i32: 2, 1>
+        }> ({
+        // CHECK: ^compute0(%cb0: memref<1x19x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb1: memref<1x19x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb2: memref<1x19x!tt.tile<32x32, f32>, #l1_>):
+        // PADDED: ^compute0(%cb0: memref<1x3x!tt.tile<32x32, f32>, #l1_>,
+        // PADDED-SAME: %cb1: memref<1x3x!tt.tile<32x32, f32>, #l1_>,
+        // PADDED-SAME: %cb2: memref<1x3x!tt.tile<32x32, f32>, #l1_>):
+        ^bb0(%arg2: memref<1x19x!tt.tile<32x32, f32>, #l1_>,
+            %arg3: memref<1x19x!tt.tile<32x32, f32>, #l1_>,
+            %arg4: memref<1x19x!tt.tile<32x32, f32>, #l1_>):
+            linalg.generic {
+                indexing_maps = [#map, #map, #map],
+                iterator_types = ["parallel", "parallel"]}
+                ins(%arg2, %arg3: memref<1x19x!tt.tile<32x32, f32>, #l1_>, memref<1x19x!tt.tile<32x32, f32>, #l1_>)
+                outs(%arg4: memref<1x19x!tt.tile<32x32, f32>, #l1_>) {
+                ^bb0(%a: !tt.tile<32x32, f32>, %b: !tt.tile<32x32, f32>, %c: !tt.tile<32x32, f32>):
+                    %2 = "ttir.tile_add" (%a, %b) : (!tt.tile<32x32, f32>, !tt.tile<32x32, f32>) -> !tt.tile<32x32, f32>
+                    linalg.yield %2: !tt.tile<32x32, f32>
+            }
+        "ttir.yield"() : () -> ()
+        }) : (tensor<32x608xf32, #layout>, tensor<32x608xf32, #layout>, tensor<32x608xf32, #layout>) -> tensor<32x608xf32, #layout>
+  return %1 : tensor<32x608xf32, #layout>
+}
+
+// -----
+
+#map1 = affine_map<(d0, d1, d2) -> (d0, d2)>
+#map2 = affine_map<(d0, d1, d2) -> (d2, d1)>
+#map3 = affine_map<(d0, d1, d2) -> (d0, d1)>
+#parallel = #tt.iterator_type<parallel>
+#reduction = #tt.iterator_type<reduction>
+#l1_ = #tt.memory_space<l1>
+#layout = #tt.metal_layout<(d0, d1) -> (d0, d1), undef, <1x1>, memref<8x8x!tt.tile<32x32, f32>, #l1_>>
+
+// The output is split across the whole worker grid, and each core reads its
+// row of the lhs and column of the rhs in a single block.
+//
+// REPORT: remark: Blocking: loop factors 8x8x1, 64 cores, 3072 estimated cycles, 135168 bytes of L1 per core, 0 bytes of padding
+func.func @matmul(%arg0: tensor<256x256xf32, #layout>, %arg1: tensor<256x256xf32, #layout>) -> tensor<256x256xf32, #layout> {
+  %0 = ttir.empty() : tensor<256x256xf32, #layout>
+  // CHECK: ttir.generic {grid = #tt.grid<8x8>
+  %1 = "ttir.generic"(%arg0, %arg1, %0) <{
+        grid = #tt.grid<1x1>,
+        indexing_maps = [#map1, #map2, #map3],
+        iterator_types = [#parallel, #parallel, #reduction],
+        threads = [#ttir.thread<compute>],
+        operandSegmentSizes = array<i32: 2, 1>
+        }> ({
+        // CHECK: ^compute0(%cb0: memref<1x8x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb1: memref<8x1x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb2: memref<1x1x!tt.tile<32x32, f32>, #l1_>):
+        ^bb0(%arg2: memref<8x8x!tt.tile<32x32, f32>, #l1_>,
+            %arg3: memref<8x8x!tt.tile<32x32, f32>, #l1_>,
+            %arg4: memref<8x8x!tt.tile<32x32, f32>, #l1_>):
+            "ttir.tile_matmul_block"(%arg2, %arg3, %arg4) : (memref<8x8x!tt.tile<32x32, f32>, #l1_>, memref<8x8x!tt.tile<32x32, f32>, #l1_>, memref<8x8x!tt.tile<32x32, f32>, #l1_>) -> ()
+        "ttir.yield"() : () -> ()
+        }) : (tensor<256x256xf32, #layout>, tensor<256x256xf32, #layout>, tensor<256x256xf32, #layout>) -> tensor<256x256xf32, #layout>
+  return %1 : tensor<256x256xf32, #layout>
+}
+
+// -----
+
+#map1 = affine_map<(d0, d1) -> (d0, d1)>
+#map2 = affine_map<(d0, d1) -> (d0, 0)>
+#sc_map = affine_map<(d0, d1) -> (0, 0)>
+#parallel = #tt.iterator_type<parallel>
+#reduction = #tt.iterator_type<reduction>
+#l1_ = #tt.memory_space<l1>
+#layout1 = #tt.metal_layout<(d0, d1) -> (d0, d1), undef, <1x1>, memref<8x256x!tt.tile<32x32, f32>, #l1_>>
+#layout2 = #tt.metal_layout<(d0, d1) -> (d0, d1), undef, <1x1>, memref<8x1x!tt.tile<32x32, f32>, #l1_>>
+
+// A row of 256 tiles does not fit in L1 with its stream buffers, so the
+// reduction is streamed in the fewest blocks that do.
+//
+// REPORT: remark: Blocking: loop factors 8x8, 8 cores, 71680 estimated cycles, 790528 bytes of L1 per core, 0 bytes of padding
+func.func @reduce_l1_bound(%arg0: tensor<256x8192xf32, #layout1>, %arg1: tensor<256x8192xf32, #layout1>) -> tensor<256x32xf32, #layout2> {
+  %0 = ttir.empty() : tensor<256x32xf32, #layout2>
+  // CHECK: ttir.generic {grid = #tt.grid<8x1>
+  %1 = "ttir.generic"(%arg0, %arg1, %0) <{
+        grid = #tt.grid<1x1>,
+        indexing_maps = [#map1, #map1, #map2],
+        iterator_types = [#parallel, #reduction],
+        threads = [#ttir.thread<compute>],
+        operandSegmentSizes = array<i32: 2, 1>
+        }> ({
+        // CHECK: ^compute0(%cb0: memref<1x32x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb1: memref<1x32x!tt.tile<32x32, f32>, #l1_>,
+        // CHECK-SAME: %cb2: memref<1x1x!tt.tile<32x32, f32>, #l1_>):
+        ^bb0(%arg2: memref<8x256x!tt.tile<32x32, f32>, #l1_>,
+            %arg3: memref<8x256x!tt.tile<32x32, f32>, #l1_>,
+            %arg4: memref<8x1x!tt.tile<32x32, f32>, #l1_>):
+            linalg.generic {
+                indexing_maps = [#map1, #sc_map, #map2],
+                iterator_types = ["parallel", "parallel"]}
+                ins(%arg2, %arg3: memref<8x256x!tt.tile<32x32, f32>, #l1_>, memref<8x256x!tt.tile<32x32, f32>, #l1_>)
+                outs(%arg4: memref<8x1x!tt.tile<32x32, f32>, #l1_>) {
+                ^bb0(%a: !tt.tile<32x32, f32>, %b: !tt.tile<32x32, f32>, %c: !tt.tile<32x32, f32>):
+                    %2 = "ttir.tile_reduce_max" (%a, %b) {reduce_dim = #ttir<reduce_dim R>} : (!tt.tile<32x32, f32>, !tt.tile<32x32, f32>) -> !tt.tile<32x32, f32>
+                    linalg.yield %2: !tt.tile<32x32, f32>
+            }
+        "ttir.yield"() : () -> ()
+        }) : (tensor<256x8192xf32, #layout1>, tensor<256x8192xf32, #layout1>, tensor<256x32xf32, #layout2>) -> tensor<256x32xf32, #layout2>
+  return %1 : tensor<256x32xf32, #layout2>
+}
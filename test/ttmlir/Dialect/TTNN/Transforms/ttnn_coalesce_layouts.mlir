@@ -0,0 +1,115 @@
+// RUN: ttmlir-opt --ttnn-coalesce-layouts %s | FileCheck %s
+// RUN: ttmlir-opt --ttnn-coalesce-layouts="report-coalescing=true" %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=REPORT
+
+#dram = #ttnn.buffer_type<dram>
+#l1 = #ttnn.buffer_type<l1>
+#system_memory = #ttnn.buffer_type<system_memory>
+#ttnn_layout_host_rm = #ttnn.ttnn_layout<(d0, d1) -> (d0, d1), <1x1>, memref<64x128xbf16, #system_memory>>
+#ttnn_layout_device_tile = #ttnn.ttnn_layout<(d0, d1) -> (d0, d1), <1x1>, memref<2x4x!tt.tile<32x32, bf16>, #dram>, <interleaved>>
+#ttnn_layout_device_tile_f32 = #ttnn.ttnn_layout<(d0, d1) -> (d0, d1), <1x1>, memref<2x4x!tt.tile<32x32, f32>, #dram>, <interleaved>>
+#ttnn_layout_l1_tile = #ttnn.ttnn_layout<(d0, d1) -> (d0, d1), <1x1>, memref<2x4x!tt.tile<32x32, bf16>, #l1>, <interleaved>>
+#ttnn_layout_cache_host_rm = #ttnn.ttnn_layout<(d0, d1, d2, d3) -> (d0 * 64 + d1 * 64 + d2, d3), <1x1>, memref<64x128xbf16, #system_memory>>
+#ttnn_layout_cache_device_tile = #ttnn.ttnn_layout<(d0, d1, d2, d3) -> (d0 * 64 + d1 * 64 + d2, d3), <1x1>, memref<2x4x!tt.tile<32x32, bf16>, #dram>, <interleaved>>
+module attributes {} {
+  // Moving the device tensor back to the host reproduces the argument.
+  //
+  // REPORT: remark: Layout conversions coalesced: 2 -> 1 ops, estimated cost 163840 -> 81920
+  func.func @fold_inverse_conversion(%arg0: tensor<64x128xbf16, #ttnn_layout_host_rm>) -> (tensor<64x128xbf16, #ttnn_layout_device_tile>, tensor<64x128xbf16, #ttnn_layout_host_rm>) {
+    // CHECK-LABEL: func.func @fold_inverse_conversion
+    // CHECK: %[[TO_DEVICE:.*]] = "ttnn.to_layout"(%arg0,
+    // CHECK: %[[EXP:.*]] = "ttnn.exp"(%[[TO_DEVICE]])
+    // CHECK-NOT: "ttnn.to_layout"
+    // CHECK: return %[[EXP]], %arg0
+    %0 = "ttnn.get_device"() <{mesh_shape = #ttnn<mesh_shape 1x1>}> : () -> !ttnn.device
+    %1 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %2 = "ttnn.exp"(%1) : (tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %3 = "ttnn.to_layout"(%1) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<row_major>, memory_config = #ttnn.memory_config<#system_memory, <<64x128>>>}> : (tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xbf16, #ttnn_layout_host_rm>
+    return %2, %3 : tensor<64x128xbf16, #ttnn_layout_device_tile>, tensor<64x128xbf16, #ttnn_layout_host_rm>
+  }
+
+  // Both users of the argument need it tilized on device, which is done once.
+  //
+  // REPORT: remark: Layout conversions coalesced: 2 -> 1 ops, estimated cost 163840 -> 81920
+  func.func @share_identical_conversions(%arg0: tensor<64x128xbf16, #ttnn_layout_host_rm>) -> tensor<64x128xbf16, #ttnn_layout_device_tile> {
+    // CHECK-LABEL: func.func @share_identical_conversions
+    // CHECK: %[[TO_DEVICE:.*]] = "ttnn.to_layout"(%arg0,
+    // CHECK-NOT: "ttnn.to_layout"
+    // CHECK: "ttnn.exp"(%[[TO_DEVICE]])
+    // CHECK: "ttnn.neg"(%[[TO_DEVICE]])
+    %0 = "ttnn.get_device"() <{mesh_shape = #ttnn<mesh_shape 1x1>}> : () -> !ttnn.device
+    %1 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %2 = "ttnn.exp"(%1) : (tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %3 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %4 = "ttnn.neg"(%3) : (tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %5 = "ttnn.add"(%2, %4) : (tensor<64x128xbf16, #ttnn_layout_device_tile>, tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    return %5 : tensor<64x128xbf16, #ttnn_layout_device_tile>
+  }
+
+  // The tensor in L1 is copied from the one already tilized in DRAM instead of
+  // being moved and tilized again.
+  //
+  // REPORT: remark: Layout conversions coalesced: 2 -> 2 ops, estimated cost 163840 -> 98304
+  func.func @share_conversion_prefix(%arg0: tensor<64x128xbf16, #ttnn_layout_host_rm>) -> (tensor<64x128xbf16, #ttnn_layout_device_tile>, tensor<64x128xbf16, #ttnn_layout_l1_tile>) {
+    // CHECK-LABEL: func.func @share_conversion_prefix
+    // CHECK: %[[TO_DRAM:.*]] = "ttnn.to_layout"(%arg0,
+    // CHECK: %[[TO_L1:.*]] = "ttnn.to_layout"(%[[TO_DRAM]],
+    // CHECK: "ttnn.neg"(%[[TO_L1]])
+    %0 = "ttnn.get_device"() <{mesh_shape = #ttnn<mesh_shape 1x1>}> : () -> !ttnn.device
+    %1 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %2 = "ttnn.exp"(%1) : (tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %3 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#l1, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    %4 = "ttnn.neg"(%3) : (tensor<64x128xbf16, #ttnn_layout_l1_tile>) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    return %2, %4 : tensor<64x128xbf16, #ttnn_layout_device_tile>, tensor<64x128xbf16, #ttnn_layout_l1_tile>
+  }
+
+  // Casting to bf16 loses precision, so casting back to f32 does not give the
+  // argument back.
+  //
+  // REPORT: remark: Layout conversions coalesced: 2 -> 2 ops, estimated cost 65536 -> 65536
+  func.func @keep_lossy_conversion(%arg0: tensor<64x128xf32, #ttnn_layout_device_tile_f32>) -> tensor<64x128xf32, #ttnn_layout_device_tile_f32> {
+    // CHECK-LABEL: func.func @keep_lossy_conversion
+    // CHECK: %[[TO_BF16:.*]] = "ttnn.to_layout"(%arg0)
+    // CHECK: %[[TO_F32:.*]] = "ttnn.to_layout"(%[[TO_BF16]])
+    // CHECK: return %[[TO_F32]]
+    %0 = "ttnn.to_layout"(%arg0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<64x128xf32, #ttnn_layout_device_tile_f32>) -> tensor<64x128xbf16, #ttnn_layout_device_tile>
+    %1 = "ttnn.to_layout"(%0) <{dtype = #tt.supportedDataTypes<f32>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_device_tile>) -> tensor<64x128xf32, #ttnn_layout_device_tile_f32>
+    return %1 : tensor<64x128xf32, #ttnn_layout_device_tile_f32>
+  }
+
+  // The device copy of the KV cache is updated in place, so moving it back to
+  // the host does not give the argument back.
+  //
+  // REPORT: remark: Layout conversions coalesced: 2 -> 2 ops, estimated cost 163840 -> 163840
+  func.func @keep_conversion_of_updated_cache(%arg0: tensor<1x1x64x128xbf16, #ttnn_layout_cache_host_rm>, %arg1: tensor<1x1x1x128xbf16>, %arg2: tensor<1xi32>) -> tensor<1x1x64x128xbf16, #ttnn_layout_cache_host_rm> {
+    // CHECK-LABEL: func.func @keep_conversion_of_updated_cache
+    // CHECK: %[[CACHE:.*]] = "ttnn.to_layout"(%arg0,
+    // CHECK: "ttnn.update_cache"(%[[CACHE]],
+    // CHECK: %[[TO_HOST:.*]] = "ttnn.to_layout"(%[[CACHE]])
+    // CHECK: return %[[TO_HOST]]
+    %0 = "ttnn.get_device"() <{mesh_shape = #ttnn<mesh_shape 1x1>}> : () -> !ttnn.device
+    %1 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#dram, <<2x4>>, <interleaved>>}> : (tensor<1x1x64x128xbf16, #ttnn_layout_cache_host_rm>, !ttnn.device) -> tensor<1x1x64x128xbf16, #ttnn_layout_cache_device_tile>
+    "ttnn.update_cache"(%1, %arg1, %arg2) <{batch_offset = 0 : i32}> : (tensor<1x1x64x128xbf16, #ttnn_layout_cache_device_tile>, tensor<1x1x1x128xbf16>, tensor<1xi32>) -> ()
+    %2 = "ttnn.to_layout"(%1) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<row_major>, memory_config = #ttnn.memory_config<#system_memory, <<64x128>>>}> : (tensor<1x1x64x128xbf16, #ttnn_layout_cache_device_tile>) -> tensor<1x1x64x128xbf16, #ttnn_layout_cache_host_rm>
+    return %2 : tensor<1x1x64x128xbf16, #ttnn_layout_cache_host_rm>
+  }
+
+  // The first L1 copy of the argument is last used by the exp. Sharing it with
+  // the neg would keep it in L1 past the point the optimizer expects it to be
+  // freed, so the second conversion is kept.
+  //
+  // REPORT: remark: Layout conversions coalesced: 2 -> 2 ops, estimated cost 163840 -> 163840
+  func.func @keep_conversion_past_l1_last_use(%arg0: tensor<64x128xbf16, #ttnn_layout_host_rm>) -> tensor<64x128xbf16, #ttnn_layout_l1_tile> {
+    // CHECK-LABEL: func.func @keep_conversion_past_l1_last_use
+    // CHECK: %[[FIRST:.*]] = "ttnn.to_layout"(%arg0,
+    // CHECK: "ttnn.exp"(%[[FIRST]])
+    // CHECK: %[[SECOND:.*]] = "ttnn.to_layout"(%arg0,
+    // CHECK: "ttnn.neg"(%[[SECOND]])
+    %0 = "ttnn.get_device"() <{mesh_shape = #ttnn<mesh_shape 1x1>}> : () -> !ttnn.device
+    %1 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#l1, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    %2 = "ttnn.exp"(%1) : (tensor<64x128xbf16, #ttnn_layout_l1_tile>) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    %3 = "ttnn.to_layout"(%arg0, %0) <{dtype = #tt.supportedDataTypes<bf16>, layout = #ttnn.layout<tile>, memory_config = #ttnn.memory_config<#l1, <<2x4>>, <interleaved>>}> : (tensor<64x128xbf16, #ttnn_layout_host_rm>, !ttnn.device) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    %4 = "ttnn.neg"(%3) : (tensor<64x128xbf16, #ttnn_layout_l1_tile>) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    %5 = "ttnn.add"(%2, %4) : (tensor<64x128xbf16, #ttnn_layout_l1_tile>, tensor<64x128xbf16, #ttnn_layout_l1_tile>) -> tensor<64x128xbf16, #ttnn_layout_l1_tile>
+    return %5 : tensor<64x128xbf16, #ttnn_layout_l1_tile>
+  }
+}
@@ -0,0 +1,43 @@
+// RUN: ttmlir-opt --ttnn-memory-aware-schedule %s | FileCheck %s
+// RUN: ttmlir-opt --ttnn-memory-aware-schedule="report-peak-memory=true" %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=REPORT
+
+#dram = #ttnn.buffer_type<dram>
+#ttnn_layout = #ttnn.ttnn_layout<(d0, d1) -> (d0, d1), <1x1>, memref<2x4x!tt.tile<32x32, bf16>, #dram>, <interleaved>>
+module attributes {} {
+  // Each branch is 16384 bytes per tensor. Finishing the first branch before
+  // starting the second one keeps four tensors live instead of five.
+  //
+  // REPORT: remark: Peak tensor memory: 81920 -> 65536 bytes, DRAM 81920 -> 65536 bytes, L1 0 -> 0 bytes
+  func.func @parallel_branches(%arg0: tensor<64x128xbf16, #ttnn_layout>, %arg1: tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout> {
+    // CHECK-LABEL: func.func @parallel_branches
+    // CHECK: %[[EXP0:.*]] = "ttnn.exp"(%arg0)
+    // CHECK-NEXT: %[[EXP1:.*]] = "ttnn.exp"(%arg1)
+    // CHECK-NEXT: %[[NEG0:.*]] = "ttnn.neg"(%[[EXP0]])
+    // CHECK-NEXT: %[[ADD0:.*]] = "ttnn.add"(%[[EXP0]], %[[NEG0]])
+    // CHECK-NEXT: %[[NEG1:.*]] = "ttnn.neg"(%[[EXP1]])
+    // CHECK-NEXT: %[[ADD1:.*]] = "ttnn.add"(%[[EXP1]], %[[NEG1]])
+    // CHECK-NEXT: %[[RESULT:.*]] = "ttnn.add"(%[[ADD0]], %[[ADD1]])
+    // CHECK-NEXT: return %[[RESULT]]
+    %0 = "ttnn.exp"(%arg0) : (tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %1 = "ttnn.exp"(%arg1) : (tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %2 = "ttnn.neg"(%0) : (tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %3 = "ttnn.neg"(%1) : (tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %4 = "ttnn.add"(%0, %2) : (tensor<64x128xbf16, #ttnn_layout>, tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %5 = "ttnn.add"(%1, %3) : (tensor<64x128xbf16, #ttnn_layout>, tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %6 = "ttnn.add"(%4, %5) : (tensor<64x128xbf16, #ttnn_layout>, tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    return %6 : tensor<64x128xbf16, #ttnn_layout>
+  }
+
+  // Already optimal order is kept.
+  //
+  // REPORT: remark: Peak tensor memory: 32768 -> 32768 bytes, DRAM 32768 -> 32768 bytes, L1 0 -> 0 bytes
+  func.func @chain(%arg0: tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout> {
+    // CHECK-LABEL: func.func @chain
+    // CHECK: %[[EXP:.*]] = "ttnn.exp"(%arg0)
+    // CHECK-NEXT: %[[NEG:.*]] = "ttnn.neg"(%[[EXP]])
+    // CHECK-NEXT: return %[[NEG]]
+    %0 = "ttnn.exp"(%arg0) : (tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    %1 = "ttnn.neg"(%0) : (tensor<64x128xbf16, #ttnn_layout>) -> tensor<64x128xbf16, #ttnn_layout>
+    return %1 : tensor<64x128xbf16, #ttnn_layout>
+  }
+}
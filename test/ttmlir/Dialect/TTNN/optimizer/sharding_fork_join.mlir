@@ -0,0 +1,20 @@
+// REQUIRES: opmodel
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline="enable-optimizer=true memory-layout-analysis-enabled=true" -o output_file.mlir %s
+// RUN: FileCheck %s --input-file=output_file.mlir
+module attributes {} {
+  func.func @forward(%arg0: tensor<64x128xbf16>) -> tensor<64x128xbf16> {
+    // CHECK: #[[L1_:.*]] = #ttnn.buffer_type<l1>
+    // CHECK: #[[LAYOUT_L1:.*]] = #ttnn.ttnn_layout<{{.*}}#[[L1_]]>
+    %0 = ttir.empty() : tensor<64x128xbf16>
+    // CHECK: %[[FORK:.*]] = "ttnn.relu"{{.*}} -> tensor<64x128xbf16, #[[LAYOUT_L1]]>
+    %1 = "ttir.relu"(%arg0, %0) : (tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    %2 = ttir.empty() : tensor<64x128xbf16>
+    // CHECK: %[[BRANCH:.*]] = "ttnn.relu"(%[[FORK]]{{.*}} -> tensor<64x128xbf16, #[[LAYOUT_L1]]>
+    %3 = "ttir.relu"(%1, %2) : (tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    %4 = ttir.empty() : tensor<64x128xbf16>
+    // Both branches of the fork are consumed from L1 by the join.
+    // CHECK: "ttnn.add"(%[[FORK]], %[[BRANCH]]{{.*}}(tensor<64x128xbf16, #[[LAYOUT_L1]]>, tensor<64x128xbf16, #[[LAYOUT_L1]]>{{.*}} -> tensor<64x128xbf16, #[[LAYOUT_L1]]>
+    %5 = "ttir.add"(%1, %3, %4) : (tensor<64x128xbf16>, tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    return %5 : tensor<64x128xbf16>
+  }
+}
@@ -0,0 +1,26 @@
+// REQUIRES: opmodel
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline="enable-optimizer=true memory-layout-analysis-enabled=true report-spills=true" -o %t.mlir %s 2>&1 | FileCheck %s --check-prefix=REPORT
+// RUN: FileCheck %s --input-file=%t.mlir
+// Both producers of the join are in the chain, so the join is checked with
+// both of its operands in L1 and the chain continues past it. Only the end of
+// the chain is spilled to DRAM.
+// REPORT: remark: 1 L1 chain outputs spilled to DRAM
+module attributes {} {
+  func.func @forward(%arg0: tensor<64x128xbf16>) -> tensor<64x128xbf16> {
+    // CHECK: #[[L1_:.*]] = #ttnn.buffer_type<l1>
+    // CHECK: #[[LAYOUT_L1:.*]] = #ttnn.ttnn_layout<{{.*}}#[[L1_]]>
+    %0 = ttir.empty() : tensor<64x128xbf16>
+    // CHECK: %[[FORK:.*]] = "ttnn.relu"{{.*}} -> tensor<64x128xbf16, #[[LAYOUT_L1]]>
+    %1 = "ttir.relu"(%arg0, %0) : (tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    %2 = ttir.empty() : tensor<64x128xbf16>
+    // CHECK: %[[BRANCH:.*]] = "ttnn.relu"(%[[FORK]]{{.*}} -> tensor<64x128xbf16, #[[LAYOUT_L1]]>
+    %3 = "ttir.relu"(%1, %2) : (tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    %4 = ttir.empty() : tensor<64x128xbf16>
+    // CHECK: %[[JOIN:.*]] = "ttnn.add"(%[[FORK]], %[[BRANCH]]{{.*}} -> tensor<64x128xbf16, #[[LAYOUT_L1]]>
+    %5 = "ttir.add"(%1, %3, %4) : (tensor<64x128xbf16>, tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    %6 = ttir.empty() : tensor<64x128xbf16>
+    // CHECK: "ttnn.relu"(%[[JOIN]]
+    %7 = "ttir.relu"(%5, %6) : (tensor<64x128xbf16>, tensor<64x128xbf16>) -> tensor<64x128xbf16>
+    return %7 : tensor<64x128xbf16>
+  }
+}
@@ -0,0 +1,20 @@
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline="system-desc-path=%system_desc_path% enable-const-eval=true" %s > %t.mlir
+// RUN: FileCheck %s --input-file=%t.mlir
+// RUN: ttmlir-translate --ttnn-to-flatbuffer %t.mlir > %t.ttnn
+
+// Used by the const-eval persistent cache round trip runtime test.
+module {
+  // CHECK-LABEL: func.func @forward_const_eval_0
+  // CHECK: = "ttnn.subtract"
+
+  // CHECK: func.func @forward(
+  func.func @forward(%arg0: tensor<32x32xbf16> {tt.argument_type = #tt.argument_type<input>}, %arg1: tensor<32x32xbf16> {tt.argument_type = #tt.argument_type<parameter>}, %arg2: tensor<32x32xbf16> {tt.argument_type = #tt.argument_type<parameter>}) -> tensor<32x32xbf16> {
+    // CHECK: tt.load_cached(@forward_const_eval_0, [%arg1, %arg2])
+    %0 = ttir.empty() : tensor<32x32xbf16>
+    %1 = "ttir.subtract"(%arg1, %arg2, %0) : (tensor<32x32xbf16>, tensor<32x32xbf16>, tensor<32x32xbf16>) -> tensor<32x32xbf16>
+    %2 = ttir.empty() : tensor<32x32xbf16>
+    // CHECK: "ttnn.add"
+    %3 = "ttir.add"(%arg0, %1, %2) : (tensor<32x32xbf16>, tensor<32x32xbf16>, tensor<32x32xbf16>) -> tensor<32x32xbf16>
+    return %3 : tensor<32x32xbf16>
+  }
+}
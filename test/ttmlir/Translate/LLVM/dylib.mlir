@@ -1,4 +1,8 @@
 // RUN: ttmlir-translate --llvm-to-dylib %s | llvm-nm -g - | FileCheck %s
+// RUN: ttmlir-translate --llvm-to-dylib --dylib-opt-level=3 --dylib-mcpu=x86-64-v3 %s | llvm-nm -g - | FileCheck %s --check-prefix=TUNED
+// RUN: rm -rf %t && ttmlir-translate --llvm-to-dylib --dylib-object-cache-dir=%t %s | llvm-nm -g - | FileCheck %s
+// RUN: ttmlir-translate --llvm-to-dylib --dylib-object-cache-dir=%t %s | llvm-nm -g - | FileCheck %s
+// RUN: ls %t | FileCheck %s --check-prefix=CACHE
 // UNSUPPORTED: system-darwin
 
 module attributes {ttir.cpu_module} {
@@ -126,5 +130,7 @@ module attributes {ttir.cpu_module} {
 }
 
 // CHECK: T add
+// TUNED: T add
 // CHECK: U malloc
 // CHECK: U memrefCopy
+// CACHE: {{^[0-9a-f]+\.o$}}
@@ -0,0 +1,14 @@
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline %s | ttmlir-translate --ttnn-to-flatbuffer --ttnn-flatbuffer-debug-artifacts=%t.json -o %t.ttnn
+// RUN: FileCheck %s --input-file=%t.json
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline %s | ttmlir-translate --ttnn-to-flatbuffer --ttnn-flatbuffer-emit-cpp=false --ttnn-flatbuffer-debug-artifacts=%t.nocpp.json -o %t.nocpp.ttnn
+// RUN: FileCheck %s --input-file=%t.nocpp.json --check-prefix=NOCPP
+// RUN: ttmlir-opt --ttir-to-ttnn-backend-pipeline %s | not ttmlir-translate --ttnn-to-flatbuffer --ttnn-flatbuffer-debug-artifacts=%t.missing/debug.json -o %t.error.ttnn 2>&1 | FileCheck %s --check-prefix=ERROR
+
+// CHECK: {"cpp":"{{.+}}","mlir_stages":[]}
+// NOCPP: {"cpp":"","mlir_stages":[]}
+// ERROR: error: could not open debug artifacts file {{.*}}debug.json
+func.func @add(%arg0: tensor<64x128xf32>, %arg1: tensor<64x128xf32>) -> tensor<64x128xf32> {
+  %0 = ttir.empty() : tensor<64x128xf32>
+  %1 = "ttir.add"(%arg0, %arg1, %0) : (tensor<64x128xf32>, tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<64x128xf32>
+  return %1 : tensor<64x128xf32>
+}
@@ -6,11 +6,14 @@
 
 #include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
 #include "ttmlir/Dialect/TTNN/IR/TTNNOpsAttrs.h"
+#include "ttmlir/OpModel/TTNN/OpModelCache.h"
 #include "ttmlir/OpModel/TTNN/SingletonDeviceContext.h"
 #include "ttmlir/OpModel/TTNN/TTNNOpModel.h"
 
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
 #include "gtest/gtest.h"
 
 #include <cstdint>
@@ -1524,4 +1527,58 @@ INSTANTIATE_TEST_SUITE_P(
                            mlir::tt::ttnn::BufferType::L1},
         1.0, 5.0, true)));
 
+TEST_F(OpModelTest, OpModelCache) {
+  OpModelCache &cache = OpModelCache::getInstance();
+  cache.clear();
+  cache.resetStats();
+
+  const llvm::SmallVector<int64_t> tensorShape = {workerCoresN300, 1024};
+  const mlir::tt::ttnn::TTNNLayoutAttr layout = CreateTiledLayout(
+      tensorShape, mlir::tt::ttnn::BufferType::L1,
+      mlir::tt::ttnn::TensorMemoryLayout::Interleaved);
+
+  auto queryConstraints = [&]() {
+    return ReluOpInterface::getOpConstraints(CreateWorkerGrid(), tensorShape,
+                                             layout, tensorShape, layout);
+  };
+
+  auto firstExp = queryConstraints();
+  ASSERT_TRUE(static_cast<bool>(firstExp));
+  auto secondExp = queryConstraints();
+  ASSERT_TRUE(static_cast<bool>(secondExp));
+
+  OpModelCache::Stats stats = cache.getStats();
+  EXPECT_EQ(stats.constraintsMisses, 1);
+  EXPECT_EQ(stats.constraintsHits, 1);
+
+  const auto [cbSize, peakSize, outputSize, outputLayout] = firstExp.get();
+  const auto [cachedCbSize, cachedPeakSize, cachedOutputSize,
+              cachedOutputLayout] = secondExp.get();
+  EXPECT_EQ(cbSize, cachedCbSize);
+  EXPECT_EQ(peakSize, cachedPeakSize);
+  EXPECT_EQ(outputSize, cachedOutputSize);
+  EXPECT_EQ(outputLayout, cachedOutputLayout);
+
+  // Round trip through the on-disk format.
+  llvm::SmallString<128> path;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("opmodel-cache", "txt", path));
+  ASSERT_FALSE(llvm::errorToBool(cache.saveToFile(path, "fingerprint")));
+  size_t numEntries = cache.size();
+
+  cache.clear();
+  ASSERT_FALSE(llvm::errorToBool(cache.loadFromFile(path, "other")));
+  EXPECT_EQ(cache.size(), 0);
+  ASSERT_FALSE(llvm::errorToBool(cache.loadFromFile(path, "fingerprint")));
+  EXPECT_EQ(cache.size(), numEntries);
+  llvm::sys::fs::remove(path);
+
+  cache.resetStats();
+  auto thirdExp = queryConstraints();
+  ASSERT_TRUE(static_cast<bool>(thirdExp));
+  EXPECT_EQ(cache.getStats().constraintsHits, 1);
+  EXPECT_EQ(std::get<0>(thirdExp.get()), cbSize);
+  ExpectLayoutsEQ(outputLayout, std::get<3>(thirdExp.get()));
+}
+
 } // namespace mlir::tt::op_model::ttnn
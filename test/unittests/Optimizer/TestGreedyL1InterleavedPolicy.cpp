@@ -193,3 +193,111 @@ TEST_F(GreedyL1InterleavedPolicyBase, VerifyGreedyPolicy) {
   ASSERT_EQ(greedyConfig.precedence[1], opA);
   ASSERT_EQ(greedyConfig.precedence[2], opB);
 }
+
+TEST_F(GreedyL1InterleavedPolicyBase, VerifyGreedyPolicyWideFanIn) {
+  std::vector<L1ChainConfig> l1ChainConfigs;
+  llvm::DenseMap<mlir::Operation *, std::vector<OpConfig>> legalConfigs;
+  llvm::DenseMap<mlir::func::FuncOp, llvm::SmallVector<mlir::Operation *>>
+      schedule;
+  llvm::DenseMap<mlir::Operation *, L1Usage> opsL1Usage;
+  constexpr uint64_t usableL1CacheSize = 24;
+  constexpr int numOperands = 12;
+
+  // Create operands with growing required L1 usage. Enumerating all
+  // precedences of this many operands is not feasible.
+  mlir::Value lhs = func.getBody().getBlocks().front().getArgument(0);
+  mlir::Value rhs = func.getBody().getBlocks().front().getArgument(1);
+  llvm::SmallVector<mlir::Operation *> operands;
+  for (int i = 0; i < numOperands; i++) {
+    mlir::Operation *op =
+        builder.create<AddOp>(builder.getUnknownLoc(), lhs.getType(), lhs, rhs);
+    prepareOpForGreedyConfigPicker(op, /*outputL1Usage=*/1,
+                                   /*requiredL1Usage=*/2 + i, legalConfigs,
+                                   opsL1Usage);
+    operands.push_back(op);
+  }
+
+  // Create base op
+  mlir::Operation *baseOp =
+      builder.create<AddOp>(builder.getUnknownLoc(), lhs.getType(), lhs, rhs);
+  prepareOpForGreedyConfigPicker(baseOp, /*outputL1Usage=*/4,
+                                 /*requiredL1Usage=*/0, legalConfigs,
+                                 opsL1Usage);
+
+  // Run greedy config picker policy
+  GreedyL1InterleavedPolicy l1InterleavedPolicy(
+      nullptr, l1ChainConfigs, legalConfigs, schedule, usableL1CacheSize);
+  GreedyPolicyChoice greedyConfig =
+      l1InterleavedPolicy.getGreedyConfig(baseOp, opsL1Usage);
+
+  ASSERT_TRUE(greedyConfig.baseOp == baseOp);
+  ASSERT_EQ(greedyConfig.configs.size(), numOperands + 1u);
+  ASSERT_EQ(greedyConfig.precedence.size(), static_cast<size_t>(numOperands));
+
+  // Everything fits into L1 when the operands with the largest required L1
+  // usage are scheduled first.
+  for (const auto &[op, config] : greedyConfig.configs) {
+    ASSERT_TRUE(config.outputLayout.hasL1BufferType());
+  }
+  for (int i = 0; i < numOperands; i++) {
+    ASSERT_EQ(greedyConfig.precedence[i], operands[numOperands - 1 - i]);
+  }
+}
+
+TEST_F(GreedyL1InterleavedPolicyBase, VerifyGreedyPolicyManyOperands) {
+  std::vector<L1ChainConfig> l1ChainConfigs;
+  llvm::DenseMap<mlir::Operation *, std::vector<OpConfig>> legalConfigs;
+  llvm::DenseMap<mlir::func::FuncOp, llvm::SmallVector<mlir::Operation *>>
+      schedule;
+  llvm::DenseMap<mlir::Operation *, L1Usage> opsL1Usage;
+  constexpr uint64_t usableL1CacheSize = 40;
+  constexpr int numOperands = 40;
+  constexpr int numL1Operands = 26;
+
+  // Create more operands than can be enumerated exhaustively, all with the
+  // same L1 usage so that only program order can break the ties.
+  mlir::Value lhs = func.getBody().getBlocks().front().getArgument(0);
+  mlir::Value rhs = func.getBody().getBlocks().front().getArgument(1);
+  llvm::SmallVector<mlir::Operation *> operands;
+  for (int i = 0; i < numOperands; i++) {
+    mlir::Operation *op =
+        builder.create<AddOp>(builder.getUnknownLoc(), lhs.getType(), lhs, rhs);
+    prepareOpForGreedyConfigPicker(op, /*outputL1Usage=*/1,
+                                   /*requiredL1Usage=*/2, legalConfigs,
+                                   opsL1Usage);
+    operands.push_back(op);
+  }
+
+  // Create base op
+  mlir::Operation *baseOp =
+      builder.create<AddOp>(builder.getUnknownLoc(), lhs.getType(), lhs, rhs);
+  prepareOpForGreedyConfigPicker(baseOp, /*outputL1Usage=*/4,
+                                 /*requiredL1Usage=*/0, legalConfigs,
+                                 opsL1Usage);
+
+  // Run greedy config picker policy
+  GreedyL1InterleavedPolicy l1InterleavedPolicy(
+      nullptr, l1ChainConfigs, legalConfigs, schedule, usableL1CacheSize);
+  GreedyPolicyChoice greedyConfig =
+      l1InterleavedPolicy.getGreedyConfig(baseOp, opsL1Usage);
+
+  ASSERT_TRUE(greedyConfig.baseOp == baseOp);
+  ASSERT_EQ(greedyConfig.configs.size(), numOperands + 1u);
+  ASSERT_EQ(greedyConfig.precedence.size(), static_cast<size_t>(numOperands));
+  ASSERT_TRUE(greedyConfig.configs[baseOp].outputLayout.hasL1BufferType());
+
+  // 30 units of L1 are available and the base op takes 4 of them, so the
+  // first 26 operands in program order go to L1. DRAM operands are scheduled
+  // first, both groups in program order.
+  for (int i = 0; i < numOperands; i++) {
+    ASSERT_EQ(greedyConfig.configs[operands[i]].outputLayout.hasL1BufferType(),
+              i < numL1Operands);
+  }
+  for (int i = 0; i < numOperands - numL1Operands; i++) {
+    ASSERT_EQ(greedyConfig.precedence[i], operands[numL1Operands + i]);
+  }
+  for (int i = 0; i < numL1Operands; i++) {
+    ASSERT_EQ(greedyConfig.precedence[numOperands - numL1Operands + i],
+              operands[i]);
+  }
+}
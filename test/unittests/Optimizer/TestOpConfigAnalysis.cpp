@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TT/Transforms/Transforms.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpConfigAnalysis.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpCostModel.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNN.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace mlir::tt::ttnn;
+
+constexpr int TensorDimX = 128;
+constexpr int TensorDimY = 128;
+
+// Cost model with fixed per layout costs. Records input layouts it was
+// queried with.
+//
+class FixedOpCostModel : public OpCostModel {
+public:
+  double rowMajorCost = 1.0;
+  double tileCost = 2.0;
+  double l1Cost = 0.0;
+  mutable llvm::DenseMap<mlir::Operation *, std::vector<TTNNLayoutAttr>>
+      queriedInputs;
+
+  OpCost getOpCost(mlir::Operation *op,
+                   const std::vector<TTNNLayoutAttr> &inputLayouts,
+                   const OpConfig &config) const override {
+    queriedInputs[op] = inputLayouts;
+    if (config.outputLayout.hasL1BufferType()) {
+      return OpCost{l1Cost, /*measured=*/false};
+    }
+    return OpCost{config.outputLayout.isTiled() ? tileCost : rowMajorCost,
+                  /*measured=*/false};
+  }
+
+  double getLayoutConversionCost(mlir::RankedTensorType tensorType,
+                                 TTNNLayoutAttr from,
+                                 TTNNLayoutAttr to) const override {
+    return 0.0;
+  }
+};
+
+class OpConfigAnalysisTest : public ::testing::Test {
+public:
+  mlir::MLIRContext context;
+  mlir::OwningOpRef<mlir::ModuleOp> module;
+  mlir::OpBuilder builder = mlir::OpBuilder(&context);
+  mlir::func::FuncOp func;
+
+  void SetUp() override {
+    context.loadDialect<TTNNDialect>();
+    module = mlir::ModuleOp::create(builder.getUnknownLoc());
+    builder.setInsertionPointToStart(&module->getBodyRegion().front());
+    mlir::tt::registerDevice(module.get());
+
+    mlir::SmallVector<mlir::Type> input(2, getTensorRankedType());
+    mlir::SmallVector<mlir::Type> output(1, getTensorRankedType());
+    auto funcType = builder.getType<mlir::FunctionType>(
+        mlir::TypeRange(input), mlir::TypeRange(output));
+    func = builder.create<mlir::func::FuncOp>(builder.getUnknownLoc(), "test",
+                                              funcType);
+    mlir::Block *block = func.addEntryBlock();
+    builder.setInsertionPointToStart(block);
+  }
+
+  mlir::RankedTensorType getTensorRankedType() {
+    return mlir::RankedTensorType::get({TensorDimX, TensorDimY},
+                                       builder.getF32Type());
+  }
+
+  TTNNLayoutAttr getLayout(BufferType bufferType, bool tiled) {
+    mlir::Type elementType = builder.getF32Type();
+    if (tiled) {
+      elementType = mlir::tt::TileType::get(elementType);
+    }
+    return TTNNLayoutAttr::get(
+        &context, getTensorRankedType().getShape(), elementType, bufferType,
+        mlir::tt::GridAttr::get(&context, {8, 8}),
+        TensorMemoryLayoutAttr::get(&context, TensorMemoryLayout::Interleaved));
+  }
+
+  std::vector<OpConfig> getConfigs() {
+    return {getLayout(BufferType::DRAM, /*tiled=*/false),
+            getLayout(BufferType::DRAM, /*tiled=*/true),
+            getLayout(BufferType::L1, /*tiled=*/true)};
+  }
+
+  mlir::Operation *createAddOp(mlir::Value lhs, mlir::Value rhs) {
+    return builder.create<AddOp>(builder.getUnknownLoc(), getTensorRankedType(),
+                                 lhs, rhs);
+  }
+};
+
+TEST_F(OpConfigAnalysisTest, PicksCheapestDRAMConfig) {
+  mlir::Value lhs = func.getArgument(0);
+  mlir::Value rhs = func.getArgument(1);
+  mlir::Operation *opA = createAddOp(lhs, rhs);
+  mlir::Operation *opB = createAddOp(opA->getResult(0), rhs);
+
+  llvm::DenseMap<mlir::Operation *, std::vector<OpConfig>> legalConfigs;
+  legalConfigs[opA] = getConfigs();
+  legalConfigs[opB] = getConfigs();
+
+  auto costModel = std::make_shared<FixedOpCostModel>();
+  OpConfigAnalysis opConfigAnalysis(module.get());
+  opConfigAnalysis.init(OpConfigAnalysisInput(legalConfigs, costModel));
+  const auto &result = opConfigAnalysis.getResult();
+
+  // L1 config is cheapest but was not planned by the memory layout analysis.
+  //
+  EXPECT_EQ(result.lookup(opA).outputLayout,
+            getLayout(BufferType::DRAM, /*tiled=*/false));
+  EXPECT_EQ(result.lookup(opB).outputLayout,
+            getLayout(BufferType::DRAM, /*tiled=*/false));
+
+  // Consumer is scored with the layout picked for its producer.
+  //
+  ASSERT_EQ(costModel->queriedInputs[opB].size(), 2u);
+  EXPECT_EQ(costModel->queriedInputs[opB][0],
+            getLayout(BufferType::DRAM, /*tiled=*/false));
+}
+
+TEST_F(OpConfigAnalysisTest, KeepsSingleConfig) {
+  mlir::Value lhs = func.getArgument(0);
+  mlir::Value rhs = func.getArgument(1);
+  mlir::Operation *opA = createAddOp(lhs, rhs);
+
+  llvm::DenseMap<mlir::Operation *, std::vector<OpConfig>> legalConfigs;
+  legalConfigs[opA] = {getLayout(BufferType::L1, /*tiled=*/true)};
+
+  auto costModel = std::make_shared<FixedOpCostModel>();
+  costModel->l1Cost = 100.0;
+  OpConfigAnalysis opConfigAnalysis(module.get());
+  opConfigAnalysis.init(OpConfigAnalysisInput(legalConfigs, costModel));
+
+  EXPECT_EQ(opConfigAnalysis.getResult().lookup(opA).outputLayout,
+            getLayout(BufferType::L1, /*tiled=*/true));
+  EXPECT_TRUE(costModel->queriedInputs.empty());
+}
+
+TEST_F(OpConfigAnalysisTest, AnalyticalModelPrefersTiledCompute) {
+  mlir::Value lhs = func.getArgument(0);
+  mlir::Value rhs = func.getArgument(1);
+  mlir::Operation *opA = createAddOp(lhs, rhs);
+
+  AnalyticalOpCostModel costModel;
+  TTNNLayoutAttr tiled = getLayout(BufferType::DRAM, /*tiled=*/true);
+  TTNNLayoutAttr rowMajor = getLayout(BufferType::DRAM, /*tiled=*/false);
+  std::vector<TTNNLayoutAttr> inputs = {tiled, tiled};
+
+  EXPECT_LT(costModel.getOpCost(opA, inputs, OpConfig(tiled)).runtime,
+            costModel.getOpCost(opA, inputs, OpConfig(rowMajor)).runtime);
+  EXPECT_EQ(
+      costModel.getLayoutConversionCost(getTensorRankedType(), tiled, tiled),
+      0.0);
+  EXPECT_GT(
+      costModel.getLayoutConversionCost(getTensorRankedType(), tiled, rowMajor),
+      costModel.getLayoutConversionCost(
+          getTensorRankedType(), tiled,
+          getLayout(BufferType::L1, /*tiled=*/true)));
+
+  llvm::DenseMap<mlir::Operation *, std::vector<OpConfig>> legalConfigs;
+  legalConfigs[opA] = getConfigs();
+  OpConfigAnalysis opConfigAnalysis(module.get());
+  opConfigAnalysis.init(OpConfigAnalysisInput(
+      legalConfigs, std::make_shared<AnalyticalOpCostModel>()));
+  EXPECT_EQ(opConfigAnalysis.getResult().lookup(opA).outputLayout, tiled);
+}
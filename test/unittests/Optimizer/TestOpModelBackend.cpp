@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: (c) 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include "ttmlir/Dialect/TT/IR/TTOpsTypes.h"
+#include "ttmlir/Dialect/TT/Transforms/Transforms.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpConfig.h"
+#include "ttmlir/Dialect/TTNN/Analysis/OpModelBackend.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNN.h"
+#include "ttmlir/Dialect/TTNN/IR/TTNNOps.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+
+using namespace mlir::tt::ttnn;
+
+constexpr int TensorDimX = 128;
+constexpr int TensorDimY = 128;
+// Size of a 32x32 f32 tile.
+constexpr size_t TileSizeBytes = 4096;
+
+class OpModelBackendTest : public ::testing::Test {
+public:
+  mlir::MLIRContext context;
+  mlir::OwningOpRef<mlir::ModuleOp> module;
+  mlir::OpBuilder builder = mlir::OpBuilder(&context);
+  mlir::func::FuncOp func;
+
+  void SetUp() override {
+    context.loadDialect<TTNNDialect>();
+    module = mlir::ModuleOp::create(builder.getUnknownLoc());
+    builder.setInsertionPointToStart(&module->getBodyRegion().front());
+    mlir::tt::registerDevice(module.get());
+
+    mlir::SmallVector<mlir::Type> input(2, getTensorRankedType());
+    mlir::SmallVector<mlir::Type> output(1, getTensorRankedType());
+    auto funcType = builder.getType<mlir::FunctionType>(
+        mlir::TypeRange(input), mlir::TypeRange(output));
+    func = builder.create<mlir::func::FuncOp>(builder.getUnknownLoc(), "test",
+                                              funcType);
+    mlir::Block *block = func.addEntryBlock();
+    builder.setInsertionPointToStart(block);
+  }
+
+  mlir::RankedTensorType getTensorRankedType() {
+    return mlir::RankedTensorType::get({TensorDimX, TensorDimY},
+                                       builder.getF32Type());
+  }
+
+  TTNNLayoutAttr getLayout(BufferType bufferType,
+                           TensorMemoryLayout memoryLayout, int64_t gridDim) {
+    return TTNNLayoutAttr::get(
+        &context, getTensorRankedType().getShape(),
+        mlir::tt::TileType::get(builder.getF32Type()), bufferType,
+        mlir::tt::GridAttr::get(&context, {gridDim, gridDim}),
+        TensorMemoryLayoutAttr::get(&context, memoryLayout));
+  }
+
+  TTNNLayoutAttr getDRAMLayout() {
+    return getLayout(BufferType::DRAM, TensorMemoryLayout::Interleaved, 1);
+  }
+
+  mlir::Operation *createAddOp() {
+    return builder.create<AddOp>(builder.getUnknownLoc(), getTensorRankedType(),
+                                 func.getArgument(0), func.getArgument(1));
+  }
+};
+
+TEST_F(OpModelBackendTest, AnalyticalShardedOutput) {
+  mlir::Operation *op = createAddOp();
+  TTNNLayoutAttr outputLayout =
+      getLayout(BufferType::L1, TensorMemoryLayout::BlockSharded, 2);
+
+  AnalyticalOpModelBackend backend;
+  auto constraints = backend.getOpConstraints(
+      op, {getDRAMLayout(), getDRAMLayout()}, OpConfig(outputLayout));
+  ASSERT_TRUE(static_cast<bool>(constraints));
+
+  auto [cbUsage, tensorUsage, outputUsage, layout] = *constraints;
+  // Only the DRAM inputs are streamed through circular buffers, the output is
+  // written in place. Each core holds a 64x64 shard.
+  EXPECT_EQ(cbUsage, 2 * 2 * TileSizeBytes);
+  EXPECT_EQ(outputUsage, 4 * TileSizeBytes);
+  EXPECT_EQ(tensorUsage, outputUsage);
+  EXPECT_EQ(layout, outputLayout);
+}
+
+TEST_F(OpModelBackendTest, AnalyticalDRAMOutput) {
+  mlir::Operation *op = createAddOp();
+
+  AnalyticalOpModelBackend backend;
+  auto constraints = backend.getOpConstraints(
+      op, {getDRAMLayout(), getDRAMLayout()}, OpConfig(getDRAMLayout()));
+  ASSERT_TRUE(static_cast<bool>(constraints));
+
+  auto [cbUsage, tensorUsage, outputUsage, layout] = *constraints;
+  EXPECT_EQ(cbUsage, 3 * 2 * TileSizeBytes);
+  EXPECT_EQ(tensorUsage, 0u);
+  EXPECT_EQ(outputUsage, 0u);
+  EXPECT_EQ(layout, getDRAMLayout());
+}
+
+TEST_F(OpModelBackendTest, AnalyticalRequiresOutputLayout) {
+  mlir::Operation *op = createAddOp();
+
+  AnalyticalOpModelBackend backend;
+  auto constraints = backend.getOpConstraints(
+      op, {getDRAMLayout(), getDRAMLayout()}, OpConfig());
+  EXPECT_FALSE(static_cast<bool>(constraints));
+  llvm::consumeError(constraints.takeError());
+
+  auto runtime = backend.getOpRuntime(op, {getDRAMLayout(), getDRAMLayout()},
+                                      OpConfig(getDRAMLayout()));
+  EXPECT_FALSE(static_cast<bool>(runtime));
+  llvm::consumeError(runtime.takeError());
+}
+
+TEST_F(OpModelBackendTest, AnalyticalMatmulStaging) {
+  mlir::Operation *op = builder.create<MatmulOp>(
+      builder.getUnknownLoc(), getTensorRankedType(),
+      mlir::ValueRange{func.getArgument(0), func.getArgument(1)});
+  TTNNLayoutAttr shardedLayout =
+      getLayout(BufferType::L1, TensorMemoryLayout::BlockSharded, 2);
+
+  AnalyticalOpModelBackend backend;
+  auto constraints = backend.getOpConstraints(
+      op, {shardedLayout, shardedLayout}, OpConfig(shardedLayout));
+  ASSERT_TRUE(static_cast<bool>(constraints));
+
+  auto [cbUsage, tensorUsage, outputUsage, layout] = *constraints;
+  // All operands are sharded in L1, so only the matmul staging remains: double
+  // buffered 2 tile blocks of both inputs along the inner dimension and the
+  // 2x2 tile partial results of the output shard.
+  EXPECT_EQ(cbUsage, (2 * 2 + 2 * 2 + 2 * 2) * TileSizeBytes);
+  EXPECT_EQ(outputUsage, 4 * TileSizeBytes);
+  EXPECT_EQ(layout, shardedLayout);
+}
+
+TEST_F(OpModelBackendTest, AnalyticalMatmulStagingWithDRAMInputs) {
+  mlir::Operation *op = builder.create<MatmulOp>(
+      builder.getUnknownLoc(), getTensorRankedType(),
+      mlir::ValueRange{func.getArgument(0), func.getArgument(1)});
+  TTNNLayoutAttr shardedLayout =
+      getLayout(BufferType::L1, TensorMemoryLayout::BlockSharded, 2);
+
+  AnalyticalOpModelBackend backend;
+  auto constraints = backend.getOpConstraints(
+      op, {getDRAMLayout(), getDRAMLayout()}, OpConfig(shardedLayout));
+  ASSERT_TRUE(static_cast<bool>(constraints));
+
+  // The streamed DRAM inputs add their double buffered tiles on top of the
+  // matmul staging.
+  auto [cbUsage, tensorUsage, outputUsage, layout] = *constraints;
+  EXPECT_EQ(cbUsage, (2 * 2 + 2 * 2 + 2 * 2 + 2 * 2) * TileSizeBytes);
+}
+
+TEST_F(OpModelBackendTest, AnalyticalSoftmaxStaging) {
+  mlir::Operation *op =
+      builder.create<SoftmaxOp>(builder.getUnknownLoc(), getTensorRankedType(),
+                                func.getArgument(0), -1);
+  TTNNLayoutAttr shardedLayout =
+      getLayout(BufferType::L1, TensorMemoryLayout::BlockSharded, 2);
+
+  AnalyticalOpModelBackend backend;
+  auto constraints =
+      backend.getOpConstraints(op, {shardedLayout}, OpConfig(shardedLayout));
+  ASSERT_TRUE(static_cast<bool>(constraints));
+
+  auto [cbUsage, tensorUsage, outputUsage, layout] = *constraints;
+  // Double buffered rows of the 2 tile wide input shard.
+  EXPECT_EQ(cbUsage, 2 * 2 * TileSizeBytes);
+  EXPECT_EQ(outputUsage, 4 * TileSizeBytes);
+}
+
+TEST_F(OpModelBackendTest, CompareFallsBackWithoutDevice) {
+  std::shared_ptr<OpModelBackend> backend =
+      createOpModelBackend(mlir::tt::OpModelBackendType::Compare);
+  if (DeviceOpModelBackend::isAvailable()) {
+    EXPECT_TRUE(mlir::isa<ComparingOpModelBackend>(backend.get()));
+  } else {
+    EXPECT_TRUE(mlir::isa<AnalyticalOpModelBackend>(backend.get()));
+  }
+}
@@ -301,3 +301,93 @@ TEST_F(ShardSolverBase, VerifyProduceMaxCoreUsage) {
 
   ASSERT_EQ(totalCoreUsage, accMaxCoreUsage[firstOp][0]);
 }
+
+// Validate that ShardSolver explores legal configs beyond the first 64. Only
+// configs at index kFirstValidConfig and above are compatible between ops, so
+// a solution exists only if the whole config space is considered.
+//
+TEST_F(ShardSolverBase, VerifyManyLegalConfigs) {
+  llvm::DenseMap<mlir::Operation *, std::vector<OpConfig>> legalConfigs;
+  std::vector<OpL1MemSpec> opL1MemSpecs;
+  llvm::DenseSet<mlir::Operation *> l1ChainedOps;
+  constexpr unsigned usableL1CacheSize = 1024 * 1024;
+  constexpr int kMaxGridDim = 16;
+  constexpr size_t kFirstValidConfig = 200;
+  llvm::DenseSet<Edge> overrideReshardEdges;
+
+  auto addAllConfigsForOp = [&](mlir::Operation *op) {
+    prepareOpForShardSolver(op, opL1MemSpecs, l1ChainedOps);
+    for (int gridWidth = 1; gridWidth <= kMaxGridDim; ++gridWidth) {
+      for (int gridHeight = 1; gridHeight <= kMaxGridDim; ++gridHeight) {
+        addConfigForOp(op, legalConfigs, BufferType::L1,
+                       TensorMemoryLayout::BlockSharded, gridWidth,
+                       gridHeight);
+      }
+    }
+  };
+
+  mlir::Value lhs = func.getBody().getBlocks().front().getArgument(0);
+  mlir::Value rhs = func.getBody().getBlocks().front().getArgument(1);
+  mlir::Operation *op =
+      builder.create<AddOp>(builder.getUnknownLoc(), lhs.getType(), lhs, rhs);
+  addAllConfigsForOp(op);
+
+  rhs = op->getResult(0);
+  op = builder.create<ReluOp>(builder.getUnknownLoc(), rhs.getType(), rhs);
+  addAllConfigsForOp(op);
+
+  rhs = op->getResult(0);
+  op = builder.create<ReluOp>(builder.getUnknownLoc(), rhs.getType(), rhs);
+  addAllConfigsForOp(op);
+
+  ASSERT_GT(legalConfigs[op].size(), kFirstValidConfig);
+
+  std::function<llvm::Expected<TTNNLayoutAttr>(
+      mlir::Value, const TTNNLayoutAttr &, mlir::Operation *, const OpConfig &)>
+      checkShardCompatible =
+          [&legalConfigs](
+              mlir::Value producerOperand, const TTNNLayoutAttr &producerLayout,
+              mlir::Operation *consumerOp, const OpConfig &consumerConfig)
+      -> llvm::Expected<TTNNLayoutAttr> {
+    // Interleaved to sharded is always supported.
+    //
+    if (producerLayout.hasInterleavedDRAMTensorMemoryLayout()) {
+      return consumerConfig.outputLayout;
+    }
+
+    auto &producerConfigs = legalConfigs[producerOperand.getDefiningOp()];
+    size_t producerLayoutIndex =
+        std::find(producerConfigs.begin(), producerConfigs.end(),
+                  OpConfig(producerLayout)) -
+        producerConfigs.begin();
+    if (producerLayoutIndex < kFirstValidConfig) {
+      return llvm::createStringError("Producer layout not supported");
+    }
+
+    return legalConfigs[consumerOp][producerLayoutIndex].outputLayout;
+  };
+
+  ShardSolver shardSolver(/*tensorTypePossibleLayouts=*/nullptr, legalConfigs,
+                          opL1MemSpecs, l1ChainedOps, usableL1CacheSize,
+                          overrideReshardEdges, checkShardCompatible);
+
+  ASSERT_TRUE(shardSolver.resolve());
+
+  for (auto &opL1MemSpec : opL1MemSpecs) {
+    ShardSolver::RemainingConfigAttrs validLayouts =
+        shardSolver.at(opL1MemSpec.op);
+    ASSERT_EQ(validLayouts.size(),
+              legalConfigs[opL1MemSpec.op].size() - kFirstValidConfig);
+    for (auto it = validLayouts.begin(); it != validLayouts.end(); ++it) {
+      ASSERT_GE(it.index(), kFirstValidConfig);
+    }
+    shardSolver.set(opL1MemSpec.op, *validLayouts.begin());
+  }
+
+  llvm::DenseMap<mlir::Operation *, OpConfig> selectedOpConfig =
+      shardSolver.finish().selectedOpConfig;
+  for (auto &opL1MemSpec : opL1MemSpecs) {
+    ASSERT_EQ(selectedOpConfig[opL1MemSpec.op],
+              legalConfigs[opL1MemSpec.op][kFirstValidConfig]);
+  }
+}
@@ -231,3 +231,105 @@ TEST_F(SchedulerBase, VerifyFork) {
   scheduler.scheduleOp(scheduleableOps[0]);
   ASSERT_FALSE(scheduler.hasUnscheduledOps());
 }
+
+// Test that ready ops are returned by priority. The first op starts a long
+// chain while the second op is a single op, so the critical path priority
+// should prefer the first op and a custom priority can reverse that.
+TEST_F(SchedulerBase, VerifyPriority) {
+  mlir::Value lhs = func.getBody().getBlocks().front().getArgument(0);
+  mlir::Value rhs = func.getBody().getBlocks().front().getArgument(1);
+  ttir::TTIROp chainOp = builder.create<ttir::AddOp>(
+      builder.getUnknownLoc(), lhs, rhs, createEmptyTensor());
+  ttir::TTIROp singleOp = builder.create<ttir::AddOp>(
+      builder.getUnknownLoc(), lhs, rhs, createEmptyTensor());
+
+  mlir::Value chainValue = chainOp.getOperation()->getResult(0);
+  for (std::size_t i = 0; i < NumberOfOps; i++) {
+    chainValue = builder
+                     .create<ttir::AddOp>(builder.getUnknownLoc(), chainValue,
+                                          rhs, createEmptyTensor())
+                     .getOperation()
+                     ->getResult(0);
+  }
+
+  mlir::tt::scheduler::Scheduler criticalPathScheduler(
+      &func, mlir::tt::scheduler::SchedulePriority::CriticalPath);
+  llvm::SmallVector<mlir::Operation *> scheduleableOps =
+      criticalPathScheduler.getScheduleableOps();
+  ASSERT_EQ(scheduleableOps.size(), 2);
+  EXPECT_EQ(scheduleableOps[0], chainOp.getOperation());
+  EXPECT_EQ(scheduleableOps[1], singleOp.getOperation());
+
+  mlir::tt::scheduler::Scheduler customScheduler(
+      &func, [&](mlir::Operation *op) -> int64_t {
+        return op == singleOp.getOperation() ? 1 : 0;
+      });
+  scheduleableOps = customScheduler.getScheduleableOps();
+  ASSERT_EQ(scheduleableOps.size(), 2);
+  EXPECT_EQ(scheduleableOps[0], singleOp.getOperation());
+  EXPECT_EQ(scheduleableOps[1], chainOp.getOperation());
+}
+
+// Test that snapshots are not affected by scheduling in the original
+// scheduler and vice versa.
+TEST_F(SchedulerBase, VerifySnapshot) {
+  mlir::Value lhs = func.getBody().getBlocks().front().getArgument(0);
+  mlir::Value rhs = func.getBody().getBlocks().front().getArgument(1);
+  ttir::TTIROp firstOp = builder.create<ttir::AddOp>(
+      builder.getUnknownLoc(), lhs, rhs, createEmptyTensor());
+  ttir::TTIROp secondOp = builder.create<ttir::AddOp>(
+      builder.getUnknownLoc(), firstOp.getOperation()->getResult(0), rhs,
+      createEmptyTensor());
+
+  mlir::tt::scheduler::Scheduler scheduler(&func);
+  std::unique_ptr<mlir::tt::scheduler::Scheduler> snapshot =
+      scheduler.snapshot();
+
+  scheduler.scheduleOp(firstOp.getOperation());
+  EXPECT_TRUE(scheduler.isScheduled(firstOp.getOperation()));
+  EXPECT_TRUE(scheduler.canSchedule(secondOp.getOperation()));
+  EXPECT_FALSE(snapshot->isScheduled(firstOp.getOperation()));
+  EXPECT_FALSE(snapshot->canSchedule(secondOp.getOperation()));
+  ASSERT_EQ(snapshot->getScheduleableOps().size(), 1);
+  EXPECT_EQ(snapshot->getScheduleableOps()[0], firstOp.getOperation());
+
+  snapshot->scheduleOp(firstOp.getOperation());
+  snapshot->scheduleOp(secondOp.getOperation());
+  EXPECT_FALSE(snapshot->hasUnscheduledOps());
+  EXPECT_TRUE(scheduler.hasUnscheduledOps());
+  EXPECT_EQ(scheduler.getSchedule().size(), 1);
+}
+
+// Test a large graph where every op depends on the previous two ops. Every
+// op has to be scheduled after its operands.
+TEST_F(SchedulerBase, LargeGraph) {
+  constexpr std::size_t NumberOfLargeGraphOps = 10000;
+  mlir::Value lhs = func.getBody().getBlocks().front().getArgument(0);
+  mlir::Value rhs = func.getBody().getBlocks().front().getArgument(1);
+  for (std::size_t i = 0; i < NumberOfLargeGraphOps; i++) {
+    mlir::Value result = builder
+                             .create<ttir::AddOp>(builder.getUnknownLoc(), lhs,
+                                                  rhs, createEmptyTensor())
+                             .getOperation()
+                             ->getResult(0);
+    lhs = rhs;
+    rhs = result;
+  }
+
+  mlir::tt::scheduler::Scheduler scheduler(
+      &func, mlir::tt::scheduler::SchedulePriority::CriticalPath);
+  while (scheduler.hasUnscheduledOps()) {
+    llvm::SmallVector<mlir::Operation *> scheduleableOps =
+        scheduler.getScheduleableOps();
+    ASSERT_FALSE(scheduleableOps.empty());
+    for (mlir::Value operand : scheduleableOps[0]->getOperands()) {
+      mlir::Operation *operandOp = operand.getDefiningOp();
+      if (operandOp && scheduler.isTTSchedulableOp(operandOp)) {
+        ASSERT_TRUE(scheduler.isScheduled(operandOp));
+      }
+    }
+    scheduler.scheduleOp(scheduleableOps[0]);
+  }
+
+  EXPECT_EQ(scheduler.getSchedule().size(), NumberOfLargeGraphOps);
+}
@@ -282,6 +282,7 @@ class ModelRunner:
                     passes.lookup_dtype(data["dtype"]),
                     data_arr.buffer_info()[0],
                     data_arr.buffer_info()[1],
+                    data_arr,
                 )
 
             # Get module from file